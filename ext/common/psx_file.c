@@ -30,6 +30,8 @@
 #if defined(WIN32)
     #include <windows.h>
 #else
+    #include <fcntl.h>
+    #include <sys/mman.h>
     #include <unistd.h>
     #include <dlfcn.h>
     #include <fnmatch.h>
@@ -149,6 +151,117 @@ bool psx_file_read(const pchar* path, uint8_t* buffer, size_t buffer_size)
     return retval;
 }
 
+bool psx_file_read_chunks(const pchar* path, uint8_t* buffer, size_t buffer_size, psx_file_chunk_fn func, void* param)
+{
+    size_t read_bytes = 0;
+    bool retval = true;
+
+    FILE* fp = FOPEN(path, "rb");
+    if (!fp) {
+        return false;
+    }
+
+    while ((read_bytes = fread(buffer, 1, buffer_size, fp)) > 0) {
+        if (!func(param, buffer, read_bytes)) {
+            retval = false;
+            break;
+        }
+    }
+
+    if (retval && ferror(fp)) {
+        retval = false;
+    }
+
+    fclose(fp);
+    return retval;
+}
+
+#if defined(WIN32)
+
+#if defined(_MSC_VER)
+#define CREATE_FILE CreateFileW
+#else
+#define CREATE_FILE CreateFileA
+#endif
+
+const uint8_t* psx_file_map(const pchar* path, size_t* size)
+{
+    LARGE_INTEGER file_size;
+    const uint8_t* data = NULL;
+
+    HANDLE file = CREATE_FILE(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0
+        && (unsigned long long)file_size.QuadPart <= (size_t)-1) {
+        HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping); // view keeps the mapping alive.
+        }
+    }
+    CloseHandle(file);
+
+    if (data && size) {
+        *size = (size_t)file_size.QuadPart;
+    }
+    return data;
+}
+
+void psx_file_unmap(const uint8_t* data, size_t size)
+{
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+}
+
+#else
+
+const uint8_t* psx_file_map(const pchar* path, size_t* size)
+{
+    struct stat info;
+    void* data = NULL;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0
+        && (unsigned long long)info.st_size <= (size_t)-1) {
+        data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            data = NULL;
+        }
+    }
+    close(fd); // mapping keeps the file alive.
+
+    if (!data) {
+        return NULL;
+    }
+
+#if defined(MADV_SEQUENTIAL)
+    madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+#endif
+
+    if (size) {
+        *size = (size_t)info.st_size;
+    }
+    return (const uint8_t*)data;
+}
+
+void psx_file_unmap(const uint8_t* data, size_t size)
+{
+    if (data) {
+        munmap((void*)data, size);
+    }
+}
+
+#endif
+
 bool psx_file_write(const pchar* path, const uint8_t* buffer, size_t buffer_size)
 {
     size_t write_bytes = 0;
@@ -50,6 +50,16 @@ size_t psx_file_size(const pchar* path);
 
 bool psx_file_read(const pchar* path, uint8_t* buffer, size_t buffer_size);
 
+typedef bool (*psx_file_chunk_fn)(void* param, const uint8_t* data, size_t length);
+
+// read the file through buffer piece by piece, stop when the callback returns false.
+bool psx_file_read_chunks(const pchar* path, uint8_t* buffer, size_t buffer_size, psx_file_chunk_fn func, void* param);
+
+// map the whole file read only, return NULL if the file can not be mapped.
+const uint8_t* psx_file_map(const pchar* path, size_t* size);
+
+void psx_file_unmap(const uint8_t* data, size_t size);
+
 bool psx_file_write(const pchar* path, const uint8_t* buffer, size_t buffer_size);
 
 bool psx_file_remove(const pchar* path);
@@ -193,7 +193,9 @@ psx_image* PICAPI psx_image_create_from_data(ps_byte* data, ps_color_format fmt,
 psx_image* PICAPI psx_image_load(const char* name, psx_result* err_code)
 {
     size_t size;
+    size_t map_size = 0;
     ps_byte* file_data;
+    const ps_byte* map_data;
     psx_image* image;
     pchar* file_name;
 
@@ -229,6 +231,15 @@ psx_image* PICAPI psx_image_load(const char* name, psx_result* err_code)
         return NULL;
     }
 
+    // decode the mapped file in place.
+    map_data = psx_file_map(file_name, &map_size);
+    if (map_data) {
+        image = psx_image_load_from_memory(map_data, map_size, err_code);
+        psx_file_unmap(map_data, map_size);
+        psx_path_destroy(file_name);
+        return image;
+    }
+
     file_data = (ps_byte*)mem_malloc(size);
     if (!file_data) {
         if (err_code) {
@@ -36,9 +36,15 @@
 extern "C" {
 #endif
 
+#define SVG_READ_CHUNK_SIZE (64 * 1024)
+
+static bool _svg_push_chunk(void* param, const uint8_t* data, size_t length)
+{
+    return psx_svg_loader_push((psx_svg_loader*)param, data, length) == S_OK;
+}
+
 psx_svg* PICAPI psx_svg_load(const char* name, psx_result* err_code)
 {
-    size_t size;
     ps_byte* file_data;
     pchar* file_name;
 
@@ -57,7 +63,7 @@ psx_svg* PICAPI psx_svg_load(const char* name, psx_result* err_code)
         return NULL;
     }
 
-    if (!psx_file_exists(file_name)) {
+    if (!psx_file_exists(file_name) || !psx_file_size(file_name)) {
         if (err_code) {
             *err_code = S_BAD_PARAMS;
         }
@@ -65,40 +71,150 @@ psx_svg* PICAPI psx_svg_load(const char* name, psx_result* err_code)
         return NULL;
     }
 
-    size = psx_file_size(file_name);
-    if (!size) {
-        if (err_code) {
-            *err_code = S_BAD_PARAMS;
-        }
+    // parse the mapped file in place.
+    size_t size = 0;
+    const uint8_t* map_data = psx_file_map(file_name, &size);
+    if (map_data) {
+        psx_svg* svg = psx_svg_load_from_memory(map_data, size, err_code);
+        psx_file_unmap(map_data, size);
+        psx_path_destroy(file_name);
+        return svg;
+    }
+
+    psx_svg_loader* loader = psx_svg_loader_create(err_code);
+    if (!loader) {
         psx_path_destroy(file_name);
         return NULL;
     }
 
-    file_data = (ps_byte*)mem_malloc(size);
+    // parse the file while reading it, only one chunk is held in memory.
+    file_data = (ps_byte*)mem_malloc(SVG_READ_CHUNK_SIZE);
     if (!file_data) {
         if (err_code) {
             *err_code = S_OUT_OF_MEMORY;
         }
+        psx_svg_loader_destroy(loader);
         psx_path_destroy(file_name);
         return NULL;
     }
-    // read file data.
-    if (!psx_file_read(file_name, file_data, size)) {
-        free(file_data);
+
+    psx_svg* svg = NULL;
+    if (psx_file_read_chunks(file_name, file_data, SVG_READ_CHUNK_SIZE, _svg_push_chunk, loader)) {
+        svg = psx_svg_loader_finish(loader, err_code);
+    } else if (err_code) {
+        *err_code = S_FAILURE;
+    }
+
+    mem_free(file_data);
+    psx_svg_loader_destroy(loader);
+    psx_path_destroy(file_name);
+    return svg;
+}
+
+psx_svg* PICAPI psx_svg_load_from_stream(svg_reader_fn func, void* param, psx_result* err_code)
+{
+    if (!func) {
+        if (err_code) {
+            *err_code = S_BAD_PARAMS;
+        }
+        return NULL;
+    }
+
+    psx_svg_loader* loader = psx_svg_loader_create(err_code);
+    if (!loader) {
+        return NULL;
+    }
+
+    ps_byte* buffer = (ps_byte*)mem_malloc(SVG_READ_CHUNK_SIZE);
+    if (!buffer) {
+        if (err_code) {
+            *err_code = S_OUT_OF_MEMORY;
+        }
+        psx_svg_loader_destroy(loader);
+        return NULL;
+    }
+
+    size_t length = 0;
+    psx_result ret = S_OK;
+    while ((length = func(param, buffer, SVG_READ_CHUNK_SIZE)) > 0) {
+        if ((ret = psx_svg_loader_push(loader, buffer, length)) != S_OK) {
+            break;
+        }
+    }
+
+    psx_svg* svg = NULL;
+    if (ret == S_OK) {
+        svg = psx_svg_loader_finish(loader, err_code);
+    } else if (err_code) {
+        *err_code = ret;
+    }
+
+    mem_free(buffer);
+    psx_svg_loader_destroy(loader);
+    return svg;
+}
+
+psx_svg_loader* PICAPI psx_svg_loader_create(psx_result* err_code)
+{
+    psx_svg_stream* stream = psx_svg_stream_create();
+    if (!stream) {
+        if (err_code) {
+            *err_code = S_OUT_OF_MEMORY;
+        }
+        return NULL;
+    }
+
+    if (err_code) {
+        *err_code = S_OK;
+    }
+    return (psx_svg_loader*)stream;
+}
+
+psx_result PICAPI psx_svg_loader_push(psx_svg_loader* loader, const ps_byte* data, size_t length)
+{
+    if (!loader || !data) {
+        return S_BAD_PARAMS;
+    }
+
+    while (length > 0) {
+        uint32_t len = length > SVG_READ_CHUNK_SIZE ? SVG_READ_CHUNK_SIZE : (uint32_t)length;
+        if (!psx_svg_stream_push((psx_svg_stream*)loader, (const char*)data, len)) {
+            return S_FAILURE;
+        }
+        data += len;
+        length -= len;
+    }
+    return S_OK;
+}
+
+psx_svg* PICAPI psx_svg_loader_finish(psx_svg_loader* loader, psx_result* err_code)
+{
+    if (!loader) {
+        if (err_code) {
+            *err_code = S_BAD_PARAMS;
+        }
+        return NULL;
+    }
+
+    psx_svg_node* svg = psx_svg_stream_finish((psx_svg_stream*)loader);
+    if (!svg) {
         if (err_code) {
             *err_code = S_FAILURE;
         }
-        psx_path_destroy(file_name);
         return NULL;
     }
 
-    psx_svg* svg = psx_svg_load_from_memory(file_data, size, err_code);
-    psx_path_destroy(file_name);
-    free(file_data);
     if (err_code) {
         *err_code = S_OK;
     }
-    return svg;
+    return (psx_svg*)svg;
+}
+
+void PICAPI psx_svg_loader_destroy(psx_svg_loader* loader)
+{
+    if (loader) {
+        psx_svg_stream_destroy((psx_svg_stream*)loader);
+    }
 }
 
 psx_svg* PICAPI psx_svg_load_from_memory(const ps_byte* data, size_t length, psx_result* err_code)
@@ -132,6 +248,59 @@ void PICAPI psx_svg_destroy(psx_svg* doc)
     }
 }
 
+typedef struct {
+    svg_writer_fn func;
+    void* param;
+} _svg_compile_writer;
+
+static bool _svg_write_compiled(void* param, const uint8_t* data, uint32_t length)
+{
+    _svg_compile_writer* writer = (_svg_compile_writer*)param;
+    return writer->func(writer->param, data, length) == S_OK;
+}
+
+psx_result PICAPI psx_svg_compile(const psx_svg* doc, svg_writer_fn func, void* param)
+{
+    if (!doc || !func) {
+        return S_BAD_PARAMS;
+    }
+
+    _svg_compile_writer writer = {func, param};
+    if (!psx_svg_save_binary((const psx_svg_node*)doc, _svg_write_compiled, &writer)) {
+        return S_FAILURE;
+    }
+    return S_OK;
+}
+
+static int32_t _svg_file_writer(void* param, const ps_byte* data, size_t length)
+{
+    const pchar* path = (const pchar*)param;
+    if (psx_file_write(path, (const uint8_t*)data, length)) {
+        return S_OK;
+    } else {
+        return S_FAILURE;
+    }
+}
+
+psx_result PICAPI psx_svg_compile_to_file(const psx_svg* doc, const char* name)
+{
+    if (!doc || !name) {
+        return S_BAD_PARAMS;
+    }
+
+    pchar* file_name = psx_path_create(name, NULL);
+    if (!file_name) {
+        return S_FAILURE;
+    }
+
+    if (psx_file_exists(file_name)) {
+        psx_file_remove(file_name); // remove old file.
+    }
+    psx_result ret = psx_svg_compile(doc, _svg_file_writer, (void*)file_name);
+    psx_path_destroy(file_name);
+    return ret;
+}
+
 psx_svg_render* PICAPI psx_svg_render_create(const psx_svg* doc, psx_result* err_code)
 {
     if (!doc) {
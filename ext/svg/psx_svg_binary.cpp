@@ -0,0 +1,843 @@
+/*
+ * Copyright (c) 2025, Zhang Ji Peng
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "psx_svg_node.h"
+#include "psx_svg_parser.h"
+
+/*
+ * Compiled svg document, the parsed node tree with every attribute already
+ * resolved, so loading it needs no tokenizing and no number parsing.
+ *
+ * | header | nodes[node_count] | attrs[attr_count] | data[data_size] |
+ *
+ * Nodes are stored in pre-order, each one followed by its children, and the
+ * attributes of all nodes are stored in the same order. Values that do not
+ * fit in an attribute record live in the data section and are referenced by
+ * offset, so the blob can be mapped at any address. Numbers are stored in
+ * the byte order of the machine which compiled the document, a blob with
+ * a different byte order or version is rejected.
+ */
+
+#define SVG_BINARY_VERSION 1
+#define SVG_BINARY_BYTE_ORDER 0x01020304
+#define SVG_BINARY_NONE 0xFFFFFFFF
+#define SVG_BINARY_ALIGN(n) (((n) + 3) & ~3)
+
+static const uint8_t _svg_binary_magic[PSX_SVG_BINARY_MAGIC_LEN] = {
+    0x89, 'P', 'S', 'V', 'G', '\r', '\n', 0x1A,
+};
+
+typedef struct {
+    uint8_t magic[PSX_SVG_BINARY_MAGIC_LEN];
+    uint32_t byte_order;
+    uint32_t version;
+    uint32_t file_size;
+    uint32_t node_count;
+    uint32_t attr_count;
+    uint32_t data_size;
+} _svg_binary_header;
+
+typedef struct {
+    int32_t tag;
+    uint32_t child_count;
+    uint32_t attr_count;
+    uint32_t content; // offset of id or content text, SVG_BINARY_NONE if not exists.
+    uint32_t content_len;
+} _svg_binary_node;
+
+typedef struct {
+    int8_t attr_id;
+    int8_t val_type;
+    int8_t class_type;
+    uint8_t reserved;
+    uint32_t value; // value bits for data values, offset in data section for others.
+    uint32_t size; // bytes of the value in data section.
+} _svg_binary_attr;
+
+// | offsets_len | syncbase_type | access_key | strings offset ... | offsets_ms[offsets_len] |
+typedef struct {
+    uint32_t offsets_len;
+    uint32_t syncbase_type;
+    int32_t access_key;
+    uint32_t event_token;
+    uint32_t event_target_id;
+    uint32_t syncbase_id;
+} _svg_binary_timing;
+
+// | count | vertices[count] |
+typedef struct {
+    uint32_t cmd;
+    float x;
+    float y;
+} _svg_binary_vertex;
+
+// layout of values pointed by SVG_ATTR_VALUE_PTR attributes.
+enum {
+    SVG_BINARY_VALUE_STRING = 0, // zero terminated string.
+    SVG_BINARY_VALUE_FIXED, // fixed size data.
+    SVG_BINARY_VALUE_LIST, // psx_svg_attr_values_list.
+};
+
+typedef struct {
+    uint32_t kind;
+    uint32_t size; // fixed data size or list element size.
+    uint32_t min_count; // list elements readers may access regardless of length.
+} _svg_binary_layout;
+
+static INLINE bool _svg_attr_value_layout(psx_svg_tag tag, int32_t attr_id, _svg_binary_layout* layout)
+{
+    layout->kind = SVG_BINARY_VALUE_LIST;
+    layout->size = sizeof(float);
+    layout->min_count = 0;
+
+    switch (attr_id) {
+        case SVG_ATTR_VERSION:
+        case SVG_ATTR_BASE_PROFILE:
+        case SVG_ATTR_XLINK_HREF:
+        case SVG_ATTR_FILL:
+        case SVG_ATTR_STROKE:
+        case SVG_ATTR_VIEWPORT_FILL:
+        case SVG_ATTR_SOLID_COLOR:
+        case SVG_ATTR_GRADIENT_STOP_COLOR:
+        case SVG_ATTR_FONT_FAMILY:
+        case SVG_ATTR_FONT_STYLE:
+        case SVG_ATTR_FONT_VARIANT:
+        case SVG_ATTR_FONT_WEIGHT:
+        case SVG_ATTR_FONT_SIZE:
+            layout->kind = SVG_BINARY_VALUE_STRING;
+            return true;
+        case SVG_ATTR_PATH:
+            layout->kind = SVG_BINARY_VALUE_STRING;
+            return tag == SVG_TAG_ANIMATE_MOTION;
+        case SVG_ATTR_VIEWBOX:
+            layout->kind = SVG_BINARY_VALUE_FIXED;
+            layout->size = sizeof(float) * 4;
+            return true;
+        case SVG_ATTR_TRANSFORM:
+            layout->kind = SVG_BINARY_VALUE_FIXED;
+            layout->size = sizeof(psx_svg_matrix);
+            return true;
+        case SVG_ATTR_POINTS:
+        case SVG_ATTR_KEY_SPLINES:
+            layout->size = sizeof(psx_svg_point);
+            return true;
+        case SVG_ATTR_STROKE_DASH_ARRAY:
+        case SVG_ATTR_KEY_TIMES:
+        case SVG_ATTR_KEY_POINTS:
+            return true;
+        case SVG_ATTR_FROM:
+        case SVG_ATTR_TO:
+        case SVG_ATTR_BY:
+            if (tag == SVG_TAG_ANIMATE_MOTION) {
+                layout->size = sizeof(psx_svg_point);
+            } else if (tag == SVG_TAG_ANIMATE_TRANSFORM) {
+                layout->min_count = 6;
+            }
+            return tag == SVG_TAG_ANIMATE || tag == SVG_TAG_SET
+                   || tag == SVG_TAG_ANIMATE_TRANSFORM || tag == SVG_TAG_ANIMATE_MOTION;
+        case SVG_ATTR_VALUES:
+            if (tag == SVG_TAG_ANIMATE_COLOR) {
+                layout->size = sizeof(uint32_t);
+            } else if (tag == SVG_TAG_ANIMATE_TRANSFORM) {
+                layout->size = sizeof(struct _transform_values_list);
+            } else if (tag == SVG_TAG_ANIMATE_MOTION) {
+                layout->size = sizeof(psx_svg_point);
+            }
+            return tag == SVG_TAG_ANIMATE || tag == SVG_TAG_SET || tag == SVG_TAG_ANIMATE_COLOR
+                   || tag == SVG_TAG_ANIMATE_TRANSFORM || tag == SVG_TAG_ANIMATE_MOTION;
+        default:
+            return false;
+    }
+}
+
+// attributes the parser always stores by pointer, and those stored by pointer unless they are none or inherit.
+static INLINE bool _svg_attr_data_allowed(int32_t attr_id, int32_t class_type)
+{
+    switch (attr_id) {
+        case SVG_ATTR_VERSION:
+        case SVG_ATTR_BASE_PROFILE:
+        case SVG_ATTR_XLINK_HREF:
+        case SVG_ATTR_POINTS:
+        case SVG_ATTR_D:
+        case SVG_ATTR_PATH:
+        case SVG_ATTR_VALUES:
+        case SVG_ATTR_KEY_TIMES:
+        case SVG_ATTR_KEY_POINTS:
+        case SVG_ATTR_KEY_SPLINES:
+        case SVG_ATTR_BEGIN:
+        case SVG_ATTR_END:
+            return false;
+        case SVG_ATTR_VIEWBOX:
+        case SVG_ATTR_TRANSFORM:
+        case SVG_ATTR_STROKE_DASH_ARRAY:
+        case SVG_ATTR_FONT_FAMILY:
+        case SVG_ATTR_FONT_STYLE:
+        case SVG_ATTR_FONT_VARIANT:
+        case SVG_ATTR_FONT_WEIGHT:
+            return class_type != SVG_ATTR_VALUE_INITIAL;
+        default:
+            return true;
+    }
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// save
+typedef struct {
+    uint8_t* data;
+    uint32_t size;
+    uint32_t capacity;
+    bool error;
+} _svg_binary_buffer;
+
+static INLINE void _buffer_init(_svg_binary_buffer* buf)
+{
+    buf->data = NULL;
+    buf->size = 0;
+    buf->capacity = 0;
+    buf->error = false;
+}
+
+static INLINE void _buffer_destroy(_svg_binary_buffer* buf)
+{
+    if (buf->data) {
+        mem_free(buf->data);
+    }
+}
+
+// append data at a 4 bytes aligned offset, return the offset.
+static INLINE uint32_t _buffer_append(_svg_binary_buffer* buf, const void* data, uint32_t len)
+{
+    uint32_t offset = SVG_BINARY_ALIGN(buf->size);
+    if (buf->error || offset < buf->size || offset + len < offset) {
+        buf->error = true;
+        return 0;
+    }
+
+    if (offset + len > buf->capacity) {
+        uint32_t capacity = buf->capacity ? buf->capacity : 256;
+        while (capacity < offset + len) {
+            if (capacity > 0x7FFFFFFF) {
+                buf->error = true;
+                return 0;
+            }
+            capacity <<= 1;
+        }
+        uint8_t* mem = (uint8_t*)mem_realloc(buf->data, capacity);
+        if (!mem) {
+            buf->error = true;
+            return 0;
+        }
+        buf->data = mem;
+        buf->capacity = capacity;
+    }
+
+    memset(buf->data + buf->size, 0, offset - buf->size);
+    if (len) {
+        mem_copy(buf->data + offset, data, len);
+    }
+    buf->size = offset + len;
+    return offset;
+}
+
+static INLINE uint32_t _buffer_append_string(_svg_binary_buffer* buf, const char* str)
+{
+    if (!str) {
+        return SVG_BINARY_NONE;
+    }
+    return _buffer_append(buf, str, (uint32_t)strlen(str) + 1);
+}
+
+typedef struct {
+    _svg_binary_buffer nodes;
+    _svg_binary_buffer attrs;
+    _svg_binary_buffer data;
+    uint32_t node_count;
+    uint32_t attr_count;
+} _svg_binary_writer;
+
+static bool _save_path_value(_svg_binary_writer* writer, const ps_path* path, _svg_binary_attr* rec)
+{
+    uint32_t count = ps_path_get_vertex_count(path);
+    rec->value = _buffer_append(&writer->data, &count, sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; i++) {
+        ps_point pt;
+        _svg_binary_vertex vertex;
+        vertex.cmd = (uint32_t)ps_path_get_vertex(path, i, &pt);
+        vertex.x = pt.x;
+        vertex.y = pt.y;
+        _buffer_append(&writer->data, &vertex, sizeof(_svg_binary_vertex));
+    }
+    rec->size = writer->data.size - rec->value;
+    return !writer->data.error;
+}
+
+static bool _save_timing_value(_svg_binary_writer* writer, const psx_svg_timing_list* tl, _svg_binary_attr* rec)
+{
+    _svg_binary_timing timing;
+    timing.offsets_len = tl->offsets_len;
+    timing.syncbase_type = tl->syncbase_type;
+    timing.access_key = tl->access_key;
+    timing.event_token = _buffer_append_string(&writer->data, tl->event_token);
+    timing.event_target_id = _buffer_append_string(&writer->data, tl->event_target_id);
+    timing.syncbase_id = _buffer_append_string(&writer->data, tl->syncbase_id);
+
+    rec->value = _buffer_append(&writer->data, &timing, sizeof(_svg_binary_timing));
+    if (tl->offsets_len) {
+        _buffer_append(&writer->data, tl->offsets_ms, sizeof(float) * tl->offsets_len);
+    }
+    rec->size = writer->data.size - rec->value;
+    return !writer->data.error;
+}
+
+static bool _save_attr(_svg_binary_writer* writer, const psx_svg_node* node, const psx_svg_attr* attr)
+{
+    _svg_binary_attr rec;
+    memset(&rec, 0, sizeof(_svg_binary_attr));
+    rec.attr_id = (int8_t)attr->attr_id;
+    rec.val_type = (int8_t)attr->val_type;
+    rec.class_type = (int8_t)attr->class_type;
+
+    if (attr->val_type == SVG_ATTR_VALUE_DATA) {
+        rec.value = attr->value.uval;
+    } else if (!attr->value.val) {
+        LOG_ERROR("Svg attribute has no value to compile!\n");
+        return false;
+    } else if (attr->val_type == SVG_ATTR_VALUE_PATH_PTR) {
+        if (!_save_path_value(writer, (const ps_path*)attr->value.val, &rec)) {
+            return false;
+        }
+    } else if (attr->val_type == SVG_ATTR_VALUE_TIMING_LIST_PTR) {
+        if (!_save_timing_value(writer, (const psx_svg_timing_list*)attr->value.val, &rec)) {
+            return false;
+        }
+    } else {
+        _svg_binary_layout layout;
+        if (!_svg_attr_value_layout(node->type(), attr->attr_id, &layout)) {
+            LOG_ERROR("Svg attribute value can not be compiled!\n");
+            return false;
+        }
+
+        if (layout.kind == SVG_BINARY_VALUE_STRING) {
+            rec.size = (uint32_t)strlen(attr->value.sval) + 1;
+        } else if (layout.kind == SVG_BINARY_VALUE_FIXED) {
+            rec.size = layout.size;
+        } else {
+            const psx_svg_attr_values_list* list = (const psx_svg_attr_values_list*)attr->value.val;
+            rec.size = sizeof(uint32_t) + list->length * layout.size;
+        }
+        rec.value = _buffer_append(&writer->data, attr->value.val, rec.size);
+    }
+
+    _buffer_append(&writer->attrs, &rec, sizeof(_svg_binary_attr));
+    writer->attr_count++;
+    return !writer->data.error && !writer->attrs.error;
+}
+
+static bool _save_node(_svg_binary_writer* writer, const psx_svg_node* node)
+{
+    uint32_t len = 0;
+    const char* content = node->content(&len);
+
+    _svg_binary_node rec;
+    rec.tag = node->type();
+    rec.child_count = node->child_count();
+    rec.attr_count = node->attr_count();
+    rec.content = content ? _buffer_append(&writer->data, content, len + 1) : SVG_BINARY_NONE;
+    rec.content_len = content ? len : 0;
+
+    _buffer_append(&writer->nodes, &rec, sizeof(_svg_binary_node));
+    writer->node_count++;
+
+    for (uint32_t i = 0; i < rec.attr_count; i++) {
+        if (!_save_attr(writer, node, node->attr_at(i))) {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < rec.child_count; i++) {
+        if (!_save_node(writer, node->get_child(i))) {
+            return false;
+        }
+    }
+    return !writer->nodes.error;
+}
+
+bool psx_svg_save_binary(const psx_svg_node* doc, psx_svg_binary_writer_fn func, void* param)
+{
+    if (!doc || !func) {
+        LOG_ERROR("Bad arguments for svg document or writer!\n");
+        return false;
+    }
+
+    _svg_binary_writer writer;
+    _buffer_init(&writer.nodes);
+    _buffer_init(&writer.attrs);
+    _buffer_init(&writer.data);
+    writer.node_count = 0;
+    writer.attr_count = 0;
+
+    bool ret = _save_node(&writer, doc);
+    if (ret) {
+        uint64_t file_size = (uint64_t)sizeof(_svg_binary_header) + writer.nodes.size
+                             + writer.attrs.size + writer.data.size;
+        if (file_size > 0xFFFFFFFF) {
+            LOG_ERROR("Svg document is too large to compile!\n");
+            ret = false;
+        } else {
+            _svg_binary_header header;
+            mem_copy(header.magic, _svg_binary_magic, PSX_SVG_BINARY_MAGIC_LEN);
+            header.byte_order = SVG_BINARY_BYTE_ORDER;
+            header.version = SVG_BINARY_VERSION;
+            header.file_size = (uint32_t)file_size;
+            header.node_count = writer.node_count;
+            header.attr_count = writer.attr_count;
+            header.data_size = writer.data.size;
+
+            ret = func(param, (const uint8_t*)&header, sizeof(_svg_binary_header))
+                  && func(param, writer.nodes.data, writer.nodes.size)
+                  && (!writer.attrs.size || func(param, writer.attrs.data, writer.attrs.size))
+                  && (!writer.data.size || func(param, writer.data.data, writer.data.size));
+        }
+    }
+
+    _buffer_destroy(&writer.nodes);
+    _buffer_destroy(&writer.attrs);
+    _buffer_destroy(&writer.data);
+    return ret;
+}
+
+// load
+typedef struct {
+    const uint8_t* nodes;
+    const uint8_t* attrs;
+    const uint8_t* data;
+    uint32_t node_count;
+    uint32_t attr_count;
+    uint32_t data_size;
+    uint32_t attr_index;
+} _svg_binary_reader;
+
+static INLINE const uint8_t* _reader_data(const _svg_binary_reader* reader, uint32_t offset, uint32_t size)
+{
+    if (offset > reader->data_size || size > reader->data_size - offset) {
+        return NULL;
+    }
+    return reader->data + offset;
+}
+
+static INLINE char* _reader_string(const _svg_binary_reader* reader, uint32_t offset)
+{
+    if (offset >= reader->data_size) {
+        return NULL;
+    }
+
+    const char* str = (const char*)reader->data + offset;
+    const char* end = (const char*)memchr(str, '\0', reader->data_size - offset);
+    if (!end) {
+        return NULL;
+    }
+
+    uint32_t len = (uint32_t)(end - str);
+    char* ret = (char*)mem_malloc(len + 1);
+    if (ret) {
+        mem_copy(ret, str, len + 1);
+    }
+    return ret;
+}
+
+static ps_path* _load_path_value(const _svg_binary_reader* reader, const _svg_binary_attr* rec)
+{
+    uint32_t count = 0;
+    const uint8_t* data = _reader_data(reader, rec->value, rec->size);
+    if (!data || rec->size < sizeof(uint32_t)) {
+        return NULL;
+    }
+
+    mem_copy(&count, data, sizeof(uint32_t));
+    if (count != (rec->size - sizeof(uint32_t)) / sizeof(_svg_binary_vertex)) {
+        return NULL;
+    }
+    data += sizeof(uint32_t);
+
+    ps_path* path = ps_path_create();
+    if (!path) {
+        return NULL;
+    }
+
+    _svg_binary_vertex v[3];
+    for (uint32_t i = 0; i < count; i++) {
+        mem_copy(&v[0], data + i * sizeof(_svg_binary_vertex), sizeof(_svg_binary_vertex));
+        ps_point pt = {v[0].x, v[0].y};
+
+        switch (v[0].cmd & PATH_CMD_END_POLY) {
+            case PATH_CMD_MOVE_TO:
+                ps_path_move_to(path, &pt);
+                break;
+            case PATH_CMD_LINE_TO:
+                ps_path_line_to(path, &pt);
+                break;
+            case PATH_CMD_CURVE3:
+                if (i + 1 < count) {
+                    mem_copy(&v[1], data + (i + 1) * sizeof(_svg_binary_vertex), sizeof(_svg_binary_vertex));
+                    ps_point ep = {v[1].x, v[1].y};
+                    ps_path_quad_to(path, &pt, &ep);
+                    i += 1;
+                    break;
+                }
+                ps_path_unref(path);
+                return NULL;
+            case PATH_CMD_CURVE4:
+                if (i + 2 < count) {
+                    mem_copy(&v[1], data + (i + 1) * sizeof(_svg_binary_vertex), sizeof(_svg_binary_vertex) * 2);
+                    ps_point scp = {v[1].x, v[1].y};
+                    ps_point ep = {v[2].x, v[2].y};
+                    ps_path_bezier_to(path, &pt, &scp, &ep);
+                    i += 2;
+                    break;
+                }
+                ps_path_unref(path);
+                return NULL;
+            case PATH_CMD_END_POLY:
+                ps_path_sub_close(path);
+                break;
+            default:
+                ps_path_unref(path);
+                return NULL;
+        }
+    }
+    return path;
+}
+
+static psx_svg_timing_list* _load_timing_value(const _svg_binary_reader* reader, const _svg_binary_attr* rec)
+{
+    _svg_binary_timing timing;
+    const uint8_t* data = _reader_data(reader, rec->value, rec->size);
+    if (!data || rec->size < sizeof(_svg_binary_timing)) {
+        return NULL;
+    }
+
+    mem_copy(&timing, data, sizeof(_svg_binary_timing));
+    if (timing.offsets_len != (rec->size - sizeof(_svg_binary_timing)) / sizeof(float)) {
+        return NULL;
+    }
+
+    psx_svg_timing_list* tl = (psx_svg_timing_list*)mem_malloc(sizeof(psx_svg_timing_list));
+    if (!tl) {
+        return NULL;
+    }
+    memset(tl, 0, sizeof(psx_svg_timing_list));
+    tl->access_key = (char)timing.access_key;
+    tl->syncbase_type = timing.syncbase_type;
+
+    if (timing.offsets_len) {
+        tl->offsets_ms = (float*)mem_malloc(sizeof(float) * timing.offsets_len);
+        if (!tl->offsets_ms) {
+            psx_svg_timing_list_destroy(tl);
+            return NULL;
+        }
+        mem_copy(tl->offsets_ms, data + sizeof(_svg_binary_timing), sizeof(float) * timing.offsets_len);
+        tl->offsets_len = timing.offsets_len;
+    }
+
+    if ((timing.event_token != SVG_BINARY_NONE
+         && !(tl->event_token = _reader_string(reader, timing.event_token)))
+        || (timing.event_target_id != SVG_BINARY_NONE
+            && !(tl->event_target_id = _reader_string(reader, timing.event_target_id)))
+        || (timing.syncbase_id != SVG_BINARY_NONE
+            && !(tl->syncbase_id = _reader_string(reader, timing.syncbase_id)))) {
+        psx_svg_timing_list_destroy(tl);
+        return NULL;
+    }
+    return tl;
+}
+
+static void* _load_ptr_value(const _svg_binary_reader* reader, psx_svg_tag tag, const _svg_binary_attr* rec)
+{
+    _svg_binary_layout layout;
+    if (!_svg_attr_value_layout(tag, rec->attr_id, &layout)) {
+        return NULL;
+    }
+
+    const uint8_t* data = _reader_data(reader, rec->value, rec->size);
+    if (!data || !rec->size) {
+        return NULL;
+    }
+
+    uint32_t alloc_size = rec->size;
+    if (layout.kind == SVG_BINARY_VALUE_STRING) {
+        if (data[rec->size - 1] != '\0') {
+            return NULL;
+        }
+    } else if (layout.kind == SVG_BINARY_VALUE_FIXED) {
+        if (rec->size != layout.size) {
+            return NULL;
+        }
+    } else {
+        uint32_t length = 0;
+        if (rec->size < sizeof(uint32_t)) {
+            return NULL;
+        }
+        mem_copy(&length, data, sizeof(uint32_t));
+        if (length != (rec->size - sizeof(uint32_t)) / layout.size
+            || (rec->size - sizeof(uint32_t)) % layout.size) {
+            return NULL;
+        }
+        if (length < layout.min_count) {
+            alloc_size = sizeof(uint32_t) + layout.min_count * layout.size;
+        }
+    }
+
+    uint8_t* value = (uint8_t*)mem_malloc(alloc_size);
+    if (!value) {
+        return NULL;
+    }
+    mem_copy(value, data, rec->size);
+    memset(value + rec->size, 0, alloc_size - rec->size);
+
+    if (layout.kind == SVG_BINARY_VALUE_LIST && layout.size == sizeof(struct _transform_values_list)) {
+        const psx_svg_attr_values_list* list = (const psx_svg_attr_values_list*)value;
+        for (uint32_t i = 0; i < list->length; i++) {
+            const float* vals = NULL;
+            uint32_t len = 0;
+            psx_svg_attr_values_get_transform_entry(list, i, &vals, &len);
+            if (len > 6) {
+                mem_free(value);
+                return NULL;
+            }
+        }
+    }
+    return value;
+}
+
+static bool _load_attr(const _svg_binary_reader* reader, psx_svg_node* node, const _svg_binary_attr* rec)
+{
+    if (rec->attr_id < SVG_ATTR_ID || rec->attr_id > SVG_ATTR_TRANSFORM_TYPE
+        || rec->class_type < SVG_ATTR_VALUE_NONE || rec->class_type > SVG_ATTR_VALUE_INHERIT) {
+        return false;
+    }
+
+    psx_svg_attr_value value;
+    value.val = NULL;
+
+    switch (rec->val_type) {
+        case SVG_ATTR_VALUE_DATA:
+            if (!_svg_attr_data_allowed(rec->attr_id, rec->class_type)) {
+                return false;
+            }
+            value.uval = rec->value;
+            break;
+        case SVG_ATTR_VALUE_PTR:
+            value.val = _load_ptr_value(reader, node->type(), rec);
+            break;
+        case SVG_ATTR_VALUE_PATH_PTR:
+            if (rec->attr_id == SVG_ATTR_D
+                || (rec->attr_id == SVG_ATTR_PATH && node->type() != SVG_TAG_ANIMATE_MOTION)) {
+                value.val = _load_path_value(reader, rec);
+            }
+            break;
+        case SVG_ATTR_VALUE_TIMING_LIST_PTR:
+            if (rec->attr_id == SVG_ATTR_BEGIN || rec->attr_id == SVG_ATTR_END) {
+                value.val = _load_timing_value(reader, rec);
+            }
+            break;
+        default:
+            return false;
+    }
+
+    if (rec->val_type != SVG_ATTR_VALUE_DATA && !value.val) {
+        return false;
+    }
+
+    psx_array_append(node->attrs(), NULL);
+    psx_svg_attr* attr = psx_array_get_last(node->attrs(), psx_svg_attr);
+    attr->attr_id = rec->attr_id;
+    attr->val_type = rec->val_type;
+    attr->class_type = rec->class_type;
+    attr->value = value;
+    return true;
+}
+
+static bool _load_node(_svg_binary_reader* reader, psx_svg_node* node, const _svg_binary_node* rec)
+{
+    if (rec->tag < SVG_TAG_CONTENT || rec->tag > SVG_TAG_TBREAK
+        || rec->attr_count > reader->attr_count - reader->attr_index) {
+        return false;
+    }
+
+    // content node is a leaf holding the text only.
+    if (rec->tag == SVG_TAG_CONTENT
+        && (rec->content == SVG_BINARY_NONE || rec->attr_count || rec->child_count)) {
+        return false;
+    }
+
+    node->set_type((psx_svg_tag)rec->tag);
+
+    if (rec->content != SVG_BINARY_NONE) {
+        const uint8_t* content = _reader_data(reader, rec->content, rec->content_len + 1);
+        if (!content || rec->content_len == SVG_BINARY_NONE || content[rec->content_len] != '\0') {
+            return false;
+        }
+        node->set_content((const char*)content, rec->content_len);
+    }
+
+    if (rec->attr_count > psx_array_capacity(node->attrs())) {
+        psx_array_resize(node->attrs(), rec->attr_count);
+    }
+
+    for (uint32_t i = 0; i < rec->attr_count; i++) {
+        _svg_binary_attr attr;
+        mem_copy(&attr, reader->attrs + reader->attr_index * sizeof(_svg_binary_attr), sizeof(_svg_binary_attr));
+        reader->attr_index++;
+        if (!_load_attr(reader, node, &attr)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+typedef struct {
+    psx_svg_node* node;
+    uint32_t children; // children not loaded yet.
+} _svg_binary_parent;
+
+static psx_svg_node* _load_tree(_svg_binary_reader* reader)
+{
+    _svg_binary_node rec;
+    mem_copy(&rec, reader->nodes, sizeof(_svg_binary_node));
+    if (rec.tag != SVG_TAG_SVG) {
+        LOG_ERROR("Root element in svg document must be <svg>!\n");
+        return NULL;
+    }
+
+    // the tree can not be deeper than the node count.
+    _svg_binary_parent* parents = (_svg_binary_parent*)mem_malloc(sizeof(_svg_binary_parent) * reader->node_count);
+    if (!parents) {
+        return NULL;
+    }
+
+    psx_svg_node* root = NULL;
+    uint32_t depth = 0;
+    bool ret = true;
+
+    // nodes are owned by root as soon as they are created, a failure releases all of them with root.
+    for (uint32_t i = 0; i < reader->node_count; i++) {
+        mem_copy(&rec, reader->nodes + i * sizeof(_svg_binary_node), sizeof(_svg_binary_node));
+
+        psx_svg_node* parent = NULL;
+        if (i > 0) {
+            while (depth > 0 && !parents[depth - 1].children) {
+                depth--;
+            }
+            if (!depth) {
+                ret = false;
+                break;
+            }
+            parents[depth - 1].children--;
+            parent = parents[depth - 1].node;
+        }
+
+        psx_svg_node* node = psx_svg_node_create(parent);
+        if (!root) {
+            root = node;
+        }
+
+        if (!_load_node(reader, node, &rec)) {
+            ret = false;
+            break;
+        }
+
+        if (rec.child_count) {
+            parents[depth].node = node;
+            parents[depth].children = rec.child_count;
+            depth++;
+        }
+    }
+
+    for (uint32_t i = 0; ret && i < depth; i++) {
+        if (parents[i].children) {
+            ret = false;
+        }
+    }
+    mem_free(parents);
+
+    if (!ret || reader->attr_index != reader->attr_count) {
+        LOG_ERROR("Compiled svg document is corrupted!\n");
+        psx_svg_node_destroy(root);
+        return NULL;
+    }
+    return root;
+}
+
+uint32_t psx_svg_data_type(const uint8_t* data, uint32_t len)
+{
+    uint32_t n = len < PSX_SVG_BINARY_MAGIC_LEN ? len : PSX_SVG_BINARY_MAGIC_LEN;
+    if (memcmp(data, _svg_binary_magic, n) != 0) {
+        return SVG_DATA_XML;
+    }
+    return n == PSX_SVG_BINARY_MAGIC_LEN ? SVG_DATA_BINARY : SVG_DATA_UNKNOWN;
+}
+
+psx_svg_node* psx_svg_load_binary(const uint8_t* data, uint32_t len)
+{
+    _svg_binary_header header;
+    if (!data || len < sizeof(_svg_binary_header)) {
+        LOG_ERROR("Bad arguments for svg data or length!\n");
+        return NULL;
+    }
+
+    mem_copy(&header, data, sizeof(_svg_binary_header));
+    if (memcmp(header.magic, _svg_binary_magic, PSX_SVG_BINARY_MAGIC_LEN) != 0
+        || header.byte_order != SVG_BINARY_BYTE_ORDER || header.version != SVG_BINARY_VERSION) {
+        LOG_ERROR("Compiled svg document is not supported!\n");
+        return NULL;
+    }
+
+    uint64_t size = (uint64_t)sizeof(_svg_binary_header)
+                    + (uint64_t)header.node_count * sizeof(_svg_binary_node)
+                    + (uint64_t)header.attr_count * sizeof(_svg_binary_attr) + header.data_size;
+    if (!header.node_count || header.file_size != size || size > len) {
+        LOG_ERROR("Compiled svg document is corrupted!\n");
+        return NULL;
+    }
+
+    _svg_binary_reader reader;
+    reader.nodes = data + sizeof(_svg_binary_header);
+    reader.attrs = reader.nodes + header.node_count * sizeof(_svg_binary_node);
+    reader.data = reader.attrs + header.attr_count * sizeof(_svg_binary_attr);
+    reader.node_count = header.node_count;
+    reader.attr_count = header.attr_count;
+    reader.data_size = header.data_size;
+    reader.attr_index = 0;
+
+    return _load_tree(&reader);
+}
+
+#ifdef __cplusplus
+}
+#endif
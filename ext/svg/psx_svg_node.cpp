@@ -85,6 +85,23 @@ static bool svg_token_process(void* context, const psx_xml_token* token)
 extern "C" {
 #endif
 
+static psx_svg_node* _svg_parser_take_document(psx_svg_parser* parser)
+{
+    if (psx_svg_parser_is_finish(parser)) {
+        psx_svg_node* doc = parser->doc_root;
+        parser->doc_root = NULL;
+        psx_svg_parser_destroy(parser);
+#ifdef _DEBUG
+        psx_svg_dump_tree(doc, 0);
+#endif
+        return doc;
+    } else {
+        psx_svg_parser_destroy(parser);
+        LOG_ERROR("SVG document parser raise errors!\n");
+        return NULL;
+    }
+}
+
 psx_svg_node* psx_svg_load_data(const char* svg_data, uint32_t len)
 {
     if (!svg_data || !len) {
@@ -92,23 +109,15 @@ psx_svg_node* psx_svg_load_data(const char* svg_data, uint32_t len)
         return NULL;
     }
 
+    if (psx_svg_data_type((const uint8_t*)svg_data, len) == SVG_DATA_BINARY) {
+        return psx_svg_load_binary((const uint8_t*)svg_data, len);
+    }
+
     psx_svg_parser parser;
     psx_svg_parser_init(&parser);
 
     if (psx_xml_tokenizer(svg_data, len, svg_token_process, &parser)) {
-        if (psx_svg_parser_is_finish(&parser)) {
-            psx_svg_node* doc = parser.doc_root;
-            parser.doc_root = NULL;
-            psx_svg_parser_destroy(&parser);
-#ifdef _DEBUG
-            psx_svg_dump_tree(doc, 0);
-#endif
-            return doc;
-        } else {
-            psx_svg_parser_destroy(&parser);
-            LOG_ERROR("SVG document parser raise errors!\n");
-            return NULL;
-        }
+        return _svg_parser_take_document(&parser);
     } else {
         psx_svg_parser_destroy(&parser);
         LOG_ERROR("SVG document tokenizer raise errors!\n");
@@ -116,6 +125,142 @@ psx_svg_node* psx_svg_load_data(const char* svg_data, uint32_t len)
     }
 }
 
+struct _psx_svg_stream {
+    psx_svg_parser parser;
+    psx_xml_stream* tokenizer;
+    uint32_t data_type;
+    uint8_t* binary; // compiled document, or the first bytes before data type is known.
+    uint32_t binary_size;
+    uint32_t binary_capacity;
+    bool finished;
+    bool error;
+};
+
+psx_svg_stream* psx_svg_stream_create(void)
+{
+    psx_svg_stream* stream = (psx_svg_stream*)mem_malloc(sizeof(psx_svg_stream));
+    if (!stream) {
+        return NULL;
+    }
+
+    psx_svg_parser_init(&stream->parser);
+    stream->tokenizer = psx_xml_stream_create(svg_token_process, &stream->parser);
+    if (!stream->tokenizer) {
+        psx_svg_parser_destroy(&stream->parser);
+        mem_free(stream);
+        return NULL;
+    }
+    stream->data_type = SVG_DATA_UNKNOWN;
+    stream->binary = NULL;
+    stream->binary_size = 0;
+    stream->binary_capacity = 0;
+    stream->finished = false;
+    stream->error = false;
+    return stream;
+}
+
+static bool _svg_stream_hold(psx_svg_stream* stream, const char* svg_data, uint32_t len)
+{
+    if (stream->binary_size + len < stream->binary_size) {
+        return false;
+    }
+
+    if (stream->binary_size + len > stream->binary_capacity) {
+        uint32_t capacity = stream->binary_capacity ? stream->binary_capacity : 4096;
+        while (capacity < stream->binary_size + len) {
+            if (capacity > 0x7FFFFFFF) {
+                return false;
+            }
+            capacity <<= 1;
+        }
+        uint8_t* data = (uint8_t*)mem_realloc(stream->binary, capacity);
+        if (!data) {
+            return false;
+        }
+        stream->binary = data;
+        stream->binary_capacity = capacity;
+    }
+
+    mem_copy(stream->binary + stream->binary_size, svg_data, len);
+    stream->binary_size += len;
+    return true;
+}
+
+// text document, hand the held bytes over to the tokenizer.
+static bool _svg_stream_begin_xml(psx_svg_stream* stream)
+{
+    bool ret = psx_xml_stream_push(stream->tokenizer, (const char*)stream->binary, stream->binary_size);
+    stream->data_type = SVG_DATA_XML;
+    mem_free(stream->binary);
+    stream->binary = NULL;
+    stream->binary_size = 0;
+    stream->binary_capacity = 0;
+    return ret;
+}
+
+bool psx_svg_stream_push(psx_svg_stream* stream, const char* svg_data, uint32_t len)
+{
+    if (!stream || stream->finished || stream->error) {
+        return false;
+    }
+
+    bool ret = true;
+    if (stream->data_type == SVG_DATA_XML) {
+        ret = psx_xml_stream_push(stream->tokenizer, svg_data, len);
+    } else if (!_svg_stream_hold(stream, svg_data, len)) {
+        ret = false;
+    } else if (stream->data_type == SVG_DATA_UNKNOWN) {
+        stream->data_type = psx_svg_data_type(stream->binary, stream->binary_size);
+        if (stream->data_type == SVG_DATA_XML) {
+            ret = _svg_stream_begin_xml(stream);
+        }
+    }
+
+    if (!ret) {
+        stream->error = true;
+        LOG_ERROR("SVG document tokenizer raise errors!\n");
+        return false;
+    }
+    return true;
+}
+
+psx_svg_node* psx_svg_stream_finish(psx_svg_stream* stream)
+{
+    if (!stream || stream->finished) {
+        return NULL;
+    }
+
+    if (stream->data_type == SVG_DATA_UNKNOWN && stream->binary_size && !stream->error) {
+        stream->error = !_svg_stream_begin_xml(stream);
+    }
+
+    stream->finished = true;
+    if (stream->error) {
+        psx_svg_parser_destroy(&stream->parser);
+        return NULL;
+    }
+
+    if (stream->data_type == SVG_DATA_BINARY) {
+        psx_svg_parser_destroy(&stream->parser);
+        return psx_svg_load_binary(stream->binary, stream->binary_size);
+    }
+    return _svg_parser_take_document(&stream->parser);
+}
+
+void psx_svg_stream_destroy(psx_svg_stream* stream)
+{
+    if (stream) {
+        if (!stream->finished) {
+            psx_svg_parser_destroy(&stream->parser);
+        }
+        psx_xml_stream_destroy(stream->tokenizer);
+        if (stream->binary) {
+            mem_free(stream->binary);
+        }
+        mem_free(stream);
+    }
+}
+
 psx_svg_node* psx_svg_node_create(psx_svg_node* parent)
 {
     return new psx_svg_node(parent);
@@ -312,6 +312,34 @@ extern "C" {
 
 psx_svg_node* psx_svg_load_data(const char* svg_data, uint32_t len);
 
+// incremental loading, svg data is pushed in chunks and parsed as it arrives.
+typedef struct _psx_svg_stream psx_svg_stream;
+
+psx_svg_stream* psx_svg_stream_create(void);
+
+bool psx_svg_stream_push(psx_svg_stream* stream, const char* svg_data, uint32_t len);
+
+psx_svg_node* psx_svg_stream_finish(psx_svg_stream* stream);
+
+void psx_svg_stream_destroy(psx_svg_stream* stream);
+
+// compiled binary document, the resolved node tree which loads without text parsing.
+#define PSX_SVG_BINARY_MAGIC_LEN 8
+
+enum {
+    SVG_DATA_UNKNOWN = 0, // too short to tell.
+    SVG_DATA_XML,
+    SVG_DATA_BINARY,
+};
+
+uint32_t psx_svg_data_type(const uint8_t* data, uint32_t len);
+
+psx_svg_node* psx_svg_load_binary(const uint8_t* data, uint32_t len);
+
+typedef bool (*psx_svg_binary_writer_fn)(void* param, const uint8_t* data, uint32_t len);
+
+bool psx_svg_save_binary(const psx_svg_node* doc, psx_svg_binary_writer_fn func, void* param);
+
 psx_svg_node* psx_svg_node_create(psx_svg_node* parent);
 
 void psx_svg_node_destroy(psx_svg_node* node);
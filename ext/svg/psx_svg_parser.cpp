@@ -25,6 +25,7 @@
  */
 
 #include <math.h>
+#include <float.h>
 #include "psx_svg_parser.h"
 
 #ifdef __cplusplus
@@ -228,6 +229,40 @@ static const struct {
     {"type", 4, SVG_ATTR_TRANSFORM_TYPE},
 };
 
+// Perfect hash slots of the tag and attribute maps, each slot holds the map index plus one.
+// Generated by tools/gen_svg_name_hash.py, run it again after changing the maps above.
+#define TAG_HASH_BITS 6
+#define TAG_HASH_SEED 0xf21201e5u
+
+static const uint8_t _svg_tag_hash_slots[1 << TAG_HASH_BITS] = {
+    28, 0, 0, 0, 0, 6, 0, 0, 0, 0, 4, 0, 0, 24, 19, 29,
+    5, 30, 20, 0, 14, 0, 0, 25, 15, 0, 0, 8, 0, 7, 11, 0,
+    26, 0, 18, 21, 27, 0, 12, 0, 0, 22, 0, 0, 0, 13, 0, 0,
+    0, 0, 9, 16, 3, 0, 0, 0, 17, 2, 0, 10, 23, 0, 0, 0,
+};
+
+#define ATTR_HASH_BITS 8
+#define ATTR_HASH_SEED 0x50162ef7u
+
+static const uint8_t _svg_attr_hash_slots[1 << ATTR_HASH_BITS] = {
+    17, 71, 0, 0, 35, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 70,
+    0, 0, 26, 0, 0, 0, 8, 0, 19, 49, 0, 28, 0, 0, 0, 0,
+    0, 42, 0, 69, 0, 0, 18, 0, 0, 62, 0, 0, 0, 0, 59, 0,
+    0, 0, 0, 0, 0, 7, 40, 0, 0, 67, 0, 53, 34, 0, 0, 0,
+    38, 68, 65, 0, 0, 0, 0, 0, 75, 46, 20, 0, 15, 0, 0, 48,
+    0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0, 10, 50, 0, 0,
+    21, 73, 0, 0, 0, 9, 51, 0, 32, 0, 0, 0, 0, 0, 0, 0,
+    22, 0, 16, 55, 0, 0, 0, 0, 0, 0, 0, 0, 74, 0, 0, 0,
+    13, 11, 57, 0, 0, 56, 23, 0, 0, 66, 0, 0, 0, 1, 0, 5,
+    52, 29, 0, 0, 0, 0, 64, 0, 0, 0, 30, 0, 0, 47, 0, 0,
+    0, 36, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 58, 0, 61, 0, 0, 0, 0, 0, 45, 0, 0, 0, 12, 0,
+    0, 0, 0, 0, 0, 0, 0, 72, 0, 0, 6, 0, 0, 0, 25, 0,
+    0, 24, 0, 0, 0, 39, 0, 0, 0, 0, 27, 0, 0, 0, 0, 0,
+    63, 0, 0, 14, 0, 0, 44, 60, 0, 3, 37, 31, 0, 0, 0, 33,
+    41, 0, 43, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
 static const struct {
     const char* name;
     uint32_t align;
@@ -423,6 +458,231 @@ static INLINE bool _is_number_begin(char ch)
     return ch != 0 && strchr("0123456789+-.", ch) != NULL;
 }
 
+static INLINE bool _is_digit(char ch)
+{
+    return (uint8_t)(ch - '0') < 10;
+}
+
+/*
+ * Svg number scanner, it follows the number grammar of svg (sign, digits,
+ * fraction and exponent) without the current locale, never reads past
+ * str_end and rounds to the nearest float.
+ */
+#define SVG_NUMBER_FAST_DIGITS 19
+#define SVG_NUMBER_EXACT_DIGITS 128 // more digits than any float midpoint has
+#define SVG_BIGINT_WORDS 40
+
+static const float _svg_float_pow10[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+};
+
+static const double _svg_double_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+typedef struct {
+    uint32_t size;
+    uint32_t words[SVG_BIGINT_WORDS];
+} psx_svg_bigint;
+
+static void _bigint_mul_add(psx_svg_bigint* b, uint32_t mul, uint32_t add)
+{
+    uint64_t carry = add;
+    for (uint32_t i = 0; i < b->size; i++) {
+        carry += (uint64_t)b->words[i] * mul;
+        b->words[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    if (carry && b->size < SVG_BIGINT_WORDS) {
+        b->words[b->size++] = (uint32_t)carry;
+    }
+}
+
+static void _bigint_mul_pow5(psx_svg_bigint* b, int32_t e)
+{
+    while (e >= 13) {
+        _bigint_mul_add(b, 1220703125, 0); // 5^13
+        e -= 13;
+    }
+    if (e > 0) {
+        uint32_t m = 1;
+        while (e-- > 0) {
+            m *= 5;
+        }
+        _bigint_mul_add(b, m, 0);
+    }
+}
+
+static void _bigint_shl(psx_svg_bigint* b, int32_t bits)
+{
+    uint32_t words = (uint32_t)bits >> 5;
+    uint32_t shift = (uint32_t)bits & 31;
+    if (b->size == 0 || b->size + words + 1 > SVG_BIGINT_WORDS) {
+        return;
+    }
+
+    b->words[b->size + words] = 0;
+    for (int32_t i = (int32_t)b->size - 1; i >= 0; i--) {
+        uint32_t w = b->words[i];
+        b->words[i + words] = shift ? (w << shift) : w;
+        if (shift) {
+            b->words[i + words + 1] |= w >> (32 - shift);
+        }
+    }
+    for (uint32_t i = 0; i < words; i++) {
+        b->words[i] = 0;
+    }
+    b->size += words + 1;
+    while (b->size && !b->words[b->size - 1]) {
+        b->size--;
+    }
+}
+
+static int32_t _bigint_cmp(const psx_svg_bigint* a, const psx_svg_bigint* b)
+{
+    if (a->size != b->size) {
+        return a->size > b->size ? 1 : -1;
+    }
+    for (int32_t i = (int32_t)a->size - 1; i >= 0; i--) {
+        if (a->words[i] != b->words[i]) {
+            return a->words[i] > b->words[i] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+// compare digits * 10^e10 (plus a tiny remainder when sticky) with n * 2^e2
+static int32_t _compare_decimal(const psx_svg_bigint* digits, int32_t e10, bool sticky, uint32_t n, int32_t e2)
+{
+    psx_svg_bigint l = *digits;
+    psx_svg_bigint r;
+    r.size = n ? 1 : 0;
+    r.words[0] = n;
+
+    if (e10 >= 0) {
+        _bigint_mul_pow5(&l, e10);
+    } else {
+        _bigint_mul_pow5(&r, -e10);
+    }
+
+    if (e10 > e2) {
+        _bigint_shl(&l, e10 - e2);
+    } else {
+        _bigint_shl(&r, e2 - e10);
+    }
+
+    int32_t ret = _bigint_cmp(&l, &r);
+    return (ret == 0 && sticky) ? 1 : ret;
+}
+
+static float _decimal_to_float_exact(const char* mant, const char* mant_end, int32_t exp, uint64_t m, int32_t m_exp, int32_t m_digits)
+{
+    // out of float range
+    if (m_digits + m_exp > 39) {
+        return HUGE_VALF;
+    } else if (m_digits + m_exp < -46) {
+        return 0.0f;
+    }
+
+    psx_svg_bigint digits;
+    digits.size = 0;
+    int32_t num = 0;
+    int32_t e10 = exp;
+    bool sticky = false;
+    bool fraction = false;
+
+    for (const char* p = mant; p < mant_end; p++) {
+        if (*p == '.') {
+            fraction = true;
+            continue;
+        }
+
+        uint32_t d = (uint32_t)(*p - '0');
+        if (num == 0 && d == 0) {
+            e10 -= fraction ? 1 : 0;
+        } else if (num < SVG_NUMBER_EXACT_DIGITS) {
+            _bigint_mul_add(&digits, 10, d);
+            num++;
+            e10 -= fraction ? 1 : 0;
+        } else {
+            sticky = sticky || (d != 0);
+            e10 += fraction ? 0 : 1;
+        }
+    }
+
+    // start from a close guess and step to the float holding the value between its midpoints.
+    double guess = (double)m;
+    while (m_exp > 22) {
+        guess *= 1e22;
+        m_exp -= 22;
+    }
+    while (m_exp < -22) {
+        guess /= 1e22;
+        m_exp += 22;
+    }
+    guess = m_exp < 0 ? guess / _svg_double_pow10[-m_exp] : guess * _svg_double_pow10[m_exp];
+
+    float f = guess > FLT_MAX ? FLT_MAX : (float)guess;
+    uint32_t bits = 0;
+    mem_copy(&bits, &f, sizeof(float));
+
+    for (;;) {
+        uint32_t be = bits >> 23;
+        uint32_t n = be ? ((bits & 0x7fffff) | 0x800000) : bits;
+        int32_t e2 = be ? ((int32_t)be - 150) : -149;
+
+        int32_t ret = _compare_decimal(&digits, e10, sticky, 2 * n + 1, e2 - 1);
+        if (ret > 0 || (ret == 0 && (bits & 1))) {
+            if (++bits >= 0x7f800000) {
+                return HUGE_VALF;
+            }
+            continue;
+        }
+
+        if (bits) {
+            if (n == 0x800000 && be > 1) {
+                ret = _compare_decimal(&digits, e10, sticky, 4 * n - 1, e2 - 2);
+            } else {
+                ret = _compare_decimal(&digits, e10, sticky, 2 * n - 1, e2 - 1);
+            }
+            if (ret < 0 || (ret == 0 && (bits & 1))) {
+                --bits;
+                continue;
+            }
+        }
+        break;
+    }
+
+    mem_copy(&f, &bits, sizeof(float));
+    return f;
+}
+
+static INLINE float _decimal_to_float(uint64_t m, int32_t e)
+{
+    // both operands exact, one rounding
+    if (m <= (1 << 24) && e >= -10 && e <= 10) {
+        return e < 0 ? (float)m / _svg_float_pow10[-e] : (float)m * _svg_float_pow10[e];
+    }
+
+    // correctly rounded double, rounded again to float, fix the value landing on a float midpoint.
+    double p = _svg_double_pow10[e < 0 ? -e : e];
+    double d = e < 0 ? (double)m / p : (double)m * p;
+    float f = (float)d;
+    double r = d - (double)f;
+
+    if (r != 0.0) {
+        float g = nextafterf(f, r > 0.0 ? HUGE_VALF : -HUGE_VALF);
+        if (d == ((double)f + (double)g) * 0.5) {
+            double err = e < 0 ? fma(-d, p, (double)m) : fma((double)m, p, -d);
+            if (err != 0.0) {
+                f = (float)nextafter(d, err > 0.0 ? HUGE_VAL : -HUGE_VAL);
+            }
+        }
+    }
+    return f;
+}
+
 static INLINE const char* _parse_number(const char* str, const char* str_end, float* val)
 {
     if (!str) {
@@ -437,9 +697,83 @@ static INLINE const char* _parse_number(const char* str, const char* str_end, fl
         return NULL;
     }
 
-    char* end = NULL;
-    *val = strtof(str, &end);
-    return end;
+    const char* p = str;
+    bool negative = false;
+    if (*p == '+' || *p == '-') {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    const char* mant = p;
+    uint64_t m = 0;
+    int32_t exp = 0;
+    int32_t digits = 0;
+    bool truncated = false;
+
+    for (; p < str_end && _is_digit(*p); p++) {
+        uint32_t d = (uint32_t)(*p - '0');
+        if (digits < SVG_NUMBER_FAST_DIGITS) {
+            m = m * 10 + d;
+            digits += m ? 1 : 0;
+        } else {
+            truncated = truncated || (d != 0);
+            exp++;
+        }
+    }
+
+    bool has_digits = p > mant;
+    if (p < str_end && *p == '.') {
+        const char* frac = ++p;
+        for (; p < str_end && _is_digit(*p); p++) {
+            uint32_t d = (uint32_t)(*p - '0');
+            if (digits < SVG_NUMBER_FAST_DIGITS) {
+                m = m * 10 + d;
+                digits += m ? 1 : 0;
+                exp--;
+            } else {
+                truncated = truncated || (d != 0);
+            }
+        }
+        has_digits = has_digits || (p > frac);
+    }
+
+    if (!has_digits) { // no conversion
+        *val = 0.0f;
+        return str;
+    }
+
+    const char* mant_end = p;
+    int32_t exp_part = 0;
+    if (p < str_end && (*p == 'e' || *p == 'E')) {
+        const char* e = p + 1;
+        bool exp_negative = false;
+        if (e < str_end && (*e == '+' || *e == '-')) {
+            exp_negative = (*e == '-');
+            ++e;
+        }
+        if (e < str_end && _is_digit(*e)) {
+            for (; e < str_end && _is_digit(*e); e++) {
+                if (exp_part < 100000) {
+                    exp_part = exp_part * 10 + (*e - '0');
+                }
+            }
+            exp_part = exp_negative ? -exp_part : exp_part;
+            exp += exp_part;
+            p = e;
+        }
+    }
+
+    float f = 0.0f;
+    if (m != 0) {
+        if (!truncated && m < ((uint64_t)1 << 53) && exp >= -22 && exp <= 22) {
+            f = _decimal_to_float(m, exp);
+        } else {
+            f = _decimal_to_float_exact(mant, mant_end, exp_part, m, exp, digits);
+        }
+    }
+
+    *val = negative ? -f : f;
+    return p;
 }
 
 static INLINE const char* _parse_length(const char* str, const char* str_end, int32_t dpi, float* val)
@@ -726,13 +1060,25 @@ static INLINE const char* _parse_matrix(const char* str, const char* str_end, ui
     return str;
 }
 
+static INLINE uint32_t _svg_name_hash(const char* name, uint32_t len, uint32_t seed, uint32_t bits)
+{
+    uint32_t key = len | ((uint32_t)(uint8_t)name[0] << 8)
+                   | ((uint32_t)(uint8_t)name[(len * 3) >> 2] << 16) | ((uint32_t)(uint8_t)name[len - 1] << 24);
+    return (key * seed) >> (32 - bits);
+}
+
 static INLINE psx_svg_tag _get_svg_tag_type(const psx_xml_token* token)
 {
-    uint32_t len = MAP_LEN(_svg_tag_map);
     uint32_t token_len = TOKEN_LEN(token);
 
-    for (uint32_t i = 0; i < len; i++) {
-        if (token_len == _svg_tag_map[i].name_len && strncmp(_svg_tag_map[i].name, token->start, token_len) == 0) {
+    if (token_len == 0) {
+        return SVG_TAG_CONTENT;
+    }
+
+    uint32_t slot = _svg_tag_hash_slots[_svg_name_hash(token->start, token_len, TAG_HASH_SEED, TAG_HASH_BITS)];
+    if (slot) {
+        uint32_t i = slot - 1;
+        if (token_len == _svg_tag_map[i].name_len && memcmp(_svg_tag_map[i].name, token->start, token_len) == 0) {
             return _svg_tag_map[i].tag;
         }
     }
@@ -741,11 +1087,16 @@ static INLINE psx_svg_tag _get_svg_tag_type(const psx_xml_token* token)
 
 static INLINE psx_svg_attr_type _get_svg_attr_type(const char* attr_start, const char* attr_end)
 {
-    uint32_t len = MAP_LEN(_svg_attr_map);
     uint32_t attr_len = BUF_LEN(attr_start, attr_end);
 
-    for (uint32_t i = 0; i < len; i++) {
-        if (attr_len == _svg_attr_map[i].name_len && strncmp(_svg_attr_map[i].name, attr_start, attr_len) == 0) {
+    if (attr_len == 0) {
+        return SVG_ATTR_INVALID;
+    }
+
+    uint32_t slot = _svg_attr_hash_slots[_svg_name_hash(attr_start, attr_len, ATTR_HASH_SEED, ATTR_HASH_BITS)];
+    if (slot) {
+        uint32_t i = slot - 1;
+        if (attr_len == _svg_attr_map[i].name_len && memcmp(_svg_attr_map[i].name, attr_start, attr_len) == 0) {
             return _svg_attr_map[i].attr;
         }
     }
@@ -1892,11 +2243,6 @@ struct _parse_value_list_context {
     psx_svg_attr_values_list* list;
 };
 
-struct _transform_values_list {
-    uint32_t length;
-    float data[6];
-};
-
 bool psx_svg_attr_values_get_transform_entry(const psx_svg_attr_values_list* list, uint32_t idx,
                                              const float** out_vals, uint32_t* out_len)
 {
@@ -76,6 +76,12 @@ typedef struct psx_svg_timing_list {
 // Helper for freeing a timing list allocated by the parser.
 void psx_svg_timing_list_destroy(psx_svg_timing_list* tl);
 
+// One entry of an animateTransform values list, matrix needs 6 values, others at most 3.
+struct _transform_values_list {
+    uint32_t length;
+    float data[6];
+};
+
 // Access one transform entry stored in a parsed animation values list.
 // Returns false if out of range or list is invalid.
 bool psx_svg_attr_values_get_transform_entry(const psx_svg_attr_values_list* list,
@@ -173,7 +173,7 @@ static INLINE bool _psx_special_handles(xml_token_state* state)
 static INLINE void _psx_proc_xml_inst(xml_token_state* state, psx_xml_token* token)
 {
     // ignore xml inst
-    while (state->cur <= state->end) {
+    while (state->cur < state->end) {
         char ch = *(state->cur);
         if (ch == '>' && (*(state->cur - 1)) == '?') {
             _psx_clear_state(state, IN_XMLINST);
@@ -187,7 +187,7 @@ static INLINE void _psx_proc_xml_inst(xml_token_state* state, psx_xml_token* tok
 static INLINE void _psx_proc_comment(xml_token_state* state, psx_xml_token* token)
 {
     // ignore comment
-    while (state->cur <= state->end) {
+    while (state->cur < state->end) {
         char ch = *(state->cur);
         if (ch == '>' && (*(state->cur - 1)) == '-' && (*(state->cur - 2)) == '-') {
             _psx_clear_state(state, IN_COMMENT);
@@ -201,7 +201,7 @@ static INLINE void _psx_proc_comment(xml_token_state* state, psx_xml_token* toke
 static INLINE void _psx_proc_doctype(xml_token_state* state, psx_xml_token* token)
 {
     // ignore doctype
-    while (state->cur <= state->end) {
+    while (state->cur < state->end) {
         char ch = *(state->cur);
         if (ch == '>') {
             _psx_clear_state(state, IN_DOCTYPE);
@@ -214,7 +214,7 @@ static INLINE void _psx_proc_doctype(xml_token_state* state, psx_xml_token* toke
 
 static INLINE bool _psx_proc_entity(xml_token_state* state, psx_xml_token* token, xml_token_process cb, void* data)
 {
-    while (state->cur <= state->end) {
+    while (state->cur < state->end) {
         switch (_psx_get_entity_state(state)) {
             case NO_ENTITY: {
                     if (!_xml_token_process(token, cb, data)) {
@@ -295,7 +295,7 @@ static INLINE bool _psx_proc_entity(xml_token_state* state, psx_xml_token* token
 
 static INLINE bool _psx_proc_tag(xml_token_state* state, psx_xml_token* token, xml_token_process cb, void* data)
 {
-    while (state->cur <= state->end) {
+    while (state->cur < state->end) {
         switch (_psx_get_tag_state(state)) {
             case NO_TAG: {
                     if (!_xml_token_process(token, cb, data)) {
@@ -439,136 +439,280 @@ static INLINE bool _psx_proc_tag(xml_token_state* state, psx_xml_token* token, x
     return true;
 }
 
-bool psx_xml_tokenizer(const char* xml_data, uint32_t data_len, xml_token_process cb, void* data)
+static bool _psx_xml_tokenize(xml_token_state* state, psx_xml_token* token, xml_token_process cb, void* data)
 {
-    if (!xml_data || data_len == 0) {
-        return false;
-    }
-
-    psx_xml_token token;
-    _psx_token_init(&token);
-
-    xml_token_state state;
-    state.flags = 0;
-    state.cur = xml_data;
-    state.end = xml_data + data_len;
-
-    while (state.cur < state.end) {
-        char ch = *(state.cur);
+    while (state->cur < state->end) {
+        char ch = *(state->cur);
         if (ch == '\r' || ch == '\n') { // skip LR character
-            state.cur++;
+            state->cur++;
             continue;
-        } else if (_psx_special_handles(&state)) {
-            if (_psx_is_state(&state, IN_START_TAG)) {
-                _psx_clear_state(&state, IN_START_TAG);
+        } else if (_psx_special_handles(state)) {
+            if (_psx_is_state(state, IN_START_TAG)) {
+                _psx_clear_state(state, IN_START_TAG);
 
                 switch (ch) {
                     case '/': // end tag
-                        _psx_set_tag_state(&state, TAG_NAME);
+                        _psx_set_tag_state(state, TAG_NAME);
                         break;
                     case '!': {
                             // <!-- or <!DOCTYPE
-                            _psx_set_state(&state, IN_SEARCH);
-                            state.cur++;
+                            _psx_set_state(state, IN_SEARCH);
+                            state->cur++;
                         }
                         break;
                     case '?': {
                             // xml instruction
-                            _psx_set_state(&state, IN_XMLINST);
-                            state.cur++;
+                            _psx_set_state(state, IN_XMLINST);
+                            state->cur++;
                         }
                         break;
                     default: {
                             if (isalpha(ch)) {
-                                _psx_set_tag_state(&state, TAG_NAME);
+                                _psx_set_tag_state(state, TAG_NAME);
                             } else {
-                                psx_array_destroy(&token.attrs);
                                 return false;
                             }
                         }
                 }
                 // process token
-                if (!_xml_token_process(&token, cb, data)) {
-                    psx_array_destroy(&token.attrs);
+                if (!_xml_token_process(token, cb, data)) {
                     return false;
                 }
-            } else if (_psx_is_state(&state, IN_SEARCH)) {
+            } else if (_psx_is_state(state, IN_SEARCH)) {
                 if (ch == '-' || isalpha(ch)) {
-                    if (!token.start) {
-                        token.start = state.cur;
+                    if (!token->start) {
+                        token->start = state->cur;
                     }
-                    token.end = state.cur;
+                    token->end = state->cur;
                 } else {
                     // processing as a normal tag name.
-                    _psx_clear_state(&state, IN_SEARCH);
-                    _psx_set_tag_state(&state, TAG_NAME);
+                    _psx_clear_state(state, IN_SEARCH);
+                    _psx_set_tag_state(state, TAG_NAME);
                     continue;
                 }
 
-                if (((token.end - token.start) == 1) && (token.start[0] == '-') && (token.start[1] == '-')) {
+                if (((token->end - token->start) == 1) && (token->start[0] == '-') && (token->start[1] == '-')) {
                     // is <!-- comment start
-                    _psx_clear_state(&state, IN_SEARCH);
-                    token.start = token.end = NULL;
-                    _psx_set_state(&state, IN_COMMENT);
-                } else if (((token.end - token.start) == 6) && (strncmp(token.start, "DOCTYPE", 7) == 0)) {
-                    _psx_clear_state(&state, IN_SEARCH);
-                    token.start = token.end = NULL;
-                    _psx_set_state(&state, IN_DOCTYPE);
+                    _psx_clear_state(state, IN_SEARCH);
+                    token->start = token->end = NULL;
+                    _psx_set_state(state, IN_COMMENT);
+                } else if (((token->end - token->start) == 6) && (strncmp(token->start, "DOCTYPE", 7) == 0)) {
+                    _psx_clear_state(state, IN_SEARCH);
+                    token->start = token->end = NULL;
+                    _psx_set_state(state, IN_DOCTYPE);
                 }
-                state.cur++;
-            } else if (_psx_is_state(&state, IN_COMMENT)) {
-                _psx_proc_comment(&state, &token);
-            } else if (_psx_is_state(&state, IN_DOCTYPE)) {
-                _psx_proc_doctype(&state, &token);
-            } else if (_psx_is_state(&state, IN_ENTITY_MASK)) {
-                // process token
-                if (!_xml_token_process(&token, cb, data)) {
-                    psx_array_destroy(&token.attrs);
+                state->cur++;
+            } else if (_psx_is_state(state, IN_COMMENT)) {
+                _psx_proc_comment(state, token);
+            } else if (_psx_is_state(state, IN_DOCTYPE)) {
+                _psx_proc_doctype(state, token);
+            } else if (_psx_is_state(state, IN_ENTITY_MASK)) {
+                // process token, unless resuming an entity cut by the end of data.
+                if (token->type != PSX_XML_ENTITY && !_xml_token_process(token, cb, data)) {
                     return false;
                 }
 
-                if (!_psx_proc_entity(&state, &token, cb, data)) {
-                    psx_array_destroy(&token.attrs);
+                if (!_psx_proc_entity(state, token, cb, data)) {
                     return false;
                 }
-            } else if (_psx_is_state(&state, IN_TAG_MASK)) {
-                if (!_psx_proc_tag(&state, &token, cb, data)) {
-                    psx_array_destroy(&token.attrs);
+            } else if (_psx_is_state(state, IN_TAG_MASK)) {
+                if (!_psx_proc_tag(state, token, cb, data)) {
                     return false;
                 }
-            } else if (_psx_is_state(&state, IN_XMLINST)) {
-                _psx_proc_xml_inst(&state, &token);
+            } else if (_psx_is_state(state, IN_XMLINST)) {
+                _psx_proc_xml_inst(state, token);
             }
         } else {
             switch (ch) {
                 case '<': {
-                        _psx_set_state(&state, IN_START_TAG); // start a new tag
-                        state.cur++;
+                        _psx_set_state(state, IN_START_TAG); // start a new tag
+                        state->cur++;
                     }
                     break;
                 case '&': {
-                        _psx_set_entity_state(&state, START_ENTITY);
-                        state.cur++;
+                        _psx_set_entity_state(state, START_ENTITY);
+                        state->cur++;
                     }
                     break;
                 default: {
-                        if (!token.start) {
-                            token.start = state.cur;
-                        }
-                        if (state.cur == state.end) {
-                            goto finish; // make santizer happy
+                        if (!token->start) {
+                            token->start = state->cur;
                         }
-                        token.end = ++state.cur;
+                        token->end = ++state->cur;
                     }
             }
         }
     }
+    return true;
+}
 
-finish:
+bool psx_xml_tokenizer(const char* xml_data, uint32_t data_len, xml_token_process cb, void* data)
+{
+    if (!xml_data || data_len == 0) {
+        return false;
+    }
+
+    psx_xml_token token;
+    _psx_token_init(&token);
+
+    xml_token_state state;
+    state.flags = 0;
+    state.cur = xml_data;
+    state.end = xml_data + data_len;
+
+    bool ret = _psx_xml_tokenize(&state, &token, cb, data);
     psx_array_destroy(&token.attrs);
+    return ret;
+}
+
+// push tokenizer, data of unfinished token is kept until following chunks complete it.
+#define XML_STREAM_MIN_BUFFER 4096
+
+struct _psx_xml_stream {
+    xml_token_state state;
+    psx_xml_token token;
+    xml_token_process cb;
+    void* data;
+    char* buffer;
+    uint32_t buffer_size;
+    bool error;
+};
+
+static INLINE const char* _psx_rebase_ptr(const char* p, const char* from, const char* to)
+{
+    return p ? to + (p - from) : NULL;
+}
+
+// move pointers into [from, ...) to the same offsets of [to, ...).
+static INLINE void _psx_stream_rebase(psx_xml_stream* stream, const char* from, const char* to)
+{
+    psx_xml_token* token = &stream->token;
+    stream->state.cur = _psx_rebase_ptr(stream->state.cur, from, to);
+    stream->state.end = _psx_rebase_ptr(stream->state.end, from, to);
+    token->start = _psx_rebase_ptr(token->start, from, to);
+    token->end = _psx_rebase_ptr(token->end, from, to);
+
+    uint32_t len = psx_array_size(&token->attrs);
+    for (uint32_t i = 0; i < len; i++) {
+        psx_xml_token_attr* attr = psx_array_get(&token->attrs, i, psx_xml_token_attr);
+        attr->name_start = _psx_rebase_ptr(attr->name_start, from, to);
+        attr->name_end = _psx_rebase_ptr(attr->name_end, from, to);
+        attr->value_start = _psx_rebase_ptr(attr->value_start, from, to);
+        attr->value_end = _psx_rebase_ptr(attr->value_end, from, to);
+    }
+}
+
+static INLINE const char* _psx_stream_keep_from(psx_xml_stream* stream)
+{
+    psx_xml_token* token = &stream->token;
+    // comment and xml instruction look back two characters.
+    const char* keep = stream->state.cur - stream->buffer > 2 ? stream->state.cur - 2 : stream->buffer;
+
+    if (token->start && token->start < keep) {
+        keep = token->start;
+    }
+
+    uint32_t len = psx_array_size(&token->attrs);
+    for (uint32_t i = 0; i < len; i++) {
+        psx_xml_token_attr* attr = psx_array_get(&token->attrs, i, psx_xml_token_attr);
+        if (attr->name_start && attr->name_start < keep) {
+            keep = attr->name_start;
+        }
+    }
+    return keep;
+}
+
+psx_xml_stream* psx_xml_stream_create(xml_token_process cb, void* data)
+{
+    if (!cb) {
+        return NULL;
+    }
+
+    psx_xml_stream* stream = (psx_xml_stream*)mem_malloc(sizeof(psx_xml_stream));
+    if (!stream) {
+        return NULL;
+    }
+
+    _psx_token_init(&stream->token);
+    stream->state.flags = 0;
+    stream->state.cur = NULL;
+    stream->state.end = NULL;
+    stream->cb = cb;
+    stream->data = data;
+    stream->buffer = NULL;
+    stream->buffer_size = 0;
+    stream->error = false;
+    return stream;
+}
+
+bool psx_xml_stream_push(psx_xml_stream* stream, const char* xml_data, uint32_t data_len)
+{
+    if (!stream || stream->error) {
+        return false;
+    }
+
+    if (!xml_data || data_len == 0) {
+        return true;
+    }
+
+    uint32_t kept = stream->buffer ? (uint32_t)(stream->state.end - stream->buffer) : 0;
+    if (data_len > UINT32_MAX - kept) {
+        stream->error = true;
+        return false;
+    }
+
+    if (kept + data_len > stream->buffer_size) {
+        uint32_t size = stream->buffer_size > XML_STREAM_MIN_BUFFER ? stream->buffer_size : XML_STREAM_MIN_BUFFER;
+        while (size < kept + data_len) {
+            size = size > UINT32_MAX / 2 ? kept + data_len : size * 2;
+        }
+
+        char* buffer = (char*)mem_malloc(size);
+        if (!buffer) {
+            stream->error = true;
+            return false;
+        }
+
+        if (stream->buffer) {
+            mem_copy(buffer, stream->buffer, kept);
+            _psx_stream_rebase(stream, stream->buffer, buffer);
+            mem_free(stream->buffer);
+        } else {
+            stream->state.cur = stream->state.end = buffer;
+        }
+        stream->buffer = buffer;
+        stream->buffer_size = size;
+    }
+
+    mem_copy(stream->buffer + kept, xml_data, data_len);
+    stream->state.end = stream->buffer + kept + data_len;
+
+    if (!_psx_xml_tokenize(&stream->state, &stream->token, stream->cb, stream->data)) {
+        stream->error = true;
+        return false;
+    }
+
+    // drop processed data, keep the unfinished token at the front of buffer.
+    const char* keep = _psx_stream_keep_from(stream);
+    if (keep > stream->buffer) {
+        uint32_t len = (uint32_t)(stream->state.end - keep);
+        memmove(stream->buffer, keep, len);
+        _psx_stream_rebase(stream, keep, stream->buffer);
+    }
     return true;
 }
 
+void psx_xml_stream_destroy(psx_xml_stream* stream)
+{
+    if (stream) {
+        psx_array_destroy(&stream->token.attrs);
+        if (stream->buffer) {
+            mem_free(stream->buffer);
+        }
+        mem_free(stream);
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -67,6 +67,13 @@ typedef bool (*xml_token_process)(void* context, const psx_xml_token* token);
 
 bool psx_xml_tokenizer(const char* xml_data, uint32_t data_len, xml_token_process cb, void* data);
 
+// incremental tokenizer, xml data can be pushed in chunks split at any position.
+typedef struct _psx_xml_stream psx_xml_stream;
+
+psx_xml_stream* psx_xml_stream_create(xml_token_process cb, void* data);
+bool psx_xml_stream_push(psx_xml_stream* stream, const char* xml_data, uint32_t data_len);
+void psx_xml_stream_destroy(psx_xml_stream* stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,7 @@ set(PXSVG_SOURCES
     ${PXSVG_DIR}/psx_svg_node.cpp
     ${PXSVG_DIR}/psx_svg_parser.h
     ${PXSVG_DIR}/psx_svg_parser.cpp
+    ${PXSVG_DIR}/psx_svg_binary.cpp
     ${PXSVG_DIR}/psx_svg_render.h
     ${PXSVG_DIR}/psx_svg_render.cpp
     ${PXSVG_DIR}/psx_svg.cpp
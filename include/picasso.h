@@ -164,6 +164,20 @@ typedef struct _ps_mask ps_mask;
  */
 typedef struct _ps_font ps_font;
 
+/**
+ * \typedef ps_picture
+ * \brief An opaque type represents a recorded list of drawing commands.
+ * \sa ps_context, ps_canvas
+ */
+typedef struct _ps_picture ps_picture;
+
+/**
+ * \typedef ps_prepared_path
+ * \brief An opaque type represents a path rasterized for filling at many positions.
+ * \sa ps_path, ps_context
+ */
+typedef struct _ps_prepared_path ps_prepared_path;
+
 /**
  * \brief A character glyph of a font.
  */
@@ -293,6 +307,11 @@ typedef enum _ps_status {
 /**
  * \fn ps_status ps_last_status(void)
  * \brief Return the last status code of picasso.
+ *
+ * \note When multi threads is enabled, the status is kept for each thread,
+ *       objects can be created and released by different threads and contexts
+ *       of different canvases can be drawn at the same time.
+ *
  * \sa ps_version
  */
 PEXPORT ps_status PICAPI ps_last_status(void);
@@ -2175,6 +2194,70 @@ PEXPORT ps_bool PICAPI ps_get_font_info(ps_context* ctx, ps_font_info* info);
  */
 PEXPORT ps_font* PICAPI ps_set_font(ps_context* ctx, const ps_font* font);
 
+/**
+ * \fn void ps_set_font_cache_size(ps_context* ctx, uint32_t size)
+ * \brief Set the memory budget of fonts cached by the graphic context.
+ *
+ * \param ctx   Pointer to an existing context object.
+ * \param size  The memory budget in bytes for the cached fonts and their glyphs.
+ *
+ * \note The fonts are shared with the contexts created with this context as the shared context.
+ *       When the budget is exceeded, the least recently used fonts are freed, the font in use is kept.
+ *       Glyphs got from a freed font by \a ps_get_glyph can not be used any more.
+ *       Each font also frees its least recently used glyphs when they are too many,
+ *       the glyphs got by \a ps_get_glyph are kept until the font is freed.
+ *       To get extended error information, call \a ps_last_status.
+ *
+ * \sa ps_set_font, ps_context_create, ps_get_font_cache_info
+ */
+PEXPORT void PICAPI ps_set_font_cache_size(ps_context* ctx, uint32_t size);
+
+/**
+ * \brief A structure that contains font cache information.
+ */
+typedef struct _ps_font_cache_info {
+    /**
+     * Number of cached fonts.
+     */
+    uint32_t fonts;
+    /**
+     * Memory used by the cached fonts and their glyphs in bytes.
+     */
+    uint32_t used_size;
+    /**
+     * Memory budget of the cached fonts in bytes.
+     */
+    uint32_t cache_size;
+    /**
+     * Number of glyphs found in the glyph caches.
+     */
+    uint32_t glyph_hits;
+    /**
+     * Number of glyphs not found in the glyph caches.
+     */
+    uint32_t glyph_misses;
+    /**
+     * Number of glyphs freed from the glyph caches.
+     */
+    uint32_t glyph_evictions;
+} ps_font_cache_info;
+
+/**
+ * \fn ps_bool ps_get_font_cache_info(ps_context* ctx, ps_font_cache_info* info)
+ * \brief Return the font cache information of the graphic context.
+ *
+ * \param ctx   Pointer to an existing context object.
+ * \param info  Pointer to a structure to receiving the font cache information.
+ *
+ * \return  True if is success, otherwise False.
+ *
+ * \note The glyph counters include the fonts freed from the cache.
+ *       To get extended error information, call \a ps_last_status.
+ *
+ * \sa ps_set_font_cache_size
+ */
+PEXPORT ps_bool PICAPI ps_get_font_cache_info(ps_context* ctx, ps_font_cache_info* info);
+
 /** @} end of font functions*/
 
 /**
@@ -2405,6 +2488,9 @@ PEXPORT void PICAPI ps_draw_text(ps_context* ctx, const ps_rect* area, const voi
  *
  * \return  True if is success, otherwise False.
  *
+ * \note The glyph is owned by the font cache of the context, it is kept until
+ *       the font is freed from the cache, see \a ps_set_font_cache_size.
+ *
  * \sa ps_show_glyphs, ps_get_path_from_glyph
  */
 PEXPORT ps_bool PICAPI ps_get_glyph(ps_context* ctx, int32_t ch, ps_glyph* glyph);
@@ -3547,6 +3633,158 @@ PEXPORT void PICAPI ps_path_clipping(ps_path* result, ps_path_operation op,
                                      const ps_path* a, const ps_path* b);
 
 /** @} end of path functions*/
+
+/**
+ * \defgroup picture Picture
+ * @{
+ */
+
+/**
+ * \fn ps_picture* ps_picture_create(void)
+ * \brief Create a new empty picture.
+ *
+ * \return If the function succeeds, the return value is the pointer to a new picture object.
+ *         If the function fails, the return value is NULL.
+ *
+ * \note To get extended error information, call \a ps_last_status.
+ *
+ * \sa ps_picture_ref, ps_picture_unref, ps_context_create_recording, ps_picture_playback
+ */
+PEXPORT ps_picture* PICAPI ps_picture_create(void);
+
+/**
+ * \fn ps_picture* ps_picture_ref(ps_picture* picture)
+ * \brief Increases the reference count of the picture by 1.
+ *
+ * \param picture  Pointer to an existing picture object.
+ *
+ * \return If the function succeeds, the return value is the pointer to the picture object.
+ *         If the function fails, the return value is NULL.
+ *
+ * \note To get extended error information, call \a ps_last_status.
+ *
+ * \sa ps_picture_create, ps_picture_unref
+ */
+PEXPORT ps_picture* PICAPI ps_picture_ref(ps_picture* picture);
+
+/**
+ * \fn void ps_picture_unref(ps_picture* picture)
+ * \brief Decrements the reference count for the picture object.
+ *        If the reference count on the picture falls to 0, the picture is freed.
+ *
+ * \param picture  Pointer to an existing picture object.
+ *
+ * \sa ps_picture_create, ps_picture_ref
+ */
+PEXPORT void PICAPI ps_picture_unref(ps_picture* picture);
+
+/**
+ * \fn ps_context* ps_context_create_recording(ps_picture* picture, ps_context* shared_context)
+ * \brief Create a new context which records drawing commands into a picture.
+ *
+ * \param picture         Pointer to an existing picture object, the commands are appended to it.
+ * \param shared_context  A context to be shared resource with the new context,
+ *                          it can be NULL.
+ *
+ * \return If the function succeeds, the return value is the pointer to a new context object.
+ *         If the function fails, the return value is NULL.
+ *
+ * \note The context has no canvas, fill, stroke, paint, clear, clip and text functions
+ *       are recorded with the current state instead of drawing. Images, patterns, gradients
+ *       and canvases used as source are referenced by the picture, not copied. Text is
+ *       recorded as glyph outlines. To get extended error information, call \a ps_last_status.
+ *
+ * \sa ps_picture_create, ps_picture_playback, ps_context_unref
+ */
+PEXPORT ps_context* PICAPI ps_context_create_recording(ps_picture* picture, ps_context* shared_context);
+
+/**
+ * \fn ps_bool ps_picture_playback(ps_context* ctx, const ps_picture* picture, const ps_matrix* matrix)
+ * \brief Draw the commands recorded in a picture on the context.
+ *
+ * \param ctx      Pointer to an existing context object.
+ * \param picture  Pointer to an existing picture object.
+ * \param matrix   The matrix to transform the picture, it can be NULL.
+ *
+ * \return True if is success, otherwise False.
+ *
+ * \note The commands are drawn as they are issued on the context after \a ps_transform with the matrix,
+ *       the state of context is not changed. Clips recorded in the picture replace the clip of
+ *       context until the end of playback. To get extended error information, call \a ps_last_status.
+ *
+ * \sa ps_picture_create, ps_context_create_recording
+ */
+PEXPORT ps_bool PICAPI ps_picture_playback(ps_context* ctx, const ps_picture* picture, const ps_matrix* matrix);
+
+/** @} end of picture functions*/
+
+/**
+ * \defgroup prepared Prepared Path
+ * @{
+ */
+
+/**
+ * \fn ps_prepared_path* ps_prepared_path_create(const ps_context* ctx, const ps_path* path)
+ * \brief Create a prepared path which rasterizes the path once for repeated filling.
+ *
+ * \param ctx   Pointer to an existing context object, its current matrix, fill rule,
+ *                antialias and gamma are used to rasterize the path.
+ * \param path  Pointer to an existing path object.
+ *
+ * \return If the function succeeds, the return value is the pointer to a new prepared path object.
+ *         If the function fails, the return value is NULL.
+ *
+ * \note The path is copied, later changes of the path and context do not affect the prepared path.
+ *       To get extended error information, call \a ps_last_status.
+ *
+ * \sa ps_prepared_path_ref, ps_prepared_path_unref, ps_fill_prepared_path
+ */
+PEXPORT ps_prepared_path* PICAPI ps_prepared_path_create(const ps_context* ctx, const ps_path* path);
+
+/**
+ * \fn ps_prepared_path* ps_prepared_path_ref(ps_prepared_path* path)
+ * \brief Increases the reference count of the prepared path by 1.
+ *
+ * \param path  Pointer to an existing prepared path object.
+ *
+ * \return If the function succeeds, the return value is the pointer to the prepared path object.
+ *         If the function fails, the return value is NULL.
+ *
+ * \note To get extended error information, call \a ps_last_status.
+ *
+ * \sa ps_prepared_path_create, ps_prepared_path_unref
+ */
+PEXPORT ps_prepared_path* PICAPI ps_prepared_path_ref(ps_prepared_path* path);
+
+/**
+ * \fn void ps_prepared_path_unref(ps_prepared_path* path)
+ * \brief Decrements the reference count for the prepared path object.
+ *        If the reference count on the prepared path falls to 0, the prepared path is freed.
+ *
+ * \param path  Pointer to an existing prepared path object.
+ *
+ * \sa ps_prepared_path_create, ps_prepared_path_ref
+ */
+PEXPORT void PICAPI ps_prepared_path_unref(ps_prepared_path* path);
+
+/**
+ * \fn void ps_fill_prepared_path(ps_context* ctx, ps_prepared_path* path, const ps_point* offset)
+ * \brief Fill the prepared path moved by an offset with the current fill source of the context.
+ *
+ * \param ctx     Pointer to an existing context object.
+ * \param path    Pointer to an existing prepared path object.
+ * \param offset  The offset in device pixels, it is rounded to a quarter pixel.
+ *
+ * \note The result is the same as filling the path with the matrix it is prepared and then translated
+ *       by the offset. The current matrix and path of the context are not used and not changed, the
+ *       coverage of each quarter pixel phase is rasterized at first use and reused later. Shadow is not
+ *       drawn. To get extended error information, call \a ps_last_status.
+ *
+ * \sa ps_prepared_path_create, ps_fill
+ */
+PEXPORT void PICAPI ps_fill_prepared_path(ps_context* ctx, ps_prepared_path* path, const ps_point* offset);
+
+/** @} end of prepared path functions*/
 /** @} end of graphic functions*/
 
 #ifdef __cplusplus
@@ -85,6 +85,30 @@ PEXPORT ps_bool PICAPI ps_set_memory_functions(const ps_memory_funcs* funcs);
 
 /** @} end of memory */
 
+/**
+ * \defgroup threads Render Threads
+ * @{
+ */
+
+/**
+ * \fn ps_bool ps_set_render_threads(uint32_t threads)
+ * \brief Set number of threads used for rendering large shapes.
+ *
+ * When threads is more than one, the drawing device splits large fill and
+ * stroke into horizontal tiles and renders them in a thread pool, the calling
+ * thread is one of the threads. The result is same as rendering in one thread.
+ *
+ * \param threads Number of render threads, 0 or 1 renders in calling thread only.
+ * \return True on success, False on failure
+ *
+ * \note This function must be called before ps_initialize() and cannot
+ *       be called after the library has been initialized.
+ * \note It is not supported if picasso is built without multi threads.
+ */
+PEXPORT ps_bool PICAPI ps_set_render_threads(uint32_t threads);
+
+/** @} end of threads */
+
 /** @} end of backport */
 
 #ifdef __cplusplus
@@ -54,6 +54,13 @@ typedef struct _psx_svg psx_svg;
  */
 typedef struct _psx_svg_render psx_svg_render;
 
+/**
+ * \typedef psx_svg_loader
+ * \brief An opaque type represents an incremental svg document loader.
+ * \sa psx_svg
+ */
+typedef struct _psx_svg_loader psx_svg_loader;
+
 /** @} end of extsvg svgtypes */
 
 /**
@@ -82,6 +89,7 @@ PEXPORT void PICAPI psx_svg_shutdown(void);
 /**
  * \fn psx_svg* psx_svg_load(const char* file_name, psx_result* err_code)
  * \brief Create a new psx_svg object and load from file.
+ *        The file can be an svg document or a compiled one written by \a psx_svg_compile.
  *
  * \param file_name  The svg file path which will be loaded, which is encoded by utf8.
  * \param err_code   Pointer to a value to receiving the result code. can be NULL.
@@ -96,6 +104,7 @@ PEXPORT psx_svg* PICAPI psx_svg_load(const char* file_name, psx_result* err_code
 /**
  * \fn psx_svg* psx_svg_load_from_memory(const ps_byte* data, size_t length, psx_result* err_code)
  * \brief Create a new psx_svg object and load data from memory.
+ *        The data can be an svg document or a compiled one written by \a psx_svg_compile.
  *
  * \param data       Pointer to data buffer in memeory.
  * \param length     Data length bytes.
@@ -108,6 +117,77 @@ PEXPORT psx_svg* PICAPI psx_svg_load(const char* file_name, psx_result* err_code
  */
 PEXPORT psx_svg* PICAPI psx_svg_load_from_memory(const ps_byte* data, size_t length, psx_result* err_code);
 
+/**
+ * \brief Callback function for reading svg data, returns the bytes read into buffer, 0 at the end of data.
+ */
+typedef size_t (*svg_reader_fn)(void* param, ps_byte* buffer, size_t length);
+
+/**
+ * \fn psx_svg* psx_svg_load_from_stream(svg_reader_fn func, void* param, psx_result* err_code)
+ * \brief Create a new psx_svg object and load data from a reader, the data is parsed while reading.
+ *
+ * \param func       User define reading callback function.
+ * \param param      User define reading callback param.
+ * \param err_code   Pointer to a value to receiving the result code. can be NULL.
+ *
+ * \return If successs, the return value is the pointer to new psx_svg object.
+ *         If fails, the return value is NULL, and result will be return by \a err_code.
+ *
+ * \sa psx_svg_destroy psx_svg_load psx_svg_loader_create
+ */
+PEXPORT psx_svg* PICAPI psx_svg_load_from_stream(svg_reader_fn func, void* param, psx_result* err_code);
+
+/**
+ * \fn psx_svg_loader* psx_svg_loader_create(psx_result* err_code)
+ * \brief Create a new incremental loader, svg data is pushed in chunks and parsed as it arrives.
+ *
+ * \param err_code   Pointer to a value to receiving the result code. can be NULL.
+ *
+ * \return If successs, the return value is the pointer to new psx_svg_loader object.
+ *         If fails, the return value is NULL, and result will be return by \a err_code.
+ *
+ * \sa psx_svg_loader_push psx_svg_loader_finish psx_svg_loader_destroy
+ */
+PEXPORT psx_svg_loader* PICAPI psx_svg_loader_create(psx_result* err_code);
+
+/**
+ * \fn psx_result psx_svg_loader_push(psx_svg_loader* loader, const ps_byte* data, size_t length)
+ * \brief Push the next chunk of svg data to the loader, chunks can be split at any position.
+ *
+ * \param loader  Pointer to an existing psx_svg_loader object.
+ * \param data    Pointer to data buffer in memeory.
+ * \param length  Data length bytes.
+ *
+ * \return Result code returned.
+ *
+ * \sa psx_svg_loader_create psx_svg_loader_finish psx_svg_loader_destroy
+ */
+PEXPORT psx_result PICAPI psx_svg_loader_push(psx_svg_loader* loader, const ps_byte* data, size_t length);
+
+/**
+ * \fn psx_svg* psx_svg_loader_finish(psx_svg_loader* loader, psx_result* err_code)
+ * \brief End of svg data, create the psx_svg object parsed by the loader.
+ *
+ * \param loader     Pointer to an existing psx_svg_loader object.
+ * \param err_code   Pointer to a value to receiving the result code. can be NULL.
+ *
+ * \return If successs, the return value is the pointer to new psx_svg object.
+ *         If fails, the return value is NULL, and result will be return by \a err_code.
+ *
+ * \sa psx_svg_loader_create psx_svg_loader_push psx_svg_loader_destroy psx_svg_destroy
+ */
+PEXPORT psx_svg* PICAPI psx_svg_loader_finish(psx_svg_loader* loader, psx_result* err_code);
+
+/**
+ * \fn void psx_svg_loader_destroy(psx_svg_loader* loader)
+ * \brief Destroy the psx_svg_loader object and release resources.
+ *
+ * \param loader Pointer to an existing psx_svg_loader object.
+ *
+ * \sa psx_svg_loader_create psx_svg_loader_finish
+ */
+PEXPORT void PICAPI psx_svg_loader_destroy(psx_svg_loader* loader);
+
 /**
  * \fn void psx_svg_destroy(psx_svg* doc)
  * \brief Destroy the psx_svg object and release resources.
@@ -118,6 +198,40 @@ PEXPORT psx_svg* PICAPI psx_svg_load_from_memory(const ps_byte* data, size_t len
  */
 PEXPORT void PICAPI psx_svg_destroy(psx_svg* doc);
 
+/**
+ * \brief Callback function for writing compiled svg data.
+ */
+typedef int32_t (*svg_writer_fn)(void* param, const ps_byte* data, size_t length);
+
+/**
+ * \fn psx_result psx_svg_compile(const psx_svg* doc, svg_writer_fn func, void* param)
+ * \brief Write the parsed document as a compiled binary, which loads without parsing any text.
+ *
+ * \param doc    Pointer to an existing psx_svg object.
+ * \param func   User define writing callback function.
+ * \param param  User define writing callback param.
+ *
+ * \return Result code returned.
+ *
+ * \note The compiled data is only loaded by the same format version on machines with the same byte order.
+ *
+ * \sa psx_svg_compile_to_file psx_svg_load_from_memory
+ */
+PEXPORT psx_result PICAPI psx_svg_compile(const psx_svg* doc, svg_writer_fn func, void* param);
+
+/**
+ * \fn psx_result psx_svg_compile_to_file(const psx_svg* doc, const char* file_name)
+ * \brief Write the parsed document as a compiled binary to a file.
+ *
+ * \param doc        Pointer to an existing psx_svg object.
+ * \param file_name  The file path which will be output, which is encoded by utf8.
+ *
+ * \return Result code returned.
+ *
+ * \sa psx_svg_compile psx_svg_load
+ */
+PEXPORT psx_result PICAPI psx_svg_compile_to_file(const psx_svg* doc, const char* file_name);
+
 /**
  * \fn psx_svg_render* psx_svg_render_create(psx_svg* doc, psx_result* err_code)
  * \brief Create a new psx_svg_render from a psx_svg object.
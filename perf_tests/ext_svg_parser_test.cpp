@@ -110,3 +110,117 @@ PERF_TEST_RUN(SvgParser, CreateRenderList)
     CompareToBenchmark(SvgParser_CreateRenderList, result);
     psx_svg_node_destroy(root);
 }
+
+// Icon style sample, many small elements carrying many short attributes
+static const char* attribute_heavy_svg =
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.2\" baseProfile=\"tiny\" "
+    "width=\"24\" height=\"24\" viewBox=\"0 0 24 24\" fill=\"none\" stroke=\"black\">"
+    "<g id=\"icon\" opacity=\"1\" display=\"inline\" visibility=\"visible\" fill-rule=\"evenodd\">"
+    "<rect x=\"3\" y=\"3\" width=\"18\" height=\"18\" rx=\"2\" ry=\"2\" fill=\"none\" fill-opacity=\"1\" "
+    "stroke=\"black\" stroke-width=\"2\" stroke-linecap=\"round\" stroke-linejoin=\"round\" "
+    "stroke-miterlimit=\"4\" stroke-opacity=\"1\"/>"
+    "<circle cx=\"8.5\" cy=\"8.5\" r=\"1.5\" fill=\"black\" fill-opacity=\"1\" stroke=\"none\" "
+    "stroke-width=\"2\" stroke-linecap=\"round\" stroke-linejoin=\"round\" opacity=\"1\"/>"
+    "<line x1=\"4\" y1=\"20\" x2=\"20\" y2=\"4\" stroke=\"black\" stroke-width=\"2\" "
+    "stroke-linecap=\"round\" stroke-linejoin=\"round\" stroke-dashoffset=\"0\" stroke-opacity=\"1\"/>"
+    "<ellipse cx=\"12\" cy=\"12\" rx=\"4\" ry=\"3\" fill=\"none\" stroke=\"black\" stroke-width=\"1\" "
+    "stroke-linecap=\"butt\" stroke-linejoin=\"miter\" stroke-miterlimit=\"4\" opacity=\"0.5\"/>"
+    "<polyline points=\"21,15 16,10 5,21\" fill=\"none\" stroke=\"black\" stroke-width=\"2\" "
+    "stroke-linecap=\"round\" stroke-linejoin=\"round\" stroke-opacity=\"1\" visibility=\"visible\"/>"
+    "</g>"
+    "</svg>";
+
+// Test 3: Tag and attribute name resolution on attribute heavy documents
+PERF_TEST_RUN(SvgParser, LoadAttributeHeavySvg)
+{
+    auto result = RunBenchmark(SvgParser_LoadAttributeHeavySvg, [&]() {
+        for (int i = 0; i < 5000; i++) {
+            psx_svg_node* root = psx_svg_load_data(attribute_heavy_svg, (uint32_t)strlen(attribute_heavy_svg));
+            if (root) {
+                psx_svg_node_destroy(root);
+            }
+        }
+    });
+
+    CompareToBenchmark(SvgParser_LoadAttributeHeavySvg, result);
+}
+
+// Number heavy sample, long path data and point lists
+static const char* number_heavy_svg =
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"512\" height=\"512\" viewBox=\"0 0 512 512\">"
+    "<path d=\"M256.000,48.125C141.125,48.125,48.125,141.125,48.125,256.000S141.125,463.875,256.000,463.875"
+    "S463.875,370.875,463.875,256.000S370.875,48.125,256.000,48.125ZM256.000,421.438c-91.375,0-165.438-74.063"
+    "-165.438-165.438S164.625,90.563,256.000,90.563s165.438,74.063,165.438,165.438S347.375,421.438,256.000,421.438z"
+    "M330.688,181.313l-98.625,98.625l-50.750-50.750c-8.188-8.188-21.438-8.188-29.625,0c-8.188,8.188-8.188,21.438,0,29.625"
+    "l65.563,65.563c4.094,4.094,9.469,6.125,14.813,6.125s10.719-2.031,14.813-6.125l113.438-113.438"
+    "c8.188-8.188,8.188-21.438,0-29.625C352.125,173.125,338.875,173.125,330.688,181.313z\"/>"
+    "<polygon points=\"12.5,3.25 45.125,18.75 78.875,2.5 101.25,33.125 134.5,12.875 166.625,40.25 "
+    "190.375,8.5 221.75,36.625 250.125,4.875 280.5,29.375 311.875,11.25 345.125,38.5 372.25,6.75\"/>"
+    "<rect x=\"1.5e1\" y=\"2.25e1\" width=\"4.8e2\" height=\"4.65e2\" rx=\"1.2e1\" ry=\"1.2e1\" "
+    "transform=\"matrix(0.9659258,0.2588190,-0.2588190,0.9659258,74.9807621,-57.5353898)\"/>"
+    "</svg>";
+
+// Test 4: Number scanning of path data, points and transforms
+PERF_TEST_RUN(SvgParser, LoadNumberHeavySvg)
+{
+    auto result = RunBenchmark(SvgParser_LoadNumberHeavySvg, [&]() {
+        for (int i = 0; i < 2000; i++) {
+            psx_svg_node* root = psx_svg_load_data(number_heavy_svg, (uint32_t)strlen(number_heavy_svg));
+            if (root) {
+                psx_svg_node_destroy(root);
+            }
+        }
+    });
+
+    CompareToBenchmark(SvgParser_LoadNumberHeavySvg, result);
+}
+
+// Test 5: Incremental loading of the complex sample pushed in small chunks
+PERF_TEST_RUN(SvgParser, LoadComplexSvgChunked)
+{
+    uint32_t len = (uint32_t)strlen(complex_svg_tiny_12);
+
+    auto result = RunBenchmark(SvgParser_LoadComplexSvgChunked, [&]() {
+        for (int i = 0; i < 2000; i++) {
+            psx_svg_stream* stream = psx_svg_stream_create();
+            for (uint32_t pos = 0; pos < len; pos += 256) {
+                psx_svg_stream_push(stream, complex_svg_tiny_12 + pos, (len - pos) < 256 ? (len - pos) : 256);
+            }
+            psx_svg_node* root = psx_svg_stream_finish(stream);
+            if (root) {
+                psx_svg_node_destroy(root);
+            }
+            psx_svg_stream_destroy(stream);
+        }
+    });
+
+    CompareToBenchmark(SvgParser_LoadComplexSvgChunked, result);
+}
+
+static bool _append_binary(void* param, const uint8_t* data, uint32_t len)
+{
+    ((std::string*)param)->append((const char*)data, len);
+    return true;
+}
+
+// Test 6: Loading the complex sample from its compiled binary form
+PERF_TEST_RUN(SvgParser, LoadCompiledComplexSvg)
+{
+    psx_svg_node* doc = psx_svg_load_data(complex_svg_tiny_12, (uint32_t)strlen(complex_svg_tiny_12));
+    ASSERT_NE(doc, nullptr);
+
+    std::string bin;
+    ASSERT_TRUE(psx_svg_save_binary(doc, _append_binary, &bin));
+    psx_svg_node_destroy(doc);
+
+    auto result = RunBenchmark(SvgParser_LoadCompiledComplexSvg, [&]() {
+        for (int i = 0; i < 2000; i++) {
+            psx_svg_node* root = psx_svg_load_binary((const uint8_t*)bin.data(), (uint32_t)bin.size());
+            if (root) {
+                psx_svg_node_destroy(root);
+            }
+        }
+    });
+
+    CompareToBenchmark(SvgParser_LoadCompiledComplexSvg, result);
+}
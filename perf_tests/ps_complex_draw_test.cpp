@@ -479,3 +479,75 @@ PERF_TEST_RUN(Complex, ShapesWithStateManagement)
     }
     ps_context_unref(ctx);
 }
+
+PERF_TEST_RUN(Complex, DensePathFill)
+{
+    ps_context* ctx = ps_context_create(get_test_canvas(), NULL);
+
+    // create a self-intersecting path with 2000 vertices across the canvas
+    ps_path* path = ps_path_create();
+    unsigned int seed = 12345;
+    for (int i = 0; i < 2000; i++) {
+        seed = seed * 1103515245 + 12345;
+        float x = (float)((seed >> 16) % TEST_WIDTH);
+        seed = seed * 1103515245 + 12345;
+        float y = (float)((seed >> 16) % TEST_HEIGHT);
+        ps_point pt = {x, y};
+        if (i == 0) {
+            ps_path_move_to(path, &pt);
+        } else {
+            ps_path_line_to(path, &pt);
+        }
+    }
+    ps_path_sub_close(path);
+
+    ps_color fill_color = {0.2f, 0.4f, 0.8f, 1.0f};
+    ps_set_source_color(ctx, &fill_color);
+    ps_set_fill_rule(ctx, FILL_RULE_EVEN_ODD);
+
+    auto result = RunBenchmark(Complex_DensePathFill, [&]() {
+        ps_set_path(ctx, path);
+        ps_fill(ctx);
+    }, 10);
+
+    CompareToBenchmark(Complex_DensePathFill, result);
+
+    ps_path_unref(path);
+    ps_context_unref(ctx);
+}
+
+PERF_TEST_RUN(Complex, CurvePathStroke)
+{
+    ps_context* ctx = ps_context_create(get_test_canvas(), NULL);
+
+    // a wavy path of 200 cubic curves stroked with round joins
+    ps_path* path = ps_path_create();
+    ps_point start = {10, 240};
+    ps_path_move_to(path, &start);
+    for (int i = 0; i < 200; i++) {
+        float x = 10 + i * 3.0f;
+        ps_point fcp = {x + 1.0f, (i % 2) ? 40.0f : 440.0f};
+        ps_point scp = {x + 2.0f, (i % 2) ? 440.0f : 40.0f};
+        ps_point ep = {x + 3.0f, 240.0f};
+        ps_path_bezier_to(path, &fcp, &scp, &ep);
+    }
+
+    ps_color stroke_color = {0.8f, 0.2f, 0.2f, 1.0f};
+    ps_set_stroke_color(ctx, &stroke_color);
+    ps_set_line_width(ctx, 3.0f);
+    ps_set_line_join(ctx, LINE_JOIN_ROUND);
+    ps_set_line_cap(ctx, LINE_CAP_ROUND);
+
+    int frame = 0;
+    auto result = RunBenchmark(Complex_CurvePathStroke, [&]() {
+        ps_identity(ctx);
+        ps_translate(ctx, (float)(frame++ % 10), 0);
+        ps_set_path(ctx, path);
+        ps_stroke(ctx);
+    }, 10);
+
+    CompareToBenchmark(Complex_CurvePathStroke, result);
+
+    ps_path_unref(path);
+    ps_context_unref(ctx);
+}
@@ -365,6 +365,9 @@ public:
     void clear(void) { m_size = 0; }
     void remove_last(void) { if (m_size) --m_size; }
     void cut_at(uint32_t size) { if (size < m_size) m_size = size; }
+
+    // allocate elements in one block, return index of the first one or -1.
+    int32_t allocate_continuous_block(uint32_t num_elements);
 private:
     void allocate_block(uint32_t num_block);
 
@@ -474,6 +477,27 @@ inline void pod_bvector<T, S>::allocate_block(uint32_t nb)
     m_num_blocks++;
 }
 
+template <typename T, uint32_t S>
+inline int32_t pod_bvector<T, S>::allocate_continuous_block(uint32_t num_elements)
+{
+    if (num_elements < block_size) {
+        uint32_t rest = block_size - (m_size & block_mask);
+        if (num_elements > rest) { // go to next block
+            m_size += rest;
+        }
+
+        uint32_t nb = m_size >> block_shift;
+        if (nb >= m_num_blocks) {
+            allocate_block(nb);
+        }
+
+        uint32_t index = m_size;
+        m_size += num_elements;
+        return (int32_t)index;
+    }
+    return -1;
+}
+
 template <typename T, uint32_t S>
 inline void pod_bvector<T, S>::modify_last(const T& v)
 {
@@ -515,10 +539,8 @@ public:
         , m_blocks(0)
         , m_buf_ptr(0)
         , m_remain_size(0)
+        , m_all_mem(0)
     {
-#if _DEBUG
-        m_all_mem = 0;
-#endif
     }
 
     ~block_allocator()
@@ -574,14 +596,10 @@ public:
         m_blocks = 0;
         m_buf_ptr = 0;
         m_remain_size = 0;
-#if _DEBUG
         m_all_mem = 0;
-#endif
     }
 
-#if _DEBUG
     uint32_t all_mem_used(void) const { return m_all_mem;}
-#endif
 
 private:
     block_allocator(const block_allocator&);
@@ -596,9 +614,7 @@ private:
         if (m_num_blocks >= m_max_blocks) {
             block_type* new_blocks = pod_allocator<block_type>::allocate(m_max_blocks + m_block_ptr_inc);
 
-#if _DEBUG
             m_all_mem += sizeof(block_type) * (m_block_ptr_inc);
-#endif
 
             if (m_blocks) {
                 mem_copy(new_blocks, m_blocks, m_num_blocks * sizeof(block_type));
@@ -615,9 +631,7 @@ private:
         m_num_blocks++;
         m_remain_size = size;
 
-#if _DEBUG
         m_all_mem += m_remain_size;
-#endif
     }
 
     uint32_t m_block_size;
@@ -627,9 +641,7 @@ private:
     block_type* m_blocks;
     byte* m_buf_ptr;
     uint32_t m_remain_size;
-#if _DEBUG
     uint32_t m_all_mem;
-#endif
 };
 
 //------------------------------------------------------------------------
@@ -52,6 +52,7 @@ protected:
 
 bool _init_system_device(void);
 void _destroy_system_device(void);
+void _set_system_device_threads(uint32_t threads);
 
 bool is_valid_system_device(void);
 device* get_system_device(void);
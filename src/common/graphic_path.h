@@ -15,6 +15,7 @@
 namespace picasso {
 
 class trans_affine;
+class path_cache;
 
 class graphic_path : public vertex_container
 {
@@ -26,6 +27,12 @@ public:
         shape_rounded_rect = 3,
     } shape_type;
 
+    typedef enum {
+        path_complex = 0, // many contours or not known to be convex.
+        path_convex = 1, // single convex contour, closed implicitly.
+        path_rect = 2, // single axis aligned rectangle.
+    } path_class;
+
     graphic_path();
     graphic_path(const graphic_path& o);
 
@@ -117,10 +124,46 @@ public:
     void set_shape(shape_type s) { m_shape = s; }
     shape_type get_shape(void) const { return (shape_type)m_shape; }
 
+    // metadata maintained as vertices are added, query in constant time.
+    // bounds include control points of curves, return false if no vertex.
+    bool bounds(rect_s* rc) const;
+    uint32_t sub_paths(void) const { return m_info.subpaths; }
+    path_class get_class(void) const;
+
     // serialize
     void serialize_to(byte* buffer);
     void serialize_from(uint32_t num, byte* buffer, uint32_t buf_len);
+
+    // cache of the computed geometry, shared by the copies and dropped by any change.
+    path_cache* cache(void) const { return m_cache; }
+    path_cache* attach_cache(void) const;
 private:
+    void detach_cache(void) { if (m_cache) { release_cache(); } }
+    void release_cache(void);
+
+    // convexity of the first contour is tested with its turns and direction changes.
+    struct path_info {
+        rect_s bounds;
+        uint32_t subpaths;
+        bool convex;
+        bool aligned;
+        bool curves;
+        bool has_edge;
+        scalar fx, fy; // first vertex
+        scalar lx, ly; // last vertex
+        scalar fdx, fdy; // first edge
+        scalar ldx, ldy; // last edge
+        int32_t turn;
+        int32_t fsx, fsy; // first direction of edges
+        int32_t lsx, lsy; // last direction of edges
+        uint32_t flips_x, flips_y;
+    };
+
+    void reset_info(void);
+    void rebuild_info(void);
+    void update_info(scalar x, scalar y, uint32_t cmd, uint32_t prev_cmd);
+    void update_contour(scalar x, scalar y, uint32_t cmd);
+
     uint32_t perceive_polygon_orientation(uint32_t start, uint32_t end);
     void invert_polygon(uint32_t start, uint32_t end);
 
@@ -144,6 +187,8 @@ private:
     pod_vector<uint32_t> m_cmds;
     uint32_t m_iterator;
     uint32_t m_shape;
+    path_info m_info;
+    mutable path_cache* m_cache;
 };
 
 inline bool operator != (const graphic_path& a, const graphic_path& b)
@@ -16,6 +16,8 @@
 
 namespace picasso {
 
+class path_cache;
+
 // Rendering buffer interface
 class abstract_rendering_buffer
 {
@@ -58,10 +60,22 @@ public:
     virtual void set_fill_attr(int32_t idx, int32_t val) = 0;
 
     virtual void add_shape(const vertex_source& vs, uint32_t id) = 0;
+    // geometry cache of the shape, the stroked outline will be reused from it.
+    virtual void set_shape_cache(path_cache* cache) = 0;
     virtual void reset(void) = 0;
     virtual void commit(void) = 0;
     virtual bool is_empty(void) = 0;
     virtual bool contains(scalar x, scalar y) = 0;
+
+    // serialized coverage of the committed fill raster.
+    virtual uint32_t coverage_size(void) = 0;
+    virtual void serialize_coverage(byte* data) = 0;
+
+    // serialized cells of the committed fill raster, they can be added to
+    // the fill raster of another adapter at a pixel offset.
+    virtual uint32_t cells_size(void) = 0;
+    virtual void serialize_cells(byte* data) = 0;
+    virtual void add_cells(const byte* data, uint32_t size, int32_t x, int32_t y) = 0;
 protected:
     abstract_raster_adapter() {}
 };
@@ -134,6 +148,9 @@ public:
     // FIXME: own mono storage implements needed!
     virtual void apply_mono_text_fill(void* storage) = 0;
 
+    // fill serialized coverage at pixel offset, mtx maps the fill source as the shape is transformed.
+    virtual void apply_fill_coverage(const byte* data, uint32_t size, int32_t x, int32_t y, const trans_affine& mtx) = 0;
+
     // clear
     virtual void apply_clear(const rgba& c) = 0;
 
@@ -145,12 +162,18 @@ public:
     virtual void apply_clip_device(const rect_s& rc, scalar xoffset, scalar yoffset) = 0;
     virtual void clear_clip(void) = 0;
 
+    // device bounds of the next drawing, return false if it is all out of the clip area.
+    // spans are not clipped until end_bounds if the bounds is inside the clip area.
+    virtual bool begin_bounds(const rect_s& rc) = 0;
+    virtual void end_bounds(void) = 0;
+
     // masking
     virtual void apply_masking(abstract_mask_layer*) = 0;
     virtual void clear_masking(void) = 0;
 
     // shadow
-    virtual bool begin_shadow(const rect_s& rc) = 0;
+    // return false if the layer is not created or it is out of target at the offset.
+    virtual bool begin_shadow(const rect_s& rc, scalar x, scalar y) = 0;
     virtual void apply_shadow(abstract_raster_adapter* rs, const rect_s& r,
                               const rgba& c, scalar x, scalar y, scalar b) = 0;
 
@@ -0,0 +1,113 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#ifndef _PATH_CACHE_H_
+#define _PATH_CACHE_H_
+
+#include "common.h"
+#include "vertex.h"
+#include "graphic_base.h"
+#include "graphic_path.h"
+#include "thread_sync.h"
+
+namespace picasso {
+
+#if ENABLE(LOW_MEMORY)
+#define MAX_STROKE_OUTLINES 2
+#else
+#define MAX_STROKE_OUTLINES 4
+#endif
+
+// stroke parameters which decide the outline of a path.
+struct stroke_params {
+    scalar width;
+    scalar miter_limit;
+    line_cap cap;
+    line_join join;
+    inner_join inner;
+    bool dashed;
+    scalar dash_start;
+    const scalar* dashes;
+    uint32_t num_dashes;
+};
+
+// stroked outline of a path, it is not changed after created.
+class stroke_outline : public non_copyable
+{
+public:
+    static stroke_outline* create(const stroke_params& params);
+
+    void ref(void) { atomic_inc(&m_refcount); }
+    void unref(void);
+
+    bool match(const stroke_params& params) const;
+
+    graphic_path& path(void) { return m_path; }
+    const graphic_path& path(void) const { return m_path; }
+private:
+    stroke_outline();
+    ~stroke_outline();
+
+    int32_t m_refcount;
+    stroke_params m_params;
+    scalar* m_dashes;
+    graphic_path m_path;
+};
+
+// vertex source reading an outline without touching its iterator,
+// the outline can be rasterized by many threads at the same time.
+class stroke_outline_source : public vertex_source
+{
+public:
+    stroke_outline_source(const stroke_outline* o)
+        : m_path(o->path())
+        , m_index(0)
+    {
+    }
+
+    virtual void rewind(uint32_t id)
+    {
+        m_index = id;
+    }
+
+    virtual uint32_t vertex(scalar* x, scalar* y)
+    {
+        if (m_index >= m_path.total_vertices()) {
+            return path_cmd_stop;
+        }
+        return m_path.vertex(m_index++, x, y);
+    }
+private:
+    const graphic_path& m_path;
+    uint32_t m_index;
+};
+
+// cache of the geometry computed from a path, shared by the copies of the path.
+// it is dropped by any change of the path vertices.
+class path_cache : public non_copyable
+{
+public:
+    path_cache();
+
+    void ref(void) { atomic_inc(&m_refcount); }
+    void unref(void);
+
+    // return a referenced outline or NULL, caller need unref it.
+    stroke_outline* find_outline(const stroke_params& params);
+    void add_outline(stroke_outline* outline);
+
+    uint32_t num_outlines(void) const { return m_num; }
+private:
+    ~path_cache();
+
+    int32_t m_refcount;
+    thread_mutex m_lock;
+    uint32_t m_num;
+    stroke_outline* m_outlines[MAX_STROKE_OUTLINES]; // most recently used first.
+};
+
+}
+#endif /*_PATH_CACHE_H_*/
@@ -69,7 +69,7 @@
     #define CPU_ARM64 1
 #endif
 
-#if defined(__ARM_NEON__)
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
     #define CPU_ARM_NEON 1
 #endif
 
@@ -0,0 +1,159 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#ifndef _THREAD_SYNC_H_
+#define _THREAD_SYNC_H_
+
+#include "common.h"
+#include "non_copy.h"
+
+#if ENABLE(MULTI_THREADS)
+#if defined(WIN32)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+#endif
+#endif
+
+// thread local storage, objects of different threads do not share the data.
+#if ENABLE(MULTI_THREADS)
+    #if COMPILER(MSVC)
+        #define THREAD_LOCAL __declspec(thread)
+    #else
+        #define THREAD_LOCAL __thread
+    #endif
+#else
+    #define THREAD_LOCAL
+#endif
+
+namespace picasso {
+
+#if ENABLE(MULTI_THREADS)
+#if defined(WIN32)
+typedef HANDLE thread_type;
+typedef CRITICAL_SECTION mutex_type;
+typedef CONDITION_VARIABLE cond_type;
+
+static inline void mutex_init(mutex_type* m) { InitializeCriticalSection(m); }
+static inline void mutex_destroy(mutex_type* m) { DeleteCriticalSection(m); }
+static inline void mutex_lock(mutex_type* m) { EnterCriticalSection(m); }
+static inline void mutex_unlock(mutex_type* m) { LeaveCriticalSection(m); }
+
+static inline void cond_init(cond_type* c) { InitializeConditionVariable(c); }
+static inline void cond_destroy(cond_type*) { }
+static inline void cond_wait(cond_type* c, mutex_type* m) { SleepConditionVariableCS(c, m, INFINITE); }
+static inline void cond_signal(cond_type* c) { WakeConditionVariable(c); }
+static inline void cond_broadcast(cond_type* c) { WakeAllConditionVariable(c); }
+
+static inline uint32_t atomic_fetch_inc(volatile uint32_t* v)
+{
+    return (uint32_t)InterlockedIncrement((volatile LONG*)v) - 1;
+}
+
+static inline int32_t atomic_inc(int32_t* v)
+{
+    return (int32_t)InterlockedIncrement((volatile LONG*)v);
+}
+
+static inline int32_t atomic_dec(int32_t* v)
+{
+    return (int32_t)InterlockedDecrement((volatile LONG*)v);
+}
+
+static inline bool atomic_cas_ptr(void* volatile* p, void* o, void* n)
+{
+    return InterlockedCompareExchangePointer(p, n, o) == o;
+}
+#else
+typedef pthread_t thread_type;
+typedef pthread_mutex_t mutex_type;
+typedef pthread_cond_t cond_type;
+
+static inline void mutex_init(mutex_type* m) { pthread_mutex_init(m, NULL); }
+static inline void mutex_destroy(mutex_type* m) { pthread_mutex_destroy(m); }
+static inline void mutex_lock(mutex_type* m) { pthread_mutex_lock(m); }
+static inline void mutex_unlock(mutex_type* m) { pthread_mutex_unlock(m); }
+
+static inline void cond_init(cond_type* c) { pthread_cond_init(c, NULL); }
+static inline void cond_destroy(cond_type* c) { pthread_cond_destroy(c); }
+static inline void cond_wait(cond_type* c, mutex_type* m) { pthread_cond_wait(c, m); }
+static inline void cond_signal(cond_type* c) { pthread_cond_signal(c); }
+static inline void cond_broadcast(cond_type* c) { pthread_cond_broadcast(c); }
+
+static inline uint32_t atomic_fetch_inc(volatile uint32_t* v)
+{
+    return __sync_fetch_and_add(v, 1);
+}
+
+static inline int32_t atomic_inc(int32_t* v)
+{
+    return __sync_add_and_fetch(v, 1);
+}
+
+static inline int32_t atomic_dec(int32_t* v)
+{
+    return __sync_sub_and_fetch(v, 1);
+}
+
+static inline bool atomic_cas_ptr(void* volatile* p, void* o, void* n)
+{
+    return __sync_bool_compare_and_swap(p, o, n);
+}
+#endif
+
+// mutex for the data shared by threads.
+class thread_mutex : public non_copyable
+{
+public:
+    thread_mutex() { mutex_init(&m_mutex); }
+    ~thread_mutex() { mutex_destroy(&m_mutex); }
+
+    void lock(void) { mutex_lock(&m_mutex); }
+    void unlock(void) { mutex_unlock(&m_mutex); }
+private:
+    mutex_type m_mutex;
+};
+#else
+static inline int32_t atomic_inc(int32_t* v) { return ++(*v); }
+static inline int32_t atomic_dec(int32_t* v) { return --(*v); }
+
+static inline bool atomic_cas_ptr(void* volatile* p, void* o, void* n)
+{
+    if (*p == o) {
+        *p = n;
+        return true;
+    }
+    return false;
+}
+
+class thread_mutex : public non_copyable
+{
+public:
+    void lock(void) { }
+    void unlock(void) { }
+};
+#endif
+
+// lock the mutex in the scope.
+class scoped_lock : public non_copyable
+{
+public:
+    scoped_lock(thread_mutex& m)
+        : m_mutex(m)
+    {
+        m_mutex.lock();
+    }
+
+    ~scoped_lock()
+    {
+        m_mutex.unlock();
+    }
+private:
+    thread_mutex& m_mutex;
+};
+
+}
+#endif /*_THREAD_SYNC_H_*/
@@ -13,15 +13,21 @@
 namespace picasso {
 
 static device* _global_device = NULL;
+static uint32_t _global_device_threads = 0;
 
 bool _init_system_device(void)
 {
     if (!_global_device) {
-        _global_device = gfx::gfx_device::create();
+        _global_device = gfx::gfx_device::create(_global_device_threads);
     }
     return _global_device != NULL;
 }
 
+void _set_system_device_threads(uint32_t threads)
+{
+    _global_device_threads = threads;
+}
+
 void _destroy_system_device(void)
 {
     if (_global_device) {
@@ -10,6 +10,7 @@
 #include "matrix.h"
 #include "graphic_base.h"
 #include "graphic_path.h"
+#include "path_cache.h"
 
 namespace picasso {
 
@@ -21,11 +22,14 @@ graphic_path::graphic_path()
     , m_cmds(DEFAULT_VERTEICES)
     , m_iterator(0)
     , m_shape(shape_polygon)
+    , m_cache(0)
 {
+    reset_info();
 }
 
 graphic_path::~graphic_path()
 {
+    detach_cache();
 }
 
 graphic_path::graphic_path(const graphic_path& o)
@@ -34,6 +38,11 @@ graphic_path::graphic_path(const graphic_path& o)
     m_cmds = o.m_cmds;
     m_iterator = o.m_iterator;
     m_shape = o.m_shape;
+    m_info = o.m_info;
+    m_cache = o.m_cache;
+    if (m_cache) {
+        m_cache->ref();
+    }
 }
 
 graphic_path& graphic_path::operator=(const graphic_path& o)
@@ -46,10 +55,34 @@ graphic_path& graphic_path::operator=(const graphic_path& o)
     m_cmds = o.m_cmds;
     m_iterator = o.m_iterator;
     m_shape = o.m_shape;
+    m_info = o.m_info;
+
+    if (o.m_cache) {
+        o.m_cache->ref();
+    }
+    detach_cache();
+    m_cache = o.m_cache;
 
     return *this;
 }
 
+path_cache* graphic_path::attach_cache(void) const
+{
+    if (!m_cache) {
+        path_cache* c = new path_cache;
+        if (c && !atomic_cas_ptr((void* volatile*)&m_cache, 0, c)) {
+            c->unref(); // attached by other thread.
+        }
+    }
+    return m_cache;
+}
+
+void graphic_path::release_cache(void)
+{
+    m_cache->unref();
+    m_cache = 0;
+}
+
 void graphic_path::remove_all(void)
 {
     remove_all_impl();
@@ -309,16 +342,19 @@ uint32_t graphic_path::command(uint32_t idx) const
 void graphic_path::modify_vertex(uint32_t idx, scalar x, scalar y)
 {
     modify_vertex_impl(idx, x, y);
+    rebuild_info();
 }
 
 void graphic_path::modify_vertex(uint32_t idx, scalar x, scalar y, uint32_t cmd)
 {
     modify_vertex_impl(idx, x, y, cmd);
+    rebuild_info();
 }
 
 void graphic_path::modify_command(uint32_t idx, uint32_t cmd)
 {
     modify_command_impl(idx, cmd);
+    rebuild_info();
 }
 
 void graphic_path::rewind(uint32_t id)
@@ -368,6 +404,7 @@ uint32_t graphic_path::arrange_polygon_orientation(uint32_t start, uint32_t flag
                    is_end_poly(cmd = command_impl(end))) {
                 modify_command_impl(end++, set_orientation(cmd, flag_orientation));
             }
+            rebuild_info();
         }
     }
     return end;
@@ -451,6 +488,7 @@ void graphic_path::invert_polygon(uint32_t start)
            !is_next_poly(command_impl(end))) { ++end; }
 
     invert_polygon(start, end);
+    rebuild_info();
 }
 
 void graphic_path::flip_x(scalar x1, scalar x2)
@@ -462,6 +500,7 @@ void graphic_path::flip_x(scalar x1, scalar x2)
             modify_vertex_impl(i, x2 - x + x1, y);
         }
     }
+    rebuild_info();
 }
 
 void graphic_path::flip_y(scalar y1, scalar y2)
@@ -473,6 +512,7 @@ void graphic_path::flip_y(scalar y1, scalar y2)
             modify_vertex_impl(i, x, y2 - y + y1);
         }
     }
+    rebuild_info();
 }
 
 void graphic_path::translate(scalar dx, scalar dy, uint32_t id)
@@ -491,6 +531,7 @@ void graphic_path::translate(scalar dx, scalar dy, uint32_t id)
             modify_vertex_impl(path_id, x, y);
         }
     }
+    rebuild_info();
 }
 
 void graphic_path::translate_all_paths(scalar dx, scalar dy)
@@ -505,6 +546,7 @@ void graphic_path::translate_all_paths(scalar dx, scalar dy)
             modify_vertex_impl(idx, x, y);
         }
     }
+    rebuild_info();
 }
 
 void graphic_path::transform(const trans_affine& trans, uint32_t id)
@@ -522,6 +564,7 @@ void graphic_path::transform(const trans_affine& trans, uint32_t id)
             modify_vertex_impl(path_id, x, y);
         }
     }
+    rebuild_info();
 }
 
 void graphic_path::transform_all_paths(const trans_affine& trans)
@@ -535,6 +578,7 @@ void graphic_path::transform_all_paths(const trans_affine& trans)
             modify_vertex_impl(idx, x, y);
         }
     }
+    rebuild_info();
 }
 
 void graphic_path::join_path(vertex_source& vs, uint32_t id)
@@ -599,16 +643,197 @@ void graphic_path::serialize_from(uint32_t num, byte* buffer, uint32_t buf_len)
     buffer += num * sizeof(vertex_s);
     m_cmds.resize(num);
     m_cmds.set_data(num, (uint32_t*)buffer);
+    rebuild_info();
+}
+
+bool graphic_path::bounds(rect_s* rc) const
+{
+    *rc = m_info.bounds;
+    return (rc->x1 <= rc->x2) && (rc->y1 <= rc->y2);
+}
+
+static inline int32_t _sign(scalar v)
+{
+    return (v > FLT_TO_SCALAR(0.0f)) ? 1 : ((v < FLT_TO_SCALAR(0.0f)) ? -1 : 0);
+}
+
+static inline void _add_turn(int32_t* turn, bool* convex, scalar ax, scalar ay, scalar bx, scalar by)
+{
+    int32_t s = _sign(ax * by - ay * bx);
+    if (s) {
+        if (!*turn) {
+            *turn = s;
+        } else if (*turn != s) {
+            *convex = false;
+        }
+    }
+}
+
+static inline void _add_direction(int32_t* first, int32_t* last, uint32_t* flips, scalar d)
+{
+    int32_t s = _sign(d);
+    if (s) {
+        if (!*first) {
+            *first = s;
+        } else if (*last != s) {
+            (*flips)++;
+        }
+        *last = s;
+    }
+}
+
+graphic_path::path_class graphic_path::get_class(void) const
+{
+    if ((m_info.subpaths != 1) || !m_info.convex) {
+        return path_complex;
+    }
+
+    // close the contour with the edge back to first vertex.
+    int32_t turn = m_info.turn;
+    bool convex = true;
+    bool aligned = m_info.aligned;
+    int32_t lsx = m_info.lsx, lsy = m_info.lsy;
+    uint32_t flips_x = m_info.flips_x, flips_y = m_info.flips_y;
+    int32_t fsx = m_info.fsx, fsy = m_info.fsy;
+    scalar ldx = m_info.ldx, ldy = m_info.ldy;
+
+    if (m_info.has_edge) {
+        scalar dx = m_info.fx - m_info.lx;
+        scalar dy = m_info.fy - m_info.ly;
+        if ((dx != FLT_TO_SCALAR(0.0f)) || (dy != FLT_TO_SCALAR(0.0f))) {
+            if ((dx != FLT_TO_SCALAR(0.0f)) && (dy != FLT_TO_SCALAR(0.0f))) {
+                aligned = false;
+            }
+            _add_turn(&turn, &convex, ldx, ldy, dx, dy);
+            _add_direction(&fsx, &lsx, &flips_x, dx);
+            _add_direction(&fsy, &lsy, &flips_y, dy);
+            ldx = dx;
+            ldy = dy;
+        }
+        _add_turn(&turn, &convex, ldx, ldy, m_info.fdx, m_info.fdy);
+
+        // direction changes from last edge to first edge.
+        if (lsx != fsx) { flips_x++; }
+        if (lsy != fsy) { flips_y++; }
+    }
+
+    if (!convex || (flips_x > 2) || (flips_y > 2)) {
+        return path_complex;
+    }
+
+    return (aligned && !m_info.curves) ? path_rect : path_convex;
+}
+
+void graphic_path::reset_info(void)
+{
+    m_info.bounds = rect_s(1, 1, 0, 0);
+    m_info.subpaths = 0;
+    m_info.convex = true;
+    m_info.aligned = true;
+    m_info.curves = false;
+    m_info.has_edge = false;
+    m_info.fx = m_info.fy = FLT_TO_SCALAR(0.0f);
+    m_info.lx = m_info.ly = FLT_TO_SCALAR(0.0f);
+    m_info.fdx = m_info.fdy = FLT_TO_SCALAR(0.0f);
+    m_info.ldx = m_info.ldy = FLT_TO_SCALAR(0.0f);
+    m_info.turn = 0;
+    m_info.fsx = m_info.fsy = 0;
+    m_info.lsx = m_info.lsy = 0;
+    m_info.flips_x = m_info.flips_y = 0;
+}
+
+void graphic_path::rebuild_info(void)
+{
+    reset_info();
+    uint32_t num = total_vertices_impl();
+    for (uint32_t i = 0; i < num; i++) {
+        scalar x, y;
+        uint32_t cmd = vertex_impl(i, &x, &y);
+        update_info(x, y, cmd, i ? command_impl(i - 1) : (uint32_t)path_cmd_stop);
+    }
+}
+
+void graphic_path::update_contour(scalar x, scalar y, uint32_t cmd)
+{
+    if (is_curve(cmd)) {
+        m_info.curves = true;
+    }
+
+    scalar dx = x - m_info.lx;
+    scalar dy = y - m_info.ly;
+    if ((dx == FLT_TO_SCALAR(0.0f)) && (dy == FLT_TO_SCALAR(0.0f))) {
+        return;
+    }
+
+    if ((dx != FLT_TO_SCALAR(0.0f)) && (dy != FLT_TO_SCALAR(0.0f))) {
+        m_info.aligned = false;
+    }
+
+    if (!m_info.has_edge) {
+        m_info.fdx = dx;
+        m_info.fdy = dy;
+        m_info.has_edge = true;
+    } else {
+        _add_turn(&m_info.turn, &m_info.convex, m_info.ldx, m_info.ldy, dx, dy);
+    }
+
+    _add_direction(&m_info.fsx, &m_info.lsx, &m_info.flips_x, dx);
+    _add_direction(&m_info.fsy, &m_info.lsy, &m_info.flips_y, dy);
+
+    m_info.ldx = dx;
+    m_info.ldy = dy;
+    m_info.lx = x;
+    m_info.ly = y;
+}
+
+inline void graphic_path::update_info(scalar x, scalar y, uint32_t cmd, uint32_t prev_cmd)
+{
+    if (!is_vertex(cmd)) {
+        return;
+    }
+
+    if (m_info.bounds.x1 > m_info.bounds.x2) {
+        m_info.bounds = rect_s(x, y, x, y);
+    } else {
+        m_info.bounds.x1 = Min(x, m_info.bounds.x1);
+        m_info.bounds.y1 = Min(y, m_info.bounds.y1);
+        m_info.bounds.x2 = Max(x, m_info.bounds.x2);
+        m_info.bounds.y2 = Max(y, m_info.bounds.y2);
+    }
+
+    if (is_move_to(cmd)) {
+        if (!is_move_to(prev_cmd)) { // continuous move_to only moves the start.
+            m_info.subpaths++;
+        }
+        m_info.fx = m_info.lx = x;
+        m_info.fy = m_info.ly = y;
+        return;
+    }
+
+    if (!is_vertex(prev_cmd)) {
+        // drawn from the start of closed contour or the origin.
+        m_info.subpaths++;
+        m_info.convex = false;
+        return;
+    }
+
+    if ((m_info.subpaths == 1) && m_info.convex) {
+        update_contour(x, y, cmd);
+    }
 }
 
 void graphic_path::remove_all_impl(void)
 {
+    detach_cache();
     m_vertices.clear();
     m_cmds.clear();
+    reset_info();
 }
 
 void graphic_path::add_vertex_impl(scalar x, scalar y, uint32_t cmd)
 {
+    detach_cache();
+    update_info(x, y, cmd, last_command_impl());
     if (m_vertices.is_full()) {
         m_vertices.resize(m_vertices.capacity() << 1);
         m_cmds.resize(m_cmds.capacity() << 1);
@@ -620,6 +845,7 @@ void graphic_path::add_vertex_impl(scalar x, scalar y, uint32_t cmd)
 
 void graphic_path::modify_vertex_impl(uint32_t idx, scalar x, scalar y)
 {
+    detach_cache();
     vertex_s& v = m_vertices[idx];
     v.x = x;
     v.y = y;
@@ -627,6 +853,7 @@ void graphic_path::modify_vertex_impl(uint32_t idx, scalar x, scalar y)
 
 void graphic_path::modify_vertex_impl(uint32_t idx, scalar x, scalar y, uint32_t cmd)
 {
+    detach_cache();
     vertex_s& v = m_vertices[idx];
     v.x = x;
     v.y = y;
@@ -635,11 +862,13 @@ void graphic_path::modify_vertex_impl(uint32_t idx, scalar x, scalar y, uint32_t
 
 void graphic_path::modify_command_impl(uint32_t idx, uint32_t cmd)
 {
+    detach_cache();
     m_cmds[idx] = cmd;
 }
 
 void graphic_path::swap_vertices_impl(uint32_t v1, uint32_t v2)
 {
+    detach_cache();
     vertex_s t = m_vertices[v1];
     uint32_t c = m_cmds[v1];
 
@@ -0,0 +1,142 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#include "common.h"
+#include "path_cache.h"
+
+namespace picasso {
+
+// stroke outline
+stroke_outline::stroke_outline()
+    : m_refcount(1)
+    , m_dashes(0)
+{
+    m_params.width = FLT_TO_SCALAR(1.0f);
+    m_params.miter_limit = FLT_TO_SCALAR(4.0f);
+    m_params.cap = butt_cap;
+    m_params.join = miter_join;
+    m_params.inner = inner_miter;
+    m_params.dashed = false;
+    m_params.dash_start = 0;
+    m_params.dashes = 0;
+    m_params.num_dashes = 0;
+}
+
+stroke_outline::~stroke_outline()
+{
+    if (m_dashes) {
+        mem_free(m_dashes);
+    }
+}
+
+stroke_outline* stroke_outline::create(const stroke_params& params)
+{
+    stroke_outline* o = new stroke_outline;
+    if (!o) {
+        return 0;
+    }
+
+    o->m_params = params;
+    o->m_params.dashes = 0;
+    if (params.dashed && params.num_dashes) {
+        o->m_dashes = (scalar*)mem_malloc(params.num_dashes * sizeof(scalar));
+        if (!o->m_dashes) {
+            delete o;
+            return 0;
+        }
+        mem_copy(o->m_dashes, params.dashes, params.num_dashes * sizeof(scalar));
+        o->m_params.dashes = o->m_dashes;
+    }
+    return o;
+}
+
+void stroke_outline::unref(void)
+{
+    if (atomic_dec(&m_refcount) == 0) {
+        delete this;
+    }
+}
+
+bool stroke_outline::match(const stroke_params& params) const
+{
+    if ((m_params.width != params.width) || (m_params.miter_limit != params.miter_limit)
+        || (m_params.cap != params.cap) || (m_params.join != params.join)
+        || (m_params.inner != params.inner) || (m_params.dashed != params.dashed)) {
+        return false;
+    }
+
+    if (m_params.dashed) {
+        if ((m_params.dash_start != params.dash_start) || (m_params.num_dashes != params.num_dashes)) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < params.num_dashes; i++) {
+            if (m_params.dashes[i] != params.dashes[i]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// path cache
+path_cache::path_cache()
+    : m_refcount(1)
+    , m_num(0)
+{
+    for (uint32_t i = 0; i < MAX_STROKE_OUTLINES; i++) {
+        m_outlines[i] = 0;
+    }
+}
+
+path_cache::~path_cache()
+{
+    for (uint32_t i = 0; i < m_num; i++) {
+        m_outlines[i]->unref();
+    }
+}
+
+void path_cache::unref(void)
+{
+    if (atomic_dec(&m_refcount) == 0) {
+        delete this;
+    }
+}
+
+stroke_outline* path_cache::find_outline(const stroke_params& params)
+{
+    scoped_lock lock(m_lock);
+    for (uint32_t i = 0; i < m_num; i++) {
+        stroke_outline* o = m_outlines[i];
+        if (o->match(params)) {
+            // move to front.
+            for (uint32_t j = i; j > 0; j--) {
+                m_outlines[j] = m_outlines[j - 1];
+            }
+            m_outlines[0] = o;
+            o->ref();
+            return o;
+        }
+    }
+    return 0;
+}
+
+void path_cache::add_outline(stroke_outline* outline)
+{
+    scoped_lock lock(m_lock);
+    if (m_num == MAX_STROKE_OUTLINES) {
+        m_outlines[--m_num]->unref(); // drop least recently used.
+    }
+
+    for (uint32_t j = m_num; j > 0; j--) {
+        m_outlines[j] = m_outlines[j - 1];
+    }
+    m_outlines[0] = outline;
+    outline->ref();
+    m_num++;
+}
+
+}
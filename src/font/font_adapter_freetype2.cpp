@@ -30,6 +30,7 @@
 #include "convert.h"
 #include "matrix.h"
 #include "font_adapter.h"
+#include "thread_sync.h"
 
 #include "gfx_rasterizer_scanline.h"
 #include "gfx_scanline.h"
@@ -39,6 +40,7 @@
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_OUTLINE_H
+#include FT_SIZES_H
 #include "graphic_path.h"
 #include "graphic_helper.h"
 #include "graphic_base.h"
@@ -49,13 +51,30 @@ namespace picasso {
 
 extern FT_Library _get_ft_library(void);
 
+extern thread_mutex& _get_ft_library_lock(void);
+
 extern char* _font_by_name(const char* face, float size, float weight, bool italic);
 
+struct font_face;
+
+extern font_face* _acquire_ft_face(const char* path, int32_t index);
+
+extern void _release_ft_face(font_face* face);
+
+extern FT_Face _get_ft_face(font_face* face);
+
+extern thread_mutex& _get_ft_face_lock(font_face* face);
+
+extern FT_CharMap _get_ft_face_charmap(font_face* face);
+
 class font_adapter_impl
 {
 public:
     font_adapter_impl()
-        : font(0)
+        : face(0)
+        , font(0)
+        , size(0)
+        , charmap(0)
         , antialias(false)
         , flip_y(false)
         , hinting(false)
@@ -69,6 +88,7 @@ public:
         , cur_glyph_index(0)
         , cur_data_size(0)
         , cur_data_type(glyph_type_outline)
+        , cur_sys_bitmap(false)
         , cur_bound_rect(0, 0, 0, 0)
         , cur_advance_x(0)
         , cur_advance_y(0)
@@ -77,13 +97,35 @@ public:
 
     ~font_adapter_impl()
     {
-        if (font) {
-            FT_Done_Face(font);
+        if (face) {
+            scoped_lock lock(_get_ft_library_lock());
+            if (size) {
+                scoped_lock face_lock(_get_ft_face_lock(face));
+                FT_Done_Size(size);
+                size = 0;
+            }
+            _release_ft_face(face);
+            face = 0;
             font = 0;
         }
     }
 
-    FT_Face font;
+    // make the face ready for the font, the face lock must be held.
+    void select(void)
+    {
+        if (font->size != size) {
+            FT_Activate_Size(size);
+        }
+
+        if (charmap && font->charmap != charmap) {
+            FT_Set_Charmap(font, charmap);
+        }
+    }
+
+    font_face* face;
+    FT_Face font; // shared by the fonts of the same file.
+    FT_Size size;
+    FT_CharMap charmap;
     bool antialias;
     bool flip_y;
     bool hinting;
@@ -100,6 +142,7 @@ public:
     uint32_t cur_glyph_index;
     uint32_t cur_data_size;
     glyph_type cur_data_type;
+    bool cur_sys_bitmap; // the glyph slot is shared, kept for kerning.
     rect cur_bound_rect;
     scalar cur_advance_x;
     scalar cur_advance_y;
@@ -117,20 +160,53 @@ font_adapter::font_adapter(const char* name, int32_t charset, scalar size, scala
     m_impl->flip_y = flip;
     m_impl->hinting = hint;
     m_impl->weight = weight;
-    int32_t error = FT_New_Face(m_impl->library, _font_by_name(name, size, weight, italic), 0, &m_impl->font);
-    if ((error == 0) && m_impl->font) {
-        FT_Set_Pixel_Sizes(m_impl->font, 0, uround(size));
-        FT_Select_Charmap(m_impl->font, char_set);
+    {
+        // faces of the shared library are created by one thread at a time.
+        scoped_lock lock(_get_ft_library_lock());
+        m_impl->face = _acquire_ft_face(_font_by_name(name, size, weight, italic), 0);
+        if (m_impl->face) {
+            FT_Face face = _get_ft_face(m_impl->face);
+            int32_t error = 0;
+            {
+                scoped_lock face_lock(_get_ft_face_lock(m_impl->face));
+                error = FT_New_Size(face, &m_impl->size);
+                if (error == 0) {
+                    FT_Activate_Size(m_impl->size);
+                    FT_Set_Pixel_Sizes(face, 0, uround(size));
+                }
+            }
+
+            if (error == 0) {
+                m_impl->font = face;
+            } else {
+                m_impl->size = 0;
+                _release_ft_face(m_impl->face);
+                m_impl->face = 0;
+            }
+        }
     }
+
     m_impl->matrix = *mtx;
     if (italic) {
         m_impl->matrix.shear(-0.4f, 0.0f);
     }
 
     if (m_impl->font) {
-        scalar height = INT_TO_SCALAR((m_impl->font->size->metrics.ascender - m_impl->font->size->metrics.descender) >> 6);
-        m_impl->leading = fabs(height - INT_TO_SCALAR(m_impl->font->size->metrics.height >> 6));
-        m_impl->ascent = INT_TO_SCALAR(m_impl->font->size->metrics.ascender >> 6) - m_impl->leading;
+        for (int32_t i = 0; i < m_impl->font->num_charmaps; i++) {
+            if (m_impl->font->charmaps[i]->encoding == char_set) {
+                m_impl->charmap = m_impl->font->charmaps[i];
+                break;
+            }
+        }
+
+        if (!m_impl->charmap) {
+            m_impl->charmap = _get_ft_face_charmap(m_impl->face);
+        }
+
+        const FT_Size_Metrics& metrics = m_impl->size->metrics;
+        scalar height = INT_TO_SCALAR((metrics.ascender - metrics.descender) >> 6);
+        m_impl->leading = fabs(height - INT_TO_SCALAR(metrics.height >> 6));
+        m_impl->ascent = INT_TO_SCALAR(metrics.ascender >> 6) - m_impl->leading;
         m_impl->descent = INT_TO_SCALAR(fabs(m_impl->font->descender >> 6));
         m_impl->height = m_impl->ascent + m_impl->descent;
         m_impl->units_per_em = m_impl->font->units_per_EM;
@@ -159,10 +235,14 @@ void font_adapter::add_kerning(uint32_t first, uint32_t second, scalar* x, scala
 {
     if (m_impl->font && first && second && FT_HAS_KERNING(m_impl->font)) {
         FT_Vector delta;
-        FT_Get_Kerning(m_impl->font, first, second, FT_KERNING_DEFAULT, &delta);
+        {
+            scoped_lock lock(_get_ft_face_lock(m_impl->face));
+            m_impl->select();
+            FT_Get_Kerning(m_impl->font, first, second, FT_KERNING_DEFAULT, &delta);
+        }
         scalar dx = int26p6_to_flt(delta.x);
         scalar dy = int26p6_to_flt(delta.y);
-        if (m_impl->font->glyph->format != FT_GLYPH_FORMAT_BITMAP) {
+        if (!m_impl->cur_sys_bitmap) {
             m_impl->matrix.transform_2x2(&dx, &dy);
         }
         *x += dx;
@@ -442,6 +522,10 @@ static void decompose_ft_bitmap_mono(const FT_Bitmap& bitmap, int32_t x, int32_t
 bool font_adapter::prepare_glyph(uint32_t code)
 {
     if (m_impl->font) {
+        // glyph slot of the face is used until the glyph is decomposed.
+        scoped_lock lock(_get_ft_face_lock(m_impl->face));
+        m_impl->select();
+
         m_impl->cur_glyph_index = FT_Get_Char_Index(m_impl->font, code);
 
         int32_t error = FT_Load_Glyph(m_impl->font, m_impl->cur_glyph_index,
@@ -451,6 +535,7 @@ bool font_adapter::prepare_glyph(uint32_t code)
         if (m_impl->font->glyph->format == FT_GLYPH_FORMAT_BITMAP) {
             is_sys_bitmap = true;
         }
+        m_impl->cur_sys_bitmap = is_sys_bitmap;
 
         if (error == 0) {
             if (m_impl->antialias && !is_sys_bitmap) {
@@ -34,7 +34,13 @@
 #include <string.h>
 
 #if defined(WIN32)
+    #include <windows.h>
     #define strncasecmp _strnicmp
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
 #endif
 
 #if defined(__ANDROID__)
@@ -48,6 +54,12 @@
 
 #define MAX_CONFIG_LINE    MAX_PATH_LEN
 
+#if ENABLE(LOW_MEMORY)
+    #define MAX_IDLE_FONT_FACES 2
+#else
+    #define MAX_IDLE_FONT_FACES 8
+#endif
+
 #if ENABLE(FONT_CONFIG)
     #include <fontconfig/fontconfig.h>
 #else //not fontconfig
@@ -307,11 +319,189 @@ static void load_font_from_file(FILE* f)
 
 static FT_Library g_library = NULL;
 
+// the library and the font map are shared by the fonts of all threads.
+static thread_mutex g_library_lock;
+
 FT_Library _get_ft_library(void)
 {
     return g_library;
 }
 
+thread_mutex& _get_ft_library_lock(void)
+{
+    return g_library_lock;
+}
+
+// font file mapped in memory and its face, shared by the fonts of all sizes.
+struct font_face {
+    char path[MAX_FONT_PATH_LENGTH];
+    int32_t index;
+    int32_t refcount;
+    FT_Face face;
+    FT_CharMap charmap; // selected when the face is opened.
+    void* data;
+    size_t size;
+    thread_mutex lock; // glyph loading and sizes of the face.
+    font_face* prev;
+    font_face* next;
+};
+
+// faces in most recently used order, unused ones are kept until there are too many.
+static font_face* g_faces = NULL;
+
+static void* map_font_file(const char* path, size_t* size)
+{
+#if defined(WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+
+    void* data = NULL;
+    LARGE_INTEGER fsize;
+    if (GetFileSizeEx(file, &fsize) && fsize.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping); // the view keeps the mapping.
+            *size = (size_t)fsize.QuadPart;
+        }
+    }
+    CloseHandle(file);
+    return data;
+#else
+    int32_t fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    void* data = NULL;
+    struct stat st;
+    if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+        data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            data = NULL;
+        } else {
+            *size = (size_t)st.st_size;
+        }
+    }
+    close(fd);
+    return data;
+#endif
+}
+
+static void unmap_font_file(void* data, size_t size)
+{
+#if defined(WIN32)
+    UnmapViewOfFile(data);
+#else
+    munmap(data, size);
+#endif
+}
+
+static void unlink_face(font_face* f)
+{
+    if (f->prev) {
+        f->prev->next = f->next;
+    } else {
+        g_faces = f->next;
+    }
+
+    if (f->next) {
+        f->next->prev = f->prev;
+    }
+}
+
+static void link_face(font_face* f)
+{
+    f->prev = NULL;
+    f->next = g_faces;
+    if (g_faces) {
+        g_faces->prev = f;
+    }
+    g_faces = f;
+}
+
+static void free_face(font_face* f)
+{
+    unlink_face(f);
+    FT_Done_Face(f->face);
+    unmap_font_file(f->data, f->size);
+    delete f;
+}
+
+// the library lock must be held.
+font_face* _acquire_ft_face(const char* path, int32_t index)
+{
+    for (font_face* f = g_faces; f; f = f->next) {
+        if ((f->index == index) && (strncmp(f->path, path, MAX_FONT_PATH_LENGTH - 1) == 0)) {
+            f->refcount++;
+            if (f != g_faces) {
+                unlink_face(f);
+                link_face(f);
+            }
+            return f;
+        }
+    }
+
+    font_face* f = new font_face;
+    if (!f) {
+        global_status = STATUS_OUT_OF_MEMORY;
+        return NULL;
+    }
+
+    f->data = map_font_file(path, &f->size);
+    if (!f->data) {
+        delete f;
+        return NULL;
+    }
+
+    if (FT_New_Memory_Face(g_library, (const FT_Byte*)f->data, (FT_Long)f->size, index, &f->face) != 0) {
+        unmap_font_file(f->data, f->size);
+        delete f;
+        return NULL;
+    }
+
+    strncpy(f->path, path, MAX_FONT_PATH_LENGTH - 1);
+    f->path[MAX_FONT_PATH_LENGTH - 1] = '\0';
+    f->index = index;
+    f->refcount = 1;
+    f->charmap = f->face->charmap;
+    link_face(f);
+    return f;
+}
+
+// the library lock must be held.
+void _release_ft_face(font_face* face)
+{
+    face->refcount--;
+
+    uint32_t idles = 0;
+    font_face* f = g_faces;
+    while (f) {
+        font_face* next = f->next;
+        if (f->refcount <= 0 && ++idles > MAX_IDLE_FONT_FACES) {
+            free_face(f); // least recently used
+        }
+        f = next;
+    }
+}
+
+FT_Face _get_ft_face(font_face* face)
+{
+    return face->face;
+}
+
+thread_mutex& _get_ft_face_lock(font_face* face)
+{
+    return face->lock;
+}
+
+FT_CharMap _get_ft_face_charmap(font_face* face)
+{
+    return face->charmap;
+}
+
 bool _load_fonts(void)
 {
     if (g_library) {
@@ -362,6 +552,10 @@ bool _load_fonts(void)
 
 void _free_fonts(void)
 {
+    while (g_faces) {
+        free_face(g_faces);
+    }
+
     if (g_library) {
         FT_Done_FreeType(g_library);
         g_library = NULL;
@@ -119,10 +119,7 @@ public:
                 *p++ = v;
             } while (--len);
         } else {
-            do {
-                blender_type::blend_pix(m_blend_op, p, c.r, c.g, c.b, alpha, cover);
-                p++;
-            } while (--len);
+            blender_type::blend_solid_span(m_blend_op, p, c.r, c.g, c.b, alpha, 0, cover, len);
         }
     }
 
@@ -140,11 +137,7 @@ public:
     {
         pixel_type* p = (pixel_type*)m_buffer->row_ptr(x, y, len) + x;
         _REGISTER_ value_type alpha = (value_type)alpha_mul(c.a, m_alpha_factor);
-        do {
-            blender_type::blend_pix(m_blend_op,
-                                    p, c.r, c.g, c.b, alpha, *covers++);
-            p++;
-        } while (--len);
+        blender_type::blend_solid_span(m_blend_op, p, c.r, c.g, c.b, alpha, covers, 0, len);
     }
 
     void blend_solid_vspan(int32_t x, int32_t y, uint32_t len, const color_type& c, const uint8_t* covers)
@@ -179,16 +172,7 @@ public:
                            const color_type* colors, const uint8_t* covers, uint8_t cover)
     {
         pixel_type* p = (pixel_type*)m_buffer->row_ptr(x, y, len) + x;
-        do {
-            blender_type::blend_pix(m_blend_op, p,
-                                    colors->r,
-                                    colors->g,
-                                    colors->b,
-                                    (value_type)alpha_mul(colors->a, m_alpha_factor),
-                                    covers ? *covers++ : cover);
-            p++;
-            ++colors;
-        } while (--len);
+        blender_type::blend_color_span(m_blend_op, p, colors, m_alpha_factor, covers, cover, len);
     }
 
     void blend_color_vspan(int32_t x, int32_t y, uint32_t len,
@@ -280,6 +264,7 @@ public:
         const src_value_type* psrc = (src_value_type*)from.row_ptr(ysrc);
         _REGISTER_ value_type alpha = (value_type)alpha_mul(color.a, m_alpha_factor);
         if (psrc) {
+            psrc += xsrc;
             pixel_type* pdst = (pixel_type*)m_buffer->row_ptr(xdst, ydst, len) + xdst;
 
             do {
@@ -299,6 +284,7 @@ public:
         typedef typename SrcPixelFormatRenderer::value_type src_value_type;
         const src_value_type* psrc = (src_value_type*)from.row_ptr(ysrc);
         if (psrc) {
+            psrc += xsrc;
             pixel_type* pdst = (pixel_type*)m_buffer->row_ptr(xdst, ydst, len) + xdst;
 
             do {
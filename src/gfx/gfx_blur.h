@@ -9,6 +9,9 @@
 
 #include "common.h"
 #include "data_vector.h"
+#include "graphic_base.h"
+
+#include "gfx_thread_pool.h"
 
 namespace gfx {
 
@@ -45,6 +48,101 @@ private:
     pixfmt_type* m_pixfmt;
 };
 
+// pixel region of pixfmt
+template <typename PixFmt>
+class pixfmt_region
+{
+public:
+    typedef PixFmt pixfmt_type;
+    typedef typename pixfmt_type::color_type color_type;
+
+    pixfmt_region(pixfmt_type& pixfmt, const rect& rc)
+        : m_pixfmt(&pixfmt)
+        , m_x(rc.x1)
+        , m_y(rc.y1)
+        , m_width((uint32_t)(rc.x2 - rc.x1))
+        , m_height((uint32_t)(rc.y2 - rc.y1))
+    {
+    }
+
+    uint32_t width(void) const { return m_width; }
+    uint32_t height(void) const { return m_height; }
+
+    color_type pixel(int32_t x, int32_t y) const
+    {
+        return m_pixfmt->pixel(x + m_x, y + m_y);
+    }
+
+    void copy_color_hspan(int32_t x, int32_t y, uint32_t len, const color_type* colors)
+    {
+        m_pixfmt->copy_color_hspan(x + m_x, y + m_y, len, colors);
+    }
+
+    void copy_color_vspan(int32_t x, int32_t y, uint32_t len, const color_type* colors)
+    {
+        m_pixfmt->copy_color_vspan(x + m_x, y + m_y, len, colors);
+    }
+
+private:
+    pixfmt_type* m_pixfmt;
+    int32_t m_x;
+    int32_t m_y;
+    uint32_t m_width;
+    uint32_t m_height;
+};
+
+// single channel color of alpha layer
+struct alpha8 {
+    typedef uint8_t value_type;
+    enum {
+        base_shift = 8,
+        base_mask = 255,
+    };
+    value_type a;
+};
+
+// alpha view of 8 bits single channel pixfmt
+template <typename PixFmt>
+class pixfmt_alpha8_view
+{
+public:
+    typedef PixFmt pixfmt_type;
+    typedef alpha8 color_type;
+
+    explicit pixfmt_alpha8_view(pixfmt_type& pixfmt)
+        : m_pixfmt(&pixfmt)
+    {
+    }
+
+    uint32_t width(void) const { return m_pixfmt->width(); }
+    uint32_t height(void) const { return m_pixfmt->height(); }
+
+    color_type pixel(int32_t x, int32_t y) const
+    {
+        color_type c;
+        c.a = *(m_pixfmt->pix_ptr(x, y));
+        return c;
+    }
+
+    void copy_color_hspan(int32_t x, int32_t y, uint32_t len, const color_type* colors)
+    {
+        uint8_t* p = m_pixfmt->pix_ptr(x, y);
+        do {
+            *p++ = (colors++)->a;
+        } while (--len);
+    }
+
+    void copy_color_vspan(int32_t x, int32_t y, uint32_t len, const color_type* colors)
+    {
+        do {
+            *(m_pixfmt->pix_ptr(x, y++)) = (colors++)->a;
+        } while (--len);
+    }
+
+private:
+    pixfmt_type* m_pixfmt;
+};
+
 // stack blur calc
 struct stack_blur_calc_rgba {
     typedef uint32_t value_type;
@@ -90,6 +188,43 @@ struct stack_blur_calc_rgba {
         v.b = value_type((b * mul) >> shr);
         v.a = value_type((a * mul) >> shr);
     }
+
+    // transparent pixel takes the shading color, so the edges are not darkened.
+    template <typename T> static void shade(T& v, const T& s)
+    {
+        if ((v.r == 0) && (v.g == 0) && (v.b == 0) && (v.a == 0)) {
+            v = s;
+        }
+    }
+};
+
+struct stack_blur_calc_alpha {
+    typedef uint32_t value_type;
+    value_type a;
+
+    void clear(void) { a = 0; }
+
+    template <typename T> void add(const T& v) { a += v.a; }
+    template <typename T> void add(const T& v, uint32_t k) { a += v.a * k; }
+    template <typename T> void sub(const T& v) { a -= v.a; }
+
+    template <typename T> void calc_pix(T& v, uint32_t mul, uint32_t shr)
+    {
+        typedef typename T::value_type value_type;
+        v.a = value_type((a * mul) >> shr);
+    }
+
+    template <typename T> static void shade(T&, const T&) { }
+};
+
+template <typename ColorType>
+struct stack_blur_calc_type {
+    typedef stack_blur_calc_rgba type;
+};
+
+template <>
+struct stack_blur_calc_type<alpha8> {
+    typedef stack_blur_calc_alpha type;
 };
 
 // stack blur generator
@@ -98,18 +233,16 @@ class stack_blur
 {
 public:
     typedef ColorType color_type;
-    ALIGNED(16) typedef stack_blur_calc_rgba calculator_type;
+    typedef typename stack_blur_calc_type<ColorType>::type calculator_type;
 
     stack_blur()
     {
-        m_shading.r = m_shading.g = m_shading.b = m_shading.a = 0;
+        memset((void*)&m_shading, 0, sizeof(color_type));
     }
 
     void set_shading(const color_type& c)
     {
-        m_shading.r = c.r;
-        m_shading.g = c.g;
-        m_shading.b = c.b;
+        m_shading = c;
         m_shading.a = 0;
     }
 
@@ -188,13 +321,7 @@ public:
                 }
                 pix = img.pixel(xp, y);
 
-                if ((pix.r == 0) && (pix.g == 0)
-                    && (pix.b == 0) && (pix.a == 0)) {
-                    pix.r = m_shading.r;
-                    pix.g = m_shading.g;
-                    pix.b = m_shading.b;
-                    pix.a = m_shading.a;
-                }
+                calculator_type::shade(pix, m_shading);
 
                 *stack_pix = pix;
 
@@ -216,26 +343,199 @@ public:
         }
     }
 
+    // vertical pass goes row by row with sums of each column, it gives the same
+    // pixels as blur_x on transformed image but reads and writes memory in rows.
     template <typename Img>
     void blur_y(Img& img, uint32_t radius)
     {
-        pixfmt_transformer<Img> img2(img);
-        blur_x(img2, radius);
+        if (radius < 1) {
+            return;
+        }
+
+        uint32_t x, y, yp, i;
+        uint32_t stack_ptr;
+        uint32_t stack_start;
+
+        color_type pix;
+        color_type* stack_pix;
+
+        uint32_t w = img.width();
+        uint32_t h = img.height();
+        uint32_t hm = h - 1;
+        uint32_t div = (radius << 1) + 1;
+
+        uint32_t mul_sum = 0;
+        uint32_t shr_sum = 0;
+        uint32_t max_val = color_type::base_mask;
+
+        if (max_val <= 255 && radius < 255) {
+            mul_sum = g_stack_blur8_mul[radius];
+            shr_sum = g_stack_blur8_shr[radius];
+        }
+
+        m_buffer.allocate(w + 128);
+        m_stack.allocate(div * w + 32);
+        m_sums.allocate(w * 3);
+
+        calculator_type* sum = &m_sums[0];
+        calculator_type* sum_in = &m_sums[w];
+        calculator_type* sum_out = &m_sums[w << 1];
+
+        for (x = 0; x < w; x++) {
+            sum[x].clear();
+            sum_in[x].clear();
+            sum_out[x].clear();
+
+            pix = img.pixel(x, 0);
+            for (i = 0; i <= radius; i++) {
+                m_stack[i * w + x] = pix;
+                sum[x].add(pix, i + 1);
+                sum_out[x].add(pix);
+            }
+        }
+
+        for (i = 1; i <= radius; i++) {
+            for (x = 0; x < w; x++) {
+                pix = img.pixel(x, (i > hm) ? hm : i);
+                m_stack[(i + radius) * w + x] = pix;
+                sum[x].add(pix, radius + 1 - i);
+                sum_in[x].add(pix);
+            }
+        }
+
+        stack_ptr = radius;
+        for (y = 0; y < h; y++) {
+            stack_start = stack_ptr + div - radius;
+
+            if (stack_start >= div) {
+                stack_start -= div;
+            }
+
+            yp = y + radius + 1;
+
+            if (yp > hm) {
+                yp = hm;
+            }
+
+            stack_pix = &m_stack[stack_start * w];
+            for (x = 0; x < w; x++) {
+                sum[x].calc_pix(m_buffer[x], mul_sum, shr_sum);
+                sum[x].sub(sum_out[x]);
+                sum_out[x].sub(stack_pix[x]);
+
+                pix = img.pixel(x, yp);
+
+                calculator_type::shade(pix, m_shading);
+
+                stack_pix[x] = pix;
+
+                sum_in[x].add(pix);
+                sum[x].add(sum_in[x]);
+            }
+            img.copy_color_hspan(0, y, w, &m_buffer[0]);
+
+            ++stack_ptr;
+
+            if (stack_ptr >= div) {
+                stack_ptr = 0;
+            }
+
+            stack_pix = &m_stack[stack_ptr * w];
+            for (x = 0; x < w; x++) {
+                sum_out[x].add(stack_pix[x]);
+                sum_in[x].sub(stack_pix[x]);
+            }
+        }
     }
 
     template <typename Img>
     void blur(Img& img, uint32_t radius)
     {
         blur_x(img, radius);
-        pixfmt_transformer<Img> img2(img);
-        blur_x(img2, radius);
+        blur_y(img, radius);
     }
 
 private:
     color_type m_shading;
     pod_vector<color_type> m_buffer;
     pod_vector<color_type> m_stack;
+    pod_vector<calculator_type> m_sums;
+};
+
+enum {
+    blur_band_min = 16, // minimum rows or columns of a band.
+    blur_min_pixels = 65536, // smaller area is blurred by one thread.
+};
+
+// blur task of bands, rows are split for horizontal pass and columns for vertical pass.
+template <typename Img, typename ColorType>
+struct stack_blur_task {
+    Img* img;
+    rect area;
+    uint32_t radius;
+    uint32_t band;
+    bool vertical;
+    ColorType shading;
+
+    static void blur(void* data, uint32_t index)
+    {
+        stack_blur_task* t = static_cast<stack_blur_task*>(data);
+
+        rect rc = t->area;
+        if (t->vertical) {
+            rc.x1 = t->area.x1 + (int32_t)(index * t->band);
+            rc.x2 = Min(rc.x1 + (int32_t)t->band, t->area.x2);
+        } else {
+            rc.y1 = t->area.y1 + (int32_t)(index * t->band);
+            rc.y2 = Min(rc.y1 + (int32_t)t->band, t->area.y2);
+        }
+
+        pixfmt_region<Img> region(*(t->img), rc);
+        stack_blur<ColorType> b;
+        b.set_shading(t->shading);
+        if (t->vertical) {
+            b.blur_y(region, t->radius);
+        } else {
+            b.blur_x(region, t->radius);
+        }
+    }
 };
 
+// stack blur the area of image, large area is split into bands in thread pool.
+template <typename Img, typename ColorType>
+void stack_blur_area(gfx_thread_pool* pool, Img& img, const rect& area, uint32_t radius, const ColorType& shading)
+{
+    uint32_t w = (uint32_t)(area.x2 - area.x1);
+    uint32_t h = (uint32_t)(area.y2 - area.y1);
+
+#if ENABLE(MULTI_THREADS)
+    if (pool && (w >= (blur_band_min << 1)) && (h >= (blur_band_min << 1)) && (w * h >= blur_min_pixels)) {
+        uint32_t threads = pool->threads();
+
+        stack_blur_task<Img, ColorType> task;
+        task.img = &img;
+        task.area = area;
+        task.radius = radius;
+        task.shading = shading;
+
+        task.vertical = false;
+        task.band = Max((h + threads - 1) / threads, (uint32_t)blur_band_min);
+        pool->run(task.blur, &task, (h + task.band - 1) / task.band);
+
+        task.vertical = true;
+        task.band = Max((w + threads - 1) / threads, (uint32_t)blur_band_min);
+        pool->run(task.blur, &task, (w + task.band - 1) / task.band);
+        return;
+    }
+#endif
+
+    if (w && h) {
+        pixfmt_region<Img> region(img, area);
+        stack_blur<ColorType> b;
+        b.set_shading(shading);
+        b.blur(region, radius);
+    }
+}
+
 }
 #endif /*_GFX_BLUR_H_*/
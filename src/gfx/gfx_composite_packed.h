@@ -1377,5 +1377,147 @@ blend_op_table_packed<ColorType, Order, Blender>::g_packed_blend_op_func[] = {
     0
 };
 
+// span composite for packed, the composite operate is selected once for whole span.
+template <typename CompOp, typename ColorType, typename Blender>
+struct composite_span_packed {
+    typedef ColorType color_type;
+    typedef Blender blender_type;
+    typedef typename blender_type::pixel_type pixel_type;
+
+    enum {
+        base_shift = color_type::base_shift,
+        base_mask = color_type::base_mask,
+    };
+
+    static void blend_solid_span(pixel_type* p, uint32_t sr, uint32_t sg, uint32_t sb, uint32_t sa,
+                                 const uint8_t* covers, uint32_t cover, uint32_t len)
+    {
+        if (covers) {
+            do {
+                CompOp::blend_pix(p++, sr, sg, sb, sa, *covers++);
+            } while (--len);
+        } else {
+            do {
+                CompOp::blend_pix(p++, sr, sg, sb, sa, cover);
+            } while (--len);
+        }
+    }
+
+    static void blend_color_span(pixel_type* p, const color_type* colors, uint32_t alpha,
+                                 const uint8_t* covers, uint32_t cover, uint32_t len)
+    {
+        do {
+            uint32_t ca = (alpha == base_mask) ? colors->a : ((colors->a * alpha + base_mask) >> base_shift);
+            CompOp::blend_pix(p++, (colors->r * ca + base_mask) >> base_shift,
+                              (colors->g * ca + base_mask) >> base_shift,
+                              (colors->b * ca + base_mask) >> base_shift,
+                              ca, covers ? *covers++ : cover);
+            ++colors;
+        } while (--len);
+    }
+};
+
+// span composite table for blend packed pixel format.
+template <typename ColorType, typename Order, typename Blender>
+struct blend_span_table_packed {
+    typedef Blender blender_type;
+    typedef typename blender_type::pixel_type pixel_type;
+    typedef void (*solid_span_func_type)(pixel_type* p,
+                                         uint32_t cr,
+                                         uint32_t cg,
+                                         uint32_t cb,
+                                         uint32_t ca,
+                                         const uint8_t* covers,
+                                         uint32_t cover,
+                                         uint32_t len);
+    typedef void (*color_span_func_type)(pixel_type* p,
+                                         const ColorType* colors,
+                                         uint32_t alpha,
+                                         const uint8_t* covers,
+                                         uint32_t cover,
+                                         uint32_t len);
+
+    static solid_span_func_type g_packed_solid_span_func[];
+    static color_span_func_type g_packed_color_span_func[];
+};
+
+// g_packed_solid_span_func
+template <typename ColorType, typename Order, typename Blender>
+typename blend_span_table_packed<ColorType, Order, Blender>::solid_span_func_type
+blend_span_table_packed<ColorType, Order, Blender>::g_packed_solid_span_func[] = {
+    composite_span_packed<composite_op_packed_clear<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_src<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_src_over<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_src_in<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_src_out<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_src_atop<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_dst<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_dst_over<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_dst_in<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_dst_out<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_dst_atop<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_xor<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_darken<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_lighten<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_overlay<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_screen<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_multiply<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_plus<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_minus<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_exclusion<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_difference<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_soft_light<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_hard_light<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_color_burn<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_color_dodge<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_contrast<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_invert<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_invert_rgb<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_hue<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_saturation<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_color<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    composite_span_packed<composite_op_packed_luminosity<ColorType, Order, Blender>, ColorType, Blender>::blend_solid_span,
+    0
+};
+
+// g_packed_color_span_func
+template <typename ColorType, typename Order, typename Blender>
+typename blend_span_table_packed<ColorType, Order, Blender>::color_span_func_type
+blend_span_table_packed<ColorType, Order, Blender>::g_packed_color_span_func[] = {
+    composite_span_packed<composite_op_packed_clear<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_src<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_src_over<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_src_in<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_src_out<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_src_atop<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_dst<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_dst_over<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_dst_in<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_dst_out<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_dst_atop<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_xor<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_darken<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_lighten<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_overlay<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_screen<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_multiply<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_plus<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_minus<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_exclusion<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_difference<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_soft_light<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_hard_light<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_color_burn<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_color_dodge<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_contrast<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_invert<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_invert_rgb<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_hue<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_saturation<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_color<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    composite_span_packed<composite_op_packed_luminosity<ColorType, Order, Blender>, ColorType, Blender>::blend_color_span,
+    0
+};
+
 }
 #endif /*_GFX_COMPOSITE_PACKED_H_*/
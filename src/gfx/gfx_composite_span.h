@@ -0,0 +1,323 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#ifndef _GFX_COMPOSITE_SPAN_H_
+#define _GFX_COMPOSITE_SPAN_H_
+
+#include "common.h"
+#include "graphic_base.h"
+
+#if (CPU(X86) || CPU(X86_64)) && defined(__AVX2__)
+    #include "composite_avx2.h"
+    #define COMPOSITE_VECTOR_TYPE composite_vector_avx2
+#elif (CPU(X86) || CPU(X86_64)) && defined(__SSE2__)
+    #include "composite_sse2.h"
+    #define COMPOSITE_VECTOR_TYPE composite_vector_sse2
+#elif CPU(ARM_NEON)
+    #include "composite_neon.h"
+    #define COMPOSITE_VECTOR_TYPE composite_vector_neon
+#endif
+
+namespace gfx {
+
+// vector composite operate for rgba span, unsupported by default.
+template <uint32_t Op, typename Order>
+struct composite_vector_op_rgba {
+    enum {
+        supported = 0
+    };
+};
+
+// span composite for rgba, the composite operate is selected once for whole span.
+template <uint32_t Op, typename CompOp, typename ColorType, typename Order,
+          bool = composite_vector_op_rgba<Op, Order>::supported>
+struct composite_span_rgba {
+    typedef ColorType color_type;
+    typedef typename color_type::value_type value_type;
+
+    enum {
+        base_shift = color_type::base_shift,
+        base_mask = color_type::base_mask,
+    };
+
+    static void blend_solid_span(value_type* p, uint32_t sr, uint32_t sg, uint32_t sb, uint32_t sa,
+                                 const uint8_t* covers, uint32_t cover, uint32_t len)
+    {
+        if (covers) {
+            do {
+                CompOp::blend_pix(p, sr, sg, sb, sa, *covers++);
+                p += 4;
+            } while (--len);
+        } else {
+            do {
+                CompOp::blend_pix(p, sr, sg, sb, sa, cover);
+                p += 4;
+            } while (--len);
+        }
+    }
+
+    static void blend_color_span(value_type* p, const color_type* colors, uint32_t alpha,
+                                 const uint8_t* covers, uint32_t cover, uint32_t len)
+    {
+        do {
+            uint32_t ca = (alpha == base_mask) ? colors->a : ((colors->a * alpha + base_mask) >> base_shift);
+            CompOp::blend_pix(p, (colors->r * ca + base_mask) >> base_shift,
+                              (colors->g * ca + base_mask) >> base_shift,
+                              (colors->b * ca + base_mask) >> base_shift,
+                              ca, covers ? *covers++ : cover);
+            p += 4;
+            ++colors;
+        } while (--len);
+    }
+};
+
+#if defined(COMPOSITE_VECTOR_TYPE)
+
+typedef COMPOSITE_VECTOR_TYPE composite_vector;
+
+// Vector operates take premultiplied source lanes in pixel order and the
+// coverage of each pixel, they give the same result as scalar composite operates.
+
+// composite_vector_op_rgba_src
+template <typename Order>
+struct composite_vector_op_rgba<comp_op_src, Order> {
+    typedef composite_vector::vector_type vector_type;
+
+    enum {
+        supported = 1
+    };
+
+    static _FORCE_INLINE_ vector_type blend(vector_type d, vector_type s, vector_type c)
+    {
+        return composite_vector::add(composite_vector::mul_div(d, composite_vector::sub(composite_vector::splat(255), c)),
+                                     composite_vector::mul_div(s, c));
+    }
+};
+
+// composite_vector_op_rgba_src_over
+template <typename Order>
+struct composite_vector_op_rgba<comp_op_src_over, Order> {
+    typedef composite_vector::vector_type vector_type;
+
+    enum {
+        supported = 1
+    };
+
+    // Dca' = Sca + Dca.(1 - Sa)
+    // Da'  = Sa + Da - Sa.Da
+    static _FORCE_INLINE_ vector_type blend(vector_type d, vector_type s, vector_type c)
+    {
+        s = composite_vector::mul_div(s, c);
+        vector_type sa = composite_vector::template shuffle<Order::A * 0x55>(s);
+        vector_type rgb = composite_vector::add(s, composite_vector::mul_div(d,
+                                                composite_vector::sub(composite_vector::splat(255), sa)));
+        vector_type a = composite_vector::sub(composite_vector::add(s, d), composite_vector::mul_div(s, d));
+        return composite_vector::select(composite_vector::template lane_mask<Order::A>(), a, rgb);
+    }
+};
+
+// composite_vector_op_rgba_dst_over
+template <typename Order>
+struct composite_vector_op_rgba<comp_op_dst_over, Order> {
+    typedef composite_vector::vector_type vector_type;
+
+    enum {
+        supported = 1
+    };
+
+    // Dca' = Dca + Sca.(1 - Da)
+    // Da'  = Sa + Da - Sa.Da
+    static _FORCE_INLINE_ vector_type blend(vector_type d, vector_type s, vector_type c)
+    {
+        s = composite_vector::mul_div(s, c);
+        vector_type da = composite_vector::template shuffle<Order::A * 0x55>(d);
+        vector_type rgb = composite_vector::add(d, composite_vector::mul_div(s,
+                                                composite_vector::sub(composite_vector::splat(255), da)));
+        vector_type a = composite_vector::sub(composite_vector::add(s, d), composite_vector::mul_div(s, d));
+        return composite_vector::select(composite_vector::template lane_mask<Order::A>(), a, rgb);
+    }
+};
+
+// composite_vector_op_rgba_src_in
+template <typename Order>
+struct composite_vector_op_rgba<comp_op_src_in, Order> {
+    typedef composite_vector::vector_type vector_type;
+
+    enum {
+        supported = 1
+    };
+
+    // Dca' = Sca.Da
+    // Da'  = Sa.Da
+    static _FORCE_INLINE_ vector_type blend(vector_type d, vector_type s, vector_type c)
+    {
+        vector_type da = composite_vector::template shuffle<Order::A * 0x55>(d);
+        return composite_vector::add(composite_vector::mul_div(d, composite_vector::sub(composite_vector::splat(255), c)),
+                                     composite_vector::mul_div(composite_vector::mul_div(s, da), c));
+    }
+};
+
+// composite_vector_op_rgba_multiply
+template <typename Order>
+struct composite_vector_op_rgba<comp_op_multiply, Order> {
+    typedef composite_vector::vector_type vector_type;
+
+    enum {
+        supported = 1
+    };
+
+    // Dca' = Sca.Dca + Sca.(1 - Da) + Dca.(1 - Sa)
+    // Da'  = Sa + Da - Sa.Da
+    static _FORCE_INLINE_ vector_type blend(vector_type d, vector_type s, vector_type c)
+    {
+        vector_type one = composite_vector::splat(255);
+        s = composite_vector::mul_div(s, c);
+        vector_type sa = composite_vector::template shuffle<Order::A * 0x55>(s);
+        vector_type da = composite_vector::template shuffle<Order::A * 0x55>(d);
+        vector_type rgb = composite_vector::mul_add_div(s, composite_vector::add(d, composite_vector::sub(one, da)),
+                                                        d, composite_vector::sub(one, sa));
+        vector_type a = composite_vector::sub(composite_vector::add(s, d), composite_vector::mul_div(s, d));
+        return composite_vector::select(composite_vector::template lane_mask<Order::A>(), a, rgb);
+    }
+};
+
+// composite_vector_op_rgba_screen
+template <typename Order>
+struct composite_vector_op_rgba<comp_op_screen, Order> {
+    typedef composite_vector::vector_type vector_type;
+
+    enum {
+        supported = 1
+    };
+
+    // Dca' = Sca + Dca - Sca.Dca
+    // Da'  = Sa + Da - Sa.Da
+    static _FORCE_INLINE_ vector_type blend(vector_type d, vector_type s, vector_type c)
+    {
+        s = composite_vector::mul_div(s, c);
+        return composite_vector::sub(composite_vector::add(s, d), composite_vector::mul_div(s, d));
+    }
+};
+
+// composite_vector_op_rgba_plus
+template <typename Order>
+struct composite_vector_op_rgba<comp_op_plus, Order> {
+    typedef composite_vector::vector_type vector_type;
+
+    enum {
+        supported = 1
+    };
+
+    // Dca' = Sca + Dca
+    // Da'  = Sa + Da
+    static _FORCE_INLINE_ vector_type blend(vector_type d, vector_type s, vector_type c)
+    {
+        s = composite_vector::mul_div(s, c);
+        return composite_vector::min(composite_vector::add(s, d), composite_vector::splat(255));
+    }
+};
+
+// span composite for rgba with vector operate, the tail of span uses scalar operate.
+template <uint32_t Op, typename CompOp, typename ColorType, typename Order>
+struct composite_span_rgba<Op, CompOp, ColorType, Order, true> {
+    typedef ColorType color_type;
+    typedef typename color_type::value_type value_type;
+    typedef composite_vector::vector_type vector_type;
+    typedef composite_vector_op_rgba<Op, Order> vector_op;
+
+    enum {
+        base_shift = color_type::base_shift,
+        base_mask = color_type::base_mask,
+        step = composite_vector::step,
+        // move r, g, b, a lanes of color to lanes of pixel order.
+        swizzle = (0 << (Order::R * 2)) | (1 << (Order::G * 2)) | (2 << (Order::B * 2)) | (3 << (Order::A * 2)),
+    };
+
+    static void blend_solid_span(value_type* p, uint32_t sr, uint32_t sg, uint32_t sb, uint32_t sa,
+                                 const uint8_t* covers, uint32_t cover, uint32_t len)
+    {
+        uint32_t v;
+        ((value_type*)&v)[Order::R] = (value_type)sr;
+        ((value_type*)&v)[Order::G] = (value_type)sg;
+        ((value_type*)&v)[Order::B] = (value_type)sb;
+        ((value_type*)&v)[Order::A] = (value_type)sa;
+
+        vector_type s = composite_vector::splat_pixel(v);
+        vector_type d0, d1, c0, c1;
+
+        if (covers) {
+            for (; len >= step; len -= step) {
+                composite_vector::load(p, d0, d1);
+                composite_vector::load_covers(covers, c0, c1);
+                composite_vector::store(p, vector_op::blend(d0, s, c0), vector_op::blend(d1, s, c1));
+                p += step << 2;
+                covers += step;
+            }
+
+            for (; len; len--) {
+                CompOp::blend_pix(p, sr, sg, sb, sa, *covers++);
+                p += 4;
+            }
+        } else {
+            c0 = composite_vector::splat(cover);
+            for (; len >= step; len -= step) {
+                composite_vector::load(p, d0, d1);
+                composite_vector::store(p, vector_op::blend(d0, s, c0), vector_op::blend(d1, s, c0));
+                p += step << 2;
+            }
+
+            for (; len; len--) {
+                CompOp::blend_pix(p, sr, sg, sb, sa, cover);
+                p += 4;
+            }
+        }
+    }
+
+    static void blend_color_span(value_type* p, const color_type* colors, uint32_t alpha,
+                                 const uint8_t* covers, uint32_t cover, uint32_t len)
+    {
+        vector_type a = composite_vector::splat(alpha);
+        vector_type d0, d1, s0, s1, c0, c1;
+
+        c0 = c1 = composite_vector::splat(cover);
+        for (; len >= step; len -= step) {
+            composite_vector::load(p, d0, d1);
+            composite_vector::load((const uint8_t*)colors, s0, s1);
+            if (covers) {
+                composite_vector::load_covers(covers, c0, c1);
+                covers += step;
+            }
+            composite_vector::store(p, vector_op::blend(d0, premultiply(s0, a), c0),
+                                    vector_op::blend(d1, premultiply(s1, a), c1));
+            p += step << 2;
+            colors += step;
+        }
+
+        for (; len; len--) {
+            uint32_t ca = (alpha == base_mask) ? colors->a : ((colors->a * alpha + base_mask) >> base_shift);
+            CompOp::blend_pix(p, (colors->r * ca + base_mask) >> base_shift,
+                              (colors->g * ca + base_mask) >> base_shift,
+                              (colors->b * ca + base_mask) >> base_shift,
+                              ca, covers ? *covers++ : cover);
+            p += 4;
+            ++colors;
+        }
+    }
+
+private:
+    // color lanes are r, g, b, a, scale alpha and premultiply, then move to pixel order.
+    static _FORCE_INLINE_ vector_type premultiply(vector_type c, vector_type alpha)
+    {
+        vector_type ca = composite_vector::mul_div(composite_vector::template shuffle<0xFF>(c), alpha);
+        return composite_vector::template shuffle<swizzle>(
+                   composite_vector::select(composite_vector::template lane_mask<3>(), ca, composite_vector::mul_div(c, ca)));
+    }
+};
+
+#endif /*COMPOSITE_VECTOR_TYPE*/
+
+}
+#endif /*_GFX_COMPOSITE_SPAN_H_*/
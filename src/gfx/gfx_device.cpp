@@ -17,20 +17,31 @@
 #include "gfx_pixfmt_rgb.h"
 #include "gfx_pixfmt_rgb16.h"
 #include "gfx_pixfmt_gray.h"
+#include "gfx_thread_pool.h"
 
 namespace gfx {
 
-gfx_device* gfx_device::create(void)
+gfx_device* gfx_device::create(uint32_t threads)
 {
-    return new gfx_device;
+    gfx_thread_pool* pool = 0;
+#if ENABLE(MULTI_THREADS)
+    pool = gfx_thread_pool::create(threads);
+#endif
+    return new gfx_device(pool);
 }
 
-gfx_device::gfx_device()
+gfx_device::gfx_device(gfx_thread_pool* pool)
+    : m_pool(pool)
 {
 }
 
 gfx_device::~gfx_device()
 {
+#if ENABLE(MULTI_THREADS)
+    if (m_pool) {
+        delete m_pool;
+    }
+#endif
 }
 
 abstract_painter* gfx_device::create_painter(pix_fmt fmt)
@@ -38,39 +49,39 @@ abstract_painter* gfx_device::create_painter(pix_fmt fmt)
     switch (fmt) {
 #if ENABLE(FORMAT_RGBA)
         case pix_fmt_rgba:
-            return new gfx_painter<pixfmt_rgba32>;
+            return new gfx_painter<pixfmt_rgba32>(m_pool);
 #endif
 #if ENABLE(FORMAT_ARGB)
         case pix_fmt_argb:
-            return new gfx_painter<pixfmt_argb32>;
+            return new gfx_painter<pixfmt_argb32>(m_pool);
 #endif
 #if ENABLE(FORMAT_ABGR)
         case pix_fmt_abgr:
-            return new gfx_painter<pixfmt_abgr32>;
+            return new gfx_painter<pixfmt_abgr32>(m_pool);
 #endif
 #if ENABLE(FORMAT_BGRA)
         case pix_fmt_bgra:
-            return new gfx_painter<pixfmt_bgra32>;
+            return new gfx_painter<pixfmt_bgra32>(m_pool);
 #endif
 #if ENABLE(FORMAT_RGB)
         case pix_fmt_rgb:
-            return new gfx_painter<pixfmt_rgb24>;
+            return new gfx_painter<pixfmt_rgb24>(m_pool);
 #endif
 #if ENABLE(FORMAT_BGR)
         case pix_fmt_bgr:
-            return new gfx_painter<pixfmt_bgr24>;
+            return new gfx_painter<pixfmt_bgr24>(m_pool);
 #endif
 #if ENABLE(FORMAT_RGB565)
         case pix_fmt_rgb565:
-            return new gfx_painter<pixfmt_rgb565>;
+            return new gfx_painter<pixfmt_rgb565>(m_pool);
 #endif
 #if ENABLE(FORMAT_RGB555)
         case pix_fmt_rgb555:
-            return new gfx_painter<pixfmt_rgb555>;
+            return new gfx_painter<pixfmt_rgb555>(m_pool);
 #endif
 #if ENABLE(FORMAT_A8)
         case pix_fmt_gray8:
-            return new gfx_painter<pixfmt_gray8>;
+            return new gfx_painter<pixfmt_gray8>(m_pool);
 #endif
         default:
             return 0;
@@ -13,10 +13,13 @@
 
 namespace gfx {
 
+class gfx_thread_pool;
+
 class gfx_device : public device
 {
 public:
-    static gfx_device* create(void);
+    // the device renders large shapes with tiles in threads if threads more than one.
+    static gfx_device* create(uint32_t threads = 0);
     virtual ~gfx_device();
 
     virtual abstract_painter* create_painter(pix_fmt fmt);
@@ -36,8 +39,9 @@ public:
     virtual abstract_gradient_adapter* create_gradient_adapter(void);
     virtual void destroy_gradient_adapter(abstract_gradient_adapter* g);
 protected:
-    gfx_device();
-
+    gfx_device(gfx_thread_pool* pool);
+private:
+    gfx_thread_pool* m_pool;
 };
 
 }
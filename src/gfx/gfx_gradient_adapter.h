@@ -126,6 +126,11 @@ public:
     {
     }
 
+    void interpolator(interpolator_type& inter)
+    {
+        m_interpolator = &inter;
+    }
+
     void prepare(void)
     {
         // do nothing, scanline raster needed.
@@ -82,18 +82,26 @@ private:
     }
 };
 
-// filter creater
-image_filter_adapter* create_image_filter(int32_t filter)
+// filter lookup
+const image_filter_adapter* get_image_filter(int32_t filter)
 {
     switch (filter) {
-        case FILTER_BILINEAR:
-            return new image_filter<image_filter_bilinear>;
-        case FILTER_GAUSSIAN:
-            return new image_filter<image_filter_gaussian>;
-        case FILTER_BICUBIC:
-            return new image_filter<image_filter_bicubic>;
-        case FILTER_QUADRIC:
-            return new image_filter<image_filter_quadric>;
+        case FILTER_BILINEAR: {
+                static const image_filter<image_filter_bilinear> bilinear;
+                return &bilinear;
+            }
+        case FILTER_GAUSSIAN: {
+                static const image_filter<image_filter_gaussian> gaussian;
+                return &gaussian;
+            }
+        case FILTER_BICUBIC: {
+                static const image_filter<image_filter_bicubic> bicubic;
+                return &bicubic;
+            }
+        case FILTER_QUADRIC: {
+                static const image_filter<image_filter_quadric> quadric;
+                return &quadric;
+            }
         default:
             //FILTER_NEAREST: no filter
             return 0;
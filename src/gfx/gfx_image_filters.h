@@ -14,6 +14,10 @@
 
 namespace gfx {
 
+enum {
+    image_filter_max_diameter = 4, // diameter of the largest filter.
+};
+
 // image filter adapter
 class image_filter_adapter
 {
@@ -29,7 +33,7 @@ public:
     void calculate(const FilterType& filter, bool normalization = true)
     {
         scalar r = filter.radius();
-        realloc_filter_lut(r);
+        init_filter_lut(r);
         uint32_t pivot = diameter() << (image_subpixel_shift - 1);
 
         for (uint32_t i = 0; i < pivot; i++) {
@@ -103,26 +107,22 @@ private:
     image_filter_adapter(const image_filter_adapter&);
     image_filter_adapter& operator=(const image_filter_adapter&);
 
-    void realloc_filter_lut(scalar radius)
+    void init_filter_lut(scalar radius)
     {
         m_radius = radius;
         m_diameter = (uint32_t)Ceil(radius) * 2;
         m_start = -(int32_t)(m_diameter / 2 - 1);
-        uint32_t size = m_diameter << image_subpixel_shift;
-
-        if (size > m_weight_array.size()) {
-            m_weight_array.resize(size);
-        }
     }
 
     scalar m_radius;
     int32_t m_start;
     uint32_t m_diameter;
-    pod_array<int16_t> m_weight_array;
+    int16_t m_weight_array[image_filter_max_diameter << image_subpixel_shift];
 };
 
-// filter creater
-image_filter_adapter* create_image_filter(int32_t filter);
+// filter lookup, the weight table of each filter is built once and shared
+// read only by all painters. return 0 for FILTER_NEAREST.
+const image_filter_adapter* get_image_filter(int32_t filter);
 
 }
 #endif /*_GFX_IMAGE_FILTERS_H_*/
@@ -27,6 +27,8 @@
 #include "gfx_scanline_renderer.h"
 #include "gfx_scanline_storage.h"
 #include "gfx_span_generator.h"
+#include "gfx_thread_pool.h"
+#include "gfx_tile_renderer.h"
 
 namespace gfx {
 
@@ -75,16 +77,24 @@ public:
         abstract_gradient_adapter* gradient;
     };
 
-    gfx_painter()
+    gfx_painter(gfx_thread_pool* pool = 0)
         : m_fill_type(type_solid)
         , m_stroke_type(type_solid)
         , m_draw_shadow(false)
         , m_shadow_area(0, 0, 0, 0)
         , m_shadow_buffer(0)
+        , m_shadow_capacity(0)
+        , m_blur_area(0x7FFFFFFF, 0x7FFFFFFF, -0x7FFFFFFF, -0x7FFFFFFF)
+        , m_pool(pool)
     {
     }
 
-    virtual ~gfx_painter() {}
+    virtual ~gfx_painter()
+    {
+        if (m_shadow_buffer) {
+            mem_free(m_shadow_buffer);
+        }
+    }
 
     virtual void attach(abstract_rendering_buffer*);
     virtual pix_fmt pixel_format(void) const;
@@ -109,48 +119,53 @@ public:
     virtual void apply_fill(abstract_raster_adapter* raster);
     virtual void apply_text_fill(abstract_raster_adapter* rs, text_style style);
     virtual void apply_mono_text_fill(void* storage);
+    virtual void apply_fill_coverage(const byte* data, uint32_t size, int32_t x, int32_t y, const trans_affine& mtx);
     virtual void apply_clear(const rgba& c);
     virtual void apply_clip_path(const vertex_source& v, int32_t rule, const trans_affine* mtx);
     virtual void apply_clip_device(const rect_s& rc, scalar xoffset, scalar yoffset);
     virtual void clear_clip(void);
 
+    virtual bool begin_bounds(const rect_s& rc);
+    virtual void end_bounds(void);
+
     virtual void apply_masking(abstract_mask_layer*);
     virtual void clear_masking(void);
 
     virtual void apply_blur(scalar blur);
 
-    virtual bool begin_shadow(const rect_s& rc);
+    virtual bool begin_shadow(const rect_s& rc, scalar x, scalar y);
     virtual void apply_shadow(abstract_raster_adapter* rs, const rect_s& r,
                               const rgba& c, scalar x, scalar y, scalar b);
 
     virtual void copy_rect_from(abstract_rendering_buffer* src, const rect& rc, int32_t x, int32_t y);
 private:
-    void apply_fill_source(abstract_raster_adapter* raster, pix_fmt src_fmt)
+    template <typename Rasterizer>
+    void apply_fill_source(Rasterizer& ras, const trans_affine& mtx, pix_fmt src_fmt)
     {
         switch (src_fmt) {
             case pix_fmt_rgba:
-                apply_fill_impl<pixfmt_rgba32>(raster);
+                apply_fill_impl<pixfmt_rgba32>(ras, mtx);
                 break;
             case pix_fmt_argb:
-                apply_fill_impl<pixfmt_argb32>(raster);
+                apply_fill_impl<pixfmt_argb32>(ras, mtx);
                 break;
             case pix_fmt_abgr:
-                apply_fill_impl<pixfmt_abgr32>(raster);
+                apply_fill_impl<pixfmt_abgr32>(ras, mtx);
                 break;
             case pix_fmt_bgra:
-                apply_fill_impl<pixfmt_bgra32>(raster);
+                apply_fill_impl<pixfmt_bgra32>(ras, mtx);
                 break;
             case pix_fmt_rgb:
-                apply_fill_impl<pixfmt_rgb24>(raster);
+                apply_fill_impl<pixfmt_rgb24>(ras, mtx);
                 break;
             case pix_fmt_bgr:
-                apply_fill_impl<pixfmt_bgr24>(raster);
+                apply_fill_impl<pixfmt_bgr24>(ras, mtx);
                 break;
             case pix_fmt_rgb565:
-                apply_fill_impl<pixfmt_rgb565>(raster);
+                apply_fill_impl<pixfmt_rgb565>(ras, mtx);
                 break;
             case pix_fmt_rgb555:
-                apply_fill_impl<pixfmt_rgb555>(raster);
+                apply_fill_impl<pixfmt_rgb555>(ras, mtx);
                 break;
             case pix_fmt_unknown:
             default:
@@ -193,8 +208,37 @@ private:
         }
     }
 
-    template <typename Pixfmt2>
-    void apply_fill_impl(abstract_raster_adapter* raster);
+    // tiles share the clip path and mask scanline of target, they can not be rendered in threads.
+    gfx_thread_pool* tile_pool(void) const
+    {
+        return (m_rb.has_clip_path() || m_fmt.has_mask()) ? 0 : m_pool;
+    }
+
+    // area drawn since last blur.
+    void add_blur_area(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+    {
+        if (x1 < m_blur_area.x1) { m_blur_area.x1 = x1; }
+        if (y1 < m_blur_area.y1) { m_blur_area.y1 = y1; }
+        if (x2 > m_blur_area.x2) { m_blur_area.x2 = x2; }
+        if (y2 > m_blur_area.y2) { m_blur_area.y2 = y2; }
+    }
+
+    template <typename Rasterizer>
+    void add_blur_area(const Rasterizer& ras)
+    {
+        if (ras.min_x() <= ras.max_x() && ras.min_y() <= ras.max_y()) {
+            add_blur_area(ras.min_x(), ras.min_y(), ras.max_x() + 1, ras.max_y() + 1);
+        }
+    }
+
+    template <typename Rasterizer>
+    void apply_fill_raster(Rasterizer& ras, const trans_affine& ras_mtx);
+
+    template <typename Rasterizer>
+    bool apply_fill_rect(Rasterizer& ras);
+
+    template <typename Pixfmt2, typename Rasterizer>
+    void apply_fill_impl(Rasterizer& ras, const trans_affine& ras_mtx);
 
     template <typename Pixfmt2>
     void apply_stroke_impl(abstract_raster_adapter* raster);
@@ -236,15 +280,20 @@ private:
     bool m_draw_shadow;
     rect_s m_shadow_area;
     byte* m_shadow_buffer;
+    uint32_t m_shadow_capacity;
     gfx_rendering_buffer m_shadow_rb;
-    pixfmt_rgba32 m_shadow_fmt;
-    gfx_renderer<pixfmt_rgba32> m_shadow_base;
+    pixfmt_gray8 m_shadow_fmt;
+    gfx_renderer<pixfmt_gray8> m_shadow_base;
+    //blur
+    rect m_blur_area;
     //scanline storage
     gfx_scanline_p8 m_scanline_p;
     gfx_scanline_u8 m_scanline_u;
     gfx_scanline_bin m_scanline_bin;
     //span allocater
     gfx_span_allocator<color_type> m_spans;
+    //tile threads
+    gfx_thread_pool* m_pool;
 };
 
 template <typename Pixfmt>
@@ -389,6 +438,8 @@ template <typename Pixfmt>
 inline void gfx_painter<Pixfmt>::apply_stroke(abstract_raster_adapter* raster)
 {
     if (raster) {
+        add_blur_area(static_cast<gfx_raster_adapter*>(raster)->stroke_impl());
+
         switch (m_stroke_type) {
             case type_canvas:
                 apply_stroke_source(raster, m_image_stroke.format);
@@ -415,15 +466,16 @@ inline void gfx_painter<Pixfmt>::apply_stroke(abstract_raster_adapter* raster)
                     scalar st = gradient->start();
 
                     gfx_span_gradient<color_type> sg(inter, *pwr, gradient->colors(), st, len);
-                    gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->stroke_impl(),
-                                            m_scanline_u, m_rb, m_spans, sg);
+                    gfx_render_scanlines_aa_tiles(tile_pool(), static_cast<gfx_raster_adapter*>(raster)->stroke_impl(),
+                                                  m_scanline_u, m_rb, m_spans, sg, inter, m_rb.ymin(), m_rb.ymax());
                 }
                 break;
             case type_solid: // solid stroke default.
             default: {
                     renderer_solid_type ren(m_rb);
                     ren.color(m_stroke_color);
-                    gfx_render_scanlines(static_cast<gfx_raster_adapter*>(raster)->stroke_impl(), m_scanline_p, ren);
+                    gfx_render_scanlines_tiles(tile_pool(), static_cast<gfx_raster_adapter*>(raster)->stroke_impl(),
+                                               m_scanline_p, ren, m_rb.ymin(), m_rb.ymax());
                 }
         }
     }
@@ -486,15 +538,13 @@ inline void gfx_painter<Pixfmt>::apply_stroke_impl(abstract_raster_adapter* rast
                 typename painter_raster<Pixfmt2>::source_type img_src(canvas_fmt);
 
                 if (m_image_stroke.filter) {
-                    image_filter_adapter* filter = create_image_filter(m_image_stroke.filter);
+                    const image_filter_adapter* filter = get_image_filter(m_image_stroke.filter);
 
                     if (filter) {
                         typename painter_raster<Pixfmt2>::span_canvas_filter_type
                         sg(img_src, interpolator, *(filter));
                         gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->stroke_impl(),
                                                 m_scanline_u, m_rb, m_spans, sg);
-
-                        delete filter;
                     } else {
                         typename painter_raster<Pixfmt2>::span_canvas_filter_type_nn
                         sg(img_src, interpolator);
@@ -533,7 +583,7 @@ inline void gfx_painter<Pixfmt>::apply_stroke_impl(abstract_raster_adapter* rast
                 typename painter_raster<Pixfmt2>::source_type img_src(img_fmt);
 
                 if (m_image_stroke.filter) {
-                    image_filter_adapter* filter = create_image_filter(m_image_stroke.filter);
+                    const image_filter_adapter* filter = get_image_filter(m_image_stroke.filter);
 
                     if (filter) {
                         if (transparent) {
@@ -547,8 +597,6 @@ inline void gfx_painter<Pixfmt>::apply_stroke_impl(abstract_raster_adapter* rast
                             gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->stroke_impl(),
                                                     m_scanline_u, m_rb, m_spans, sg);
                         }
-
-                        delete filter;
                     } else {
                         if (transparent) {
                             typename painter_raster<Pixfmt2>::span_canvas_filter_type_nn
@@ -596,7 +644,7 @@ inline void gfx_painter<Pixfmt>::apply_stroke_impl(abstract_raster_adapter* rast
                     pattern_wrap(m_pattern_stroke.xtype, m_pattern_stroke.ytype, pattern_fmt);
 
                 if (m_pattern_stroke.filter) {
-                    image_filter_adapter* filter = create_image_filter(m_pattern_stroke.filter);
+                    const image_filter_adapter* filter = get_image_filter(m_pattern_stroke.filter);
 
                     if (filter) {
                         if (transparent) {
@@ -610,8 +658,6 @@ inline void gfx_painter<Pixfmt>::apply_stroke_impl(abstract_raster_adapter* rast
                             gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->stroke_impl(),
                                                     m_scanline_u, m_rb, m_spans, sg);
                         }
-
-                        delete filter;
                     } else {
                         if (transparent) {
                             typename painter_raster<Pixfmt2>::span_canvas_pattern_type_nn
@@ -650,8 +696,8 @@ inline void gfx_painter<Pixfmt>::apply_stroke_impl(abstract_raster_adapter* rast
     }
 }
 
-template <typename Pixfmt> template <typename Pixfmt2>
-inline void gfx_painter<Pixfmt>::apply_fill_impl(abstract_raster_adapter* raster)
+template <typename Pixfmt> template <typename Pixfmt2, typename Rasterizer>
+inline void gfx_painter<Pixfmt>::apply_fill_impl(Rasterizer& ras, const trans_affine& ras_mtx)
 {
     typedef gfx_pixfmt_wrapper<Pixfmt2, mask_type> pixfmt2;
 
@@ -662,7 +708,7 @@ inline void gfx_painter<Pixfmt>::apply_fill_impl(abstract_raster_adapter* raster
                 rect_s dr = m_image_source.rect;
                 trans_affine mtx;
                 mtx *= trans_affine_translation(sround(dr.x()), sround(dr.y()));
-                mtx *= stable_matrix(static_cast<gfx_raster_adapter*>(raster)->transformation());
+                mtx *= stable_matrix(ras_mtx);
                 mtx.invert();
 
                 gfx_span_interpolator_linear interpolator(mtx);
@@ -670,25 +716,23 @@ inline void gfx_painter<Pixfmt>::apply_fill_impl(abstract_raster_adapter* raster
                 typename painter_raster<Pixfmt2>::source_type img_src(canvas_fmt);
 
                 if (m_image_source.filter) {
-                    image_filter_adapter* filter = create_image_filter(m_image_source.filter);
+                    const image_filter_adapter* filter = get_image_filter(m_image_source.filter);
 
                     if (filter) {
                         typename painter_raster<Pixfmt2>::span_canvas_filter_type
                         sg(img_src, interpolator, *(filter));
-                        gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                        gfx_render_scanlines_aa(ras,
                                                 m_scanline_u, m_rb, m_spans, sg);
-
-                        delete filter;
                     } else {
                         typename painter_raster<Pixfmt2>::span_canvas_filter_type_nn
                         sg(img_src, interpolator);
-                        gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                        gfx_render_scanlines_aa(ras,
                                                 m_scanline_u, m_rb, m_spans, sg);
                     }
                 } else {
                     typename painter_raster<Pixfmt2>::span_canvas_filter_type_nn
                     sg(img_src, interpolator);
-                    gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                    gfx_render_scanlines_aa(ras,
                                             m_scanline_u, m_rb, m_spans, sg);
                 }
             }
@@ -709,7 +753,7 @@ inline void gfx_painter<Pixfmt>::apply_fill_impl(abstract_raster_adapter* raster
                 trans_affine mtx;
                 mtx *= trans_affine_scaling(xs, ys);
                 mtx *= trans_affine_translation(sround(dr.x()), sround(dr.y()));
-                mtx *= stable_matrix(static_cast<gfx_raster_adapter*>(raster)->transformation());
+                mtx *= stable_matrix(ras_mtx);
                 mtx.invert();
 
                 gfx_span_interpolator_linear interpolator(mtx);
@@ -717,32 +761,30 @@ inline void gfx_painter<Pixfmt>::apply_fill_impl(abstract_raster_adapter* raster
                 typename painter_raster<Pixfmt2>::source_type img_src(img_fmt);
 
                 if (m_image_source.filter) {
-                    image_filter_adapter* filter = create_image_filter(m_image_source.filter);
+                    const image_filter_adapter* filter = get_image_filter(m_image_source.filter);
 
                     if (filter) {
                         if (transparent) {
                             typename painter_raster<Pixfmt2>::span_canvas_filter_type
                             sg(img_src, interpolator, *(filter));
-                            gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                            gfx_render_scanlines_aa(ras,
                                                     m_scanline_u, m_rb, m_spans, sg);
                         } else {
                             typename painter_raster<Pixfmt2>::span_image_filter_type
                             sg(img_src, interpolator, *(filter));
-                            gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                            gfx_render_scanlines_aa(ras,
                                                     m_scanline_u, m_rb, m_spans, sg);
                         }
-
-                        delete filter;
                     } else {
                         if (transparent) {
                             typename painter_raster<Pixfmt2>::span_canvas_filter_type_nn
                             sg(img_src, interpolator);
-                            gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                            gfx_render_scanlines_aa(ras,
                                                     m_scanline_u, m_rb, m_spans, sg);
                         } else {
                             typename painter_raster<Pixfmt2>::span_image_filter_type_nn
                             sg(img_src, interpolator);
-                            gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                            gfx_render_scanlines_aa(ras,
                                                     m_scanline_u, m_rb, m_spans, sg);
                         }
                     }
@@ -750,12 +792,12 @@ inline void gfx_painter<Pixfmt>::apply_fill_impl(abstract_raster_adapter* raster
                     if (transparent) {
                         typename painter_raster<Pixfmt2>::span_canvas_filter_type_nn
                         sg(img_src, interpolator);
-                        gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                        gfx_render_scanlines_aa(ras,
                                                 m_scanline_u, m_rb, m_spans, sg);
                     } else {
                         typename painter_raster<Pixfmt2>::span_image_filter_type_nn
                         sg(img_src, interpolator);
-                        gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                        gfx_render_scanlines_aa(ras,
                                                 m_scanline_u, m_rb, m_spans, sg);
                     }
                 }
@@ -771,7 +813,7 @@ inline void gfx_painter<Pixfmt>::apply_fill_impl(abstract_raster_adapter* raster
                 trans_affine mtx;
                 mtx = *(m_pattern_source.matrix);
                 mtx *= trans_affine_translation(sround(dr.x()), sround(dr.y()));
-                mtx *= stable_matrix(static_cast<gfx_raster_adapter*>(raster)->transformation());
+                mtx *= stable_matrix(ras_mtx);
                 mtx.invert();
 
                 gfx_span_interpolator_linear interpolator(mtx);
@@ -780,32 +822,30 @@ inline void gfx_painter<Pixfmt>::apply_fill_impl(abstract_raster_adapter* raster
                     pattern_wrap(m_pattern_source.xtype, m_pattern_source.ytype, pattern_fmt);
 
                 if (m_pattern_source.filter) {
-                    image_filter_adapter* filter = create_image_filter(m_pattern_source.filter);
+                    const image_filter_adapter* filter = get_image_filter(m_pattern_source.filter);
 
                     if (filter) {
                         if (transparent) {
                             typename painter_raster<Pixfmt2>::span_canvas_pattern_type
                             sg(*pattern, interpolator, *(filter));
-                            gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                            gfx_render_scanlines_aa(ras,
                                                     m_scanline_u, m_rb, m_spans, sg);
                         } else {
                             typename painter_raster<Pixfmt2>::span_image_pattern_type
                             sg(*pattern, interpolator, *(filter));
-                            gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                            gfx_render_scanlines_aa(ras,
                                                     m_scanline_u, m_rb, m_spans, sg);
                         }
-
-                        delete filter;
                     } else {
                         if (transparent) {
                             typename painter_raster<Pixfmt2>::span_canvas_pattern_type_nn
                             sg(*pattern, interpolator);
-                            gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                            gfx_render_scanlines_aa(ras,
                                                     m_scanline_u, m_rb, m_spans, sg);
                         } else {
                             typename painter_raster<Pixfmt2>::span_image_pattern_type_nn
                             sg(*pattern, interpolator);
-                            gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                            gfx_render_scanlines_aa(ras,
                                                     m_scanline_u, m_rb, m_spans, sg);
                         }
                     }
@@ -813,12 +853,12 @@ inline void gfx_painter<Pixfmt>::apply_fill_impl(abstract_raster_adapter* raster
                     if (transparent) {
                         typename painter_raster<Pixfmt2>::span_canvas_pattern_type_nn
                         sg(*pattern, interpolator);
-                        gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                        gfx_render_scanlines_aa(ras,
                                                 m_scanline_u, m_rb, m_spans, sg);
                     } else {
                         typename painter_raster<Pixfmt2>::span_image_pattern_type_nn
                         sg(*pattern, interpolator);
-                        gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
+                        gfx_render_scanlines_aa(ras,
                                                 m_scanline_u, m_rb, m_spans, sg);
                     }
                 }
@@ -834,47 +874,96 @@ inline void gfx_painter<Pixfmt>::apply_fill_impl(abstract_raster_adapter* raster
     }
 }
 
-template <typename Pixfmt>
-inline void gfx_painter<Pixfmt>::apply_fill(abstract_raster_adapter* raster)
+template <typename Pixfmt> template <typename Rasterizer>
+inline void gfx_painter<Pixfmt>::apply_fill_raster(Rasterizer& ras, const trans_affine& ras_mtx)
 {
-    if (raster) {
-        switch (m_fill_type) {
-            case type_canvas:
-                apply_fill_source(raster, m_image_source.format);
-                break;
-            case type_image:
-                apply_fill_source(raster, m_image_source.format);
-                break;
-            case type_pattern:
-                apply_fill_source(raster, m_pattern_source.format);
-                break;
-            case type_gradient: {
-                    gfx_gradient_adapter* gradient = static_cast<gfx_gradient_adapter*>(m_gradient_source.gradient);
-                    gradient->build();
+    add_blur_area(ras);
 
-                    trans_affine mtx;
-                    mtx = gradient->matrix();
-                    mtx *= stable_matrix(static_cast<gfx_raster_adapter*>(raster)->transformation());
-                    mtx.invert();
+    switch (m_fill_type) {
+        case type_canvas:
+            apply_fill_source(ras, ras_mtx, m_image_source.format);
+            break;
+        case type_image:
+            apply_fill_source(ras, ras_mtx, m_image_source.format);
+            break;
+        case type_pattern:
+            apply_fill_source(ras, ras_mtx, m_pattern_source.format);
+            break;
+        case type_gradient: {
+                gfx_gradient_adapter* gradient = static_cast<gfx_gradient_adapter*>(m_gradient_source.gradient);
+                gradient->build();
 
-                    gfx_span_interpolator_linear inter(mtx);
+                trans_affine mtx;
+                mtx = gradient->matrix();
+                mtx *= stable_matrix(ras_mtx);
+                mtx.invert();
 
-                    gfx_gradient_wrapper* pwr = gradient->wrapper();
-                    scalar len = gradient->length();
-                    scalar st = gradient->start();
+                gfx_span_interpolator_linear inter(mtx);
 
-                    gfx_span_gradient<color_type> sg(inter, *pwr, gradient->colors(), st, len);
-                    gfx_render_scanlines_aa(static_cast<gfx_raster_adapter*>(raster)->fill_impl(),
-                                            m_scanline_u, m_rb, m_spans, sg);
-                }
-                break;
-            case type_solid: // solid fill default.
-            default: {
-                    renderer_solid_type ren(m_rb);
-                    ren.color(m_fill_color);
-                    gfx_render_scanlines(static_cast<gfx_raster_adapter*>(raster)->fill_impl(), m_scanline_p, ren);
-                }
+                gfx_gradient_wrapper* pwr = gradient->wrapper();
+                scalar len = gradient->length();
+                scalar st = gradient->start();
+
+                gfx_span_gradient<color_type> sg(inter, *pwr, gradient->colors(), st, len);
+                gfx_render_scanlines_aa_tiles(tile_pool(), ras,
+                                              m_scanline_u, m_rb, m_spans, sg, inter, m_rb.ymin(), m_rb.ymax());
+            }
+            break;
+        case type_solid: // solid fill default.
+        default: {
+                renderer_solid_type ren(m_rb);
+                ren.color(m_fill_color);
+                gfx_render_scanlines_tiles(tile_pool(), ras,
+                                           m_scanline_p, ren, m_rb.ymin(), m_rb.ymax());
+            }
+    }
+}
+
+template <typename Pixfmt> template <typename Rasterizer>
+inline bool gfx_painter<Pixfmt>::apply_fill_rect(Rasterizer& ras)
+{
+    // solid rectangle on pixel boundaries is filled by rows, without scanlines.
+    int32_t x1, y1, x2, y2;
+    uint32_t alpha;
+    if (!ras.pixel_rectangle(&x1, &y1, &x2, &y2, &alpha)) {
+        return false;
+    }
+
+    if (tile_pool() && (int64_t)(x2 - x1) * (y2 - y1) >= tile_min_pixels) {
+        return false; // large one is filled by tiles in threads.
+    }
+
+    add_blur_area(ras);
+
+    if (alpha) {
+        color_type c(m_fill_color);
+        int32_t y = Max(y1, m_rb.ymin());
+        int32_t ye = Min(y2 - 1, m_rb.ymax());
+        for (; y <= ye; y++) {
+            m_rb.blend_hline(x1, y, x2 - 1, c, (uint8_t)alpha);
+        }
+    }
+    return true;
+}
+
+template <typename Pixfmt>
+inline void gfx_painter<Pixfmt>::apply_fill(abstract_raster_adapter* raster)
+{
+    if (raster) {
+        gfx_raster_adapter* rs = static_cast<gfx_raster_adapter*>(raster);
+        if ((m_fill_type == type_solid) && apply_fill_rect(rs->fill_impl())) {
+            return;
         }
+        apply_fill_raster(rs->fill_impl(), rs->transformation());
+    }
+}
+
+template <typename Pixfmt>
+inline void gfx_painter<Pixfmt>::apply_fill_coverage(const byte* data, uint32_t size, int32_t x, int32_t y, const trans_affine& mtx)
+{
+    gfx_serialized_scanlines_adaptor_aa_u8 ras(data, size, INT_TO_SCALAR(x), INT_TO_SCALAR(y));
+    if (ras.rewind_scanlines()) {
+        apply_fill_raster(ras, mtx);
     }
 }
 
@@ -913,11 +1002,19 @@ template <typename Pixfmt>
 inline void gfx_painter<Pixfmt>::apply_blur(scalar blur)
 {
     if (blur > 0) {
-        m_fmt.alpha(FLT_TO_SCALAR(1.0f));
-        m_fmt.blend_op(comp_op_src_over);
-        stack_blur<rgba8> b;
-        b.blur(m_fmt, uround(blur * FLT_TO_SCALAR(40.0f)));
+        // only the area drawn since last blur and its blur radius is changed.
+        uint32_t radius = uround(blur * FLT_TO_SCALAR(40.0f));
+        rect rc(m_blur_area.x1 - (int32_t)radius, m_blur_area.y1 - (int32_t)radius,
+                m_blur_area.x2 + (int32_t)radius, m_blur_area.y2 + (int32_t)radius);
+
+        if (rc.clip(rect(0, 0, (int32_t)m_fmt.width(), (int32_t)m_fmt.height()))) {
+            m_fmt.alpha(FLT_TO_SCALAR(1.0f));
+            m_fmt.blend_op(comp_op_src_over);
+            stack_blur_area(tile_pool(), m_fmt, rc, radius, rgba8(0, 0, 0, 0));
+        }
     }
+
+    m_blur_area = rect(0x7FFFFFFF, 0x7FFFFFFF, -0x7FFFFFFF, -0x7FFFFFFF);
 }
 
 template <typename Pixfmt>
@@ -930,6 +1027,29 @@ inline void gfx_painter<Pixfmt>::clear_clip(void)
     }
 }
 
+template <typename Pixfmt>
+inline bool gfx_painter<Pixfmt>::begin_bounds(const rect_s& rc)
+{
+    const rect& cb = m_rb.clip_rect();
+    if ((cb.x1 > cb.x2) || (cb.y1 > cb.y2)
+        || (rc.x2 < INT_TO_SCALAR(cb.x1)) || (rc.y2 < INT_TO_SCALAR(cb.y1))
+        || (rc.x1 >= INT_TO_SCALAR(cb.x2 + 1)) || (rc.y1 >= INT_TO_SCALAR(cb.y2 + 1))) {
+        return false;
+    }
+
+    // trivial accept, all spans are in the clip box.
+    m_rb.set_inside(!m_rb.has_clip_path()
+                    && (rc.x1 >= INT_TO_SCALAR(cb.x1)) && (rc.y1 >= INT_TO_SCALAR(cb.y1))
+                    && (rc.x2 < INT_TO_SCALAR(cb.x2 + 1)) && (rc.y2 < INT_TO_SCALAR(cb.y2 + 1)));
+    return true;
+}
+
+template <typename Pixfmt>
+inline void gfx_painter<Pixfmt>::end_bounds(void)
+{
+    m_rb.set_inside(false);
+}
+
 template <typename Pixfmt>
 inline void gfx_painter<Pixfmt>::apply_masking(abstract_mask_layer* m)
 {
@@ -943,21 +1063,48 @@ inline void gfx_painter<Pixfmt>::clear_masking(void)
 }
 
 template <typename Pixfmt>
-inline bool gfx_painter<Pixfmt>::begin_shadow(const rect_s& rc)
+inline bool gfx_painter<Pixfmt>::begin_shadow(const rect_s& rc, scalar x, scalar y)
 {
+    // shadow layer is blended to target without clip.
+    if ((rc.x2 + x < INT_TO_SCALAR(-1)) || (rc.y2 + y < INT_TO_SCALAR(-1))
+        || (rc.x1 + x > INT_TO_SCALAR(m_fmt.width() + 1)) || (rc.y1 + y > INT_TO_SCALAR(m_fmt.height() + 1))) {
+        return false;
+    }
+
     m_draw_shadow = true;
     m_shadow_area = rc;
 
+    // shadow is a single color, only the coverage is kept in a8 layer.
     uint32_t w = uround(rc.x2 - rc.x1);
     uint32_t h = uround(rc.y2 - rc.y1);
-    m_shadow_buffer = (byte*)mem_calloc(1, h * w * 4);
+    uint32_t size = w * h;
+
+    if (size > m_shadow_capacity) {
+        // layer buffer grows geometrically and is reused by later shadows.
+        uint32_t capacity = Max(size, m_shadow_capacity << 1);
+        byte* buffer = (byte*)mem_malloc(capacity);
+
+        if (!buffer) {
+            m_draw_shadow = false;
+            return false;
+        }
+
+        if (m_shadow_buffer) {
+            mem_free(m_shadow_buffer);
+        }
+        m_shadow_buffer = buffer;
+        m_shadow_capacity = capacity;
+    }
 
     if (!m_shadow_buffer) {
         m_draw_shadow = false;
         return false;
     }
 
-    m_shadow_rb.init(m_shadow_buffer, w, h, w * 4);
+    // only the part used by this layer needs to be cleared.
+    memset(m_shadow_buffer, 0, size);
+
+    m_shadow_rb.init(m_shadow_buffer, w, h, w);
     m_shadow_fmt.attach(m_shadow_rb);
     m_shadow_base.attach(m_shadow_fmt);
 
@@ -970,8 +1117,8 @@ inline void gfx_painter<Pixfmt>::apply_shadow(abstract_raster_adapter* rs,
 {
     gfx_raster_adapter* ras = static_cast<gfx_raster_adapter*>(rs);
 
-    gfx_renderer_scanline_aa_solid<gfx_renderer<pixfmt_rgba32> > ren(m_shadow_base);
-    ren.color(c);
+    gfx_renderer_scanline_aa_solid<gfx_renderer<pixfmt_gray8> > ren(m_shadow_base);
+    ren.color(rgba(FLT_TO_SCALAR(1.0f), FLT_TO_SCALAR(1.0f), FLT_TO_SCALAR(1.0f), c.a));
 
     if (ras->raster_method() & raster_fill) {
         gfx_render_scanlines(ras->fill_impl(), m_scanline_p, ren);
@@ -982,20 +1129,20 @@ inline void gfx_painter<Pixfmt>::apply_shadow(abstract_raster_adapter* rs,
     }
 
     if (blur > FLT_TO_SCALAR(0.0f)) {
-        stack_blur<rgba8> b;
-        b.set_shading(rgba8(c));
-        b.blur(m_shadow_fmt, uround(blur * FLT_TO_SCALAR(40.0f)));
+        pixfmt_alpha8_view<pixfmt_gray8> layer(m_shadow_fmt);
+        alpha8 shading = { 0 };
+        rect rc(0, 0, (int32_t)m_shadow_fmt.width(), (int32_t)m_shadow_fmt.height());
+        stack_blur_area(m_pool, layer, rc, uround(blur * FLT_TO_SCALAR(40.0f)), shading);
     }
 
     //Note: shadow need a no clip render base.
     renderer_base_type rb(m_fmt);
     //blend shadow layer to base.
-    rb.blend_from(m_shadow_fmt, 0, iround(x + r.x1), iround(y + r.y1));
+    int32_t dx = iround(x + r.x1);
+    int32_t dy = iround(y + r.y1);
+    rb.blend_from_color(m_shadow_fmt, rgba(c.r, c.g, c.b), 0, dx, dy);
+    add_blur_area(dx, dy, dx + (int32_t)m_shadow_fmt.width(), dy + (int32_t)m_shadow_fmt.height());
 
-    if (m_shadow_buffer) {
-        mem_free(m_shadow_buffer);
-        m_shadow_buffer = 0;
-    }
     m_draw_shadow = false;
 }
 
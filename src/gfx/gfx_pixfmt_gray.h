@@ -41,6 +41,25 @@ public:
                                ca, cover);
     }
 
+    static _FORCE_INLINE_ void blend_solid_span(uint32_t op, pixel_type* p,
+                                                uint32_t cr, uint32_t cg, uint32_t cb, uint32_t ca,
+                                                const uint8_t* covers, uint32_t cover, uint32_t len)
+    {
+        blend_span_table_packed<color_type, order_type, blend_op_adaptor_gray<rgba8> >::g_packed_solid_span_func[op]
+        (p, (cr * ca + base_mask) >> base_shift,
+         (cg * ca + base_mask) >> base_shift,
+         (cb * ca + base_mask) >> base_shift,
+         ca, covers, cover, len);
+    }
+
+    static _FORCE_INLINE_ void blend_color_span(uint32_t op, pixel_type* p,
+                                                const color_type* colors, uint32_t alpha,
+                                                const uint8_t* covers, uint32_t cover, uint32_t len)
+    {
+        blend_span_table_packed<color_type, order_type, blend_op_adaptor_gray<rgba8> >::g_packed_color_span_func[op]
+        (p, colors, alpha, covers, cover, len);
+    }
+
     static pixel_type make_pix(uint32_t r, uint32_t g, uint32_t b)
     {
         return pixel_type((55u * r + 184u * g + 18u * b) >> 8);
@@ -1567,6 +1567,7 @@ public:
         const src_value_type* psrc = (src_value_type*)from.row_ptr(ysrc);
         _REGISTER_ value_type alpha = (value_type)alpha_mul(color.a, m_alpha_factor);
         if (psrc) {
+            psrc += xsrc;
             value_type* pdst = (value_type*)m_buffer->row_ptr(xdst, ydst, len) + xdst * 3;
 
             do {
@@ -1586,6 +1587,7 @@ public:
         typedef typename SrcPixelFormatRenderer::value_type src_value_type;
         const src_value_type* psrc = (src_value_type*)from.row_ptr(ysrc);
         if (psrc) {
+            psrc += xsrc;
             value_type* pdst = (value_type*)m_buffer->row_ptr(xdst, ydst, len) + xdst * 3;
 
             do {
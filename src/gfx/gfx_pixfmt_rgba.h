@@ -9,6 +9,7 @@
 
 #include "common.h"
 #include "gfx_rendering_buffer.h"
+#include "gfx_composite_span.h"
 
 namespace gfx {
 
@@ -1324,6 +1325,107 @@ blend_op_table_rgba<ColorType, Order>::g_rgba_blend_op_func[] = {
     0
 };
 
+// span composite table for blend rgba pixel format.
+template <typename ColorType, typename Order>
+struct blend_span_table_rgba {
+    typedef typename ColorType::value_type value_type;
+    typedef void (*solid_span_func_type)(value_type* p,
+                                         uint32_t cr,
+                                         uint32_t cg,
+                                         uint32_t cb,
+                                         uint32_t ca,
+                                         const uint8_t* covers,
+                                         uint32_t cover,
+                                         uint32_t len);
+    typedef void (*color_span_func_type)(value_type* p,
+                                         const ColorType* colors,
+                                         uint32_t alpha,
+                                         const uint8_t* covers,
+                                         uint32_t cover,
+                                         uint32_t len);
+
+    static solid_span_func_type g_rgba_solid_span_func[];
+    static color_span_func_type g_rgba_color_span_func[];
+};
+
+// g_rgba_solid_span_func
+template <typename ColorType, typename Order>
+typename blend_span_table_rgba<ColorType, Order>::solid_span_func_type
+blend_span_table_rgba<ColorType, Order>::g_rgba_solid_span_func[] = {
+    composite_span_rgba<comp_op_clear, composite_op_rgba_clear<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_src, composite_op_rgba_src<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_src_over, composite_op_rgba_src_over<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_src_in, composite_op_rgba_src_in<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_src_out, composite_op_rgba_src_out<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_src_atop, composite_op_rgba_src_atop<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_dst, composite_op_rgba_dst<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_dst_over, composite_op_rgba_dst_over<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_dst_in, composite_op_rgba_dst_in<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_dst_out, composite_op_rgba_dst_out<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_dst_atop, composite_op_rgba_dst_atop<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_xor, composite_op_rgba_xor<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_darken, composite_op_rgba_darken<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_lighten, composite_op_rgba_lighten<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_overlay, composite_op_rgba_overlay<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_screen, composite_op_rgba_screen<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_multiply, composite_op_rgba_multiply<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_plus, composite_op_rgba_plus<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_minus, composite_op_rgba_minus<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_exclusion, composite_op_rgba_exclusion<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_difference, composite_op_rgba_difference<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_soft_light, composite_op_rgba_soft_light<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_hard_light, composite_op_rgba_hard_light<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_color_burn, composite_op_rgba_color_burn<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_color_dodge, composite_op_rgba_color_dodge<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_contrast, composite_op_rgba_contrast<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_invert, composite_op_rgba_invert<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_invert_rgb, composite_op_rgba_invert_rgb<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_hue, composite_op_rgba_hue<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_saturation, composite_op_rgba_saturation<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_color, composite_op_rgba_color<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    composite_span_rgba<comp_op_luminosity, composite_op_rgba_luminosity<ColorType, Order>, ColorType, Order>::blend_solid_span,
+    0
+};
+
+// g_rgba_color_span_func
+template <typename ColorType, typename Order>
+typename blend_span_table_rgba<ColorType, Order>::color_span_func_type
+blend_span_table_rgba<ColorType, Order>::g_rgba_color_span_func[] = {
+    composite_span_rgba<comp_op_clear, composite_op_rgba_clear<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_src, composite_op_rgba_src<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_src_over, composite_op_rgba_src_over<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_src_in, composite_op_rgba_src_in<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_src_out, composite_op_rgba_src_out<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_src_atop, composite_op_rgba_src_atop<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_dst, composite_op_rgba_dst<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_dst_over, composite_op_rgba_dst_over<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_dst_in, composite_op_rgba_dst_in<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_dst_out, composite_op_rgba_dst_out<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_dst_atop, composite_op_rgba_dst_atop<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_xor, composite_op_rgba_xor<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_darken, composite_op_rgba_darken<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_lighten, composite_op_rgba_lighten<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_overlay, composite_op_rgba_overlay<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_screen, composite_op_rgba_screen<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_multiply, composite_op_rgba_multiply<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_plus, composite_op_rgba_plus<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_minus, composite_op_rgba_minus<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_exclusion, composite_op_rgba_exclusion<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_difference, composite_op_rgba_difference<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_soft_light, composite_op_rgba_soft_light<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_hard_light, composite_op_rgba_hard_light<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_color_burn, composite_op_rgba_color_burn<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_color_dodge, composite_op_rgba_color_dodge<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_contrast, composite_op_rgba_contrast<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_invert, composite_op_rgba_invert<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_invert_rgb, composite_op_rgba_invert_rgb<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_hue, composite_op_rgba_hue<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_saturation, composite_op_rgba_saturation<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_color, composite_op_rgba_color<ColorType, Order>, ColorType, Order>::blend_color_span,
+    composite_span_rgba<comp_op_luminosity, composite_op_rgba_luminosity<ColorType, Order>, ColorType, Order>::blend_color_span,
+    0
+};
+
 // blend operate adaptor for rgba
 template <typename ColorType, typename Order>
 class blend_op_adaptor_rgba
@@ -1348,6 +1450,25 @@ public:
          (cb * ca + base_mask) >> base_shift,
          ca, cover);
     }
+
+    static _FORCE_INLINE_ void blend_solid_span(uint32_t op, value_type* p,
+                                                uint32_t cr, uint32_t cg, uint32_t cb, uint32_t ca,
+                                                const uint8_t* covers, uint32_t cover, uint32_t len)
+    {
+        blend_span_table_rgba<ColorType, Order>::g_rgba_solid_span_func[op]
+        (p, (cr * ca + base_mask) >> base_shift,
+         (cg * ca + base_mask) >> base_shift,
+         (cb * ca + base_mask) >> base_shift,
+         ca, covers, cover, len);
+    }
+
+    static _FORCE_INLINE_ void blend_color_span(uint32_t op, value_type* p,
+                                                const color_type* colors, uint32_t alpha,
+                                                const uint8_t* covers, uint32_t cover, uint32_t len)
+    {
+        blend_span_table_rgba<ColorType, Order>::g_rgba_color_span_func[op]
+        (p, colors, alpha, covers, cover, len);
+    }
 };
 
 // pixfmt blender rgba
@@ -1483,10 +1604,7 @@ public:
                 p += 4;
             } while (--len);
         } else {
-            do {
-                blender_type::blend_pix(m_blend_op, p, c.r, c.g, c.b, alpha, cover);
-                p += 4;
-            } while (--len);
+            blender_type::blend_solid_span(m_blend_op, p, c.r, c.g, c.b, alpha, 0, cover, len);
         }
     }
 
@@ -1504,11 +1622,7 @@ public:
     {
         value_type* p = (value_type*)m_buffer->row_ptr(x, y, len) + (x << 2);
         _REGISTER_ value_type alpha = (value_type)alpha_mul(c.a, m_alpha_factor);
-        do {
-            blender_type::blend_pix(m_blend_op,
-                                    p, c.r, c.g, c.b, alpha, *covers++);
-            p += 4;
-        } while (--len);
+        blender_type::blend_solid_span(m_blend_op, p, c.r, c.g, c.b, alpha, covers, 0, len);
     }
 
     void blend_solid_vspan(int32_t x, int32_t y, uint32_t len, const color_type& c, const uint8_t* covers)
@@ -1550,16 +1664,7 @@ public:
                            const color_type* colors, const uint8_t* covers, uint8_t cover)
     {
         value_type* p = (value_type*)m_buffer->row_ptr(x, y, len) + (x << 2);
-        do {
-            blender_type::blend_pix(m_blend_op, p,
-                                    colors->r,
-                                    colors->g,
-                                    colors->b,
-                                    (value_type)alpha_mul(colors->a, m_alpha_factor),
-                                    covers ? *covers++ : cover);
-            p += 4;
-            ++colors;
-        } while (--len);
+        blender_type::blend_color_span(m_blend_op, p, colors, m_alpha_factor, covers, cover, len);
     }
 
     void blend_color_vspan(int32_t x, int32_t y, uint32_t len,
@@ -1660,6 +1765,7 @@ public:
         const src_value_type* psrc = (src_value_type*)from.row_ptr(ysrc);
         _REGISTER_ value_type alpha = (value_type)alpha_mul(color.a, m_alpha_factor);
         if (psrc) {
+            psrc += xsrc;
             value_type* pdst = (value_type*)m_buffer->row_ptr(xdst, ydst, len) + (xdst << 2);
 
             do {
@@ -1679,6 +1785,7 @@ public:
         typedef typename SrcPixelFormatRenderer::value_type src_value_type;
         const src_value_type* psrc = (src_value_type*)from.row_ptr(ysrc);
         if (psrc) {
+            psrc += xsrc;
             value_type* pdst = (value_type*)m_buffer->row_ptr(xdst, ydst, len) + (xdst << 2);
 
             do {
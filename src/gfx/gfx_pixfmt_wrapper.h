@@ -94,6 +94,11 @@ public:
         m_colorkey = color;
     }
 
+    bool has_mask() const
+    {
+        return use_mask;
+    }
+
     bool is_color_mask() const
     {
         return m_colors && m_colors->size();
@@ -536,6 +541,13 @@ public:
         m_fmt.blend_point_from(from, xdst, ydst, xsrc, ysrc, cover);
     }
 
+    template <class SrcPixelFormatRenderer>
+    void blend_from_color(const SrcPixelFormatRenderer& from, const color_type& color,
+                          int32_t xdst, int32_t ydst, int32_t xsrc, int32_t ysrc, uint32_t len, cover_type cover)
+    {
+        m_fmt.blend_from_color(from, color, xdst, ydst, xsrc, ysrc, len, cover);
+    }
+
 private:
     bool use_mask;
     rgba8* m_colorkey;
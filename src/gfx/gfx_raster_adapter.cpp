@@ -7,9 +7,13 @@
 #include "common.h"
 #include "convert.h"
 #include "matrix.h"
+#include "path_cache.h"
 
 #include "gfx_gamma_function.h"
 #include "gfx_raster_adapter.h"
+#include "gfx_scanline.h"
+#include "gfx_scanline_renderer.h"
+#include "gfx_scanline_storage.h"
 
 #include "picasso_raster_adapter.h"
 
@@ -26,6 +30,7 @@ public:
 
     gfx_raster_adapter_impl()
         : m_source(0)
+        , m_cache(0)
         , m_transform(0)
         , m_method(raster_fill)
         , m_antialias(true)
@@ -39,6 +44,7 @@ public:
         , m_line_join(miter_join)
         , m_inner_join(inner_miter)
         , m_filling_rule(fill_non_zero)
+        , m_convex(false)
     {
         for (int32_t i = 0; i < aa_scale; i++) {
             m_gamma[i] = i;
@@ -53,6 +59,7 @@ public:
     void reset(void)
     {
         m_source = 0;
+        m_cache = 0;
         m_transform = 0;
         m_method = raster_fill;
         m_antialias = true;
@@ -66,6 +73,7 @@ public:
         m_line_join = miter_join;
         m_inner_join = inner_miter;
         m_filling_rule = fill_non_zero;
+        m_convex = false;
     }
 
     template <typename GammaFunc>
@@ -77,6 +85,7 @@ public:
     }
 
     const vertex_source* m_source;
+    path_cache* m_cache;
     const trans_affine* m_transform;
     uint32_t m_method;
     bool m_antialias;
@@ -92,8 +101,11 @@ public:
     inner_join m_inner_join;
     //fill attributes
     filling_rule m_filling_rule;
+    bool m_convex;
     // gamma table
     int32_t m_gamma[aa_scale];
+    // coverage storage
+    gfx_scanline_storage_aa_u8 m_coverage;
 };
 
 gfx_raster_adapter::gfx_raster_adapter()
@@ -198,6 +210,9 @@ void gfx_raster_adapter::set_fill_attr(int32_t idx, int32_t val)
         case FIA_FILL_RULE:
             m_impl->m_filling_rule = (filling_rule)val;
             break;
+        case FIA_CONVEX:
+            m_impl->m_convex = val ? true : false;
+            break;
         default:
             break;
     }
@@ -208,59 +223,122 @@ bool gfx_raster_adapter::is_empty(void)
     return m_sraster.initial() && m_fraster.initial();
 }
 
-void gfx_raster_adapter::setup_stroke_raster(void)
+template <typename Output>
+static void _stroke_source(const gfx_raster_adapter_impl* impl, vertex_source& vs, Output& out)
 {
-    if (m_impl->m_dashline) {
-        picasso::conv_dash c(*const_cast<vertex_source*>(m_impl->m_source));
+    if (impl->m_dashline) {
+        picasso::conv_dash c(vs);
 
-        for (uint32_t i = 0; i < m_impl->m_dash_num; i += 2) {
-            c.add_dash(m_impl->m_dash_data[i], m_impl->m_dash_data[i + 1]);
+        for (uint32_t i = 0; i < impl->m_dash_num; i += 2) {
+            c.add_dash(impl->m_dash_data[i], impl->m_dash_data[i + 1]);
         }
 
-        c.dash_start(m_impl->m_dash_start);
+        c.dash_start(impl->m_dash_start);
 
         picasso::conv_stroke p(c);
 
-        bool adjust;
-        trans_affine adjmtx = stable_matrix(*const_cast<trans_affine*>(m_impl->m_transform), &adjust);
-        if (adjust) {
-            adjmtx *= trans_affine_translation(FLT_TO_SCALAR(0.5f), FLT_TO_SCALAR(0.5f)); //adjust edge
-        }
-
-        picasso::conv_transform t(p, &adjmtx);
+        p.set_width(SCALAR_TO_FLT(impl->m_line_width));
+        p.set_line_cap(impl->m_line_cap);
+        p.set_line_join(impl->m_line_join);
+        p.set_inner_join(impl->m_inner_join);
+        p.set_miter_limit(SCALAR_TO_FLT(impl->m_miter_limit));
 
-        p.set_width(SCALAR_TO_FLT(m_impl->m_line_width));
-        p.set_line_cap(m_impl->m_line_cap);
-        p.set_line_join(m_impl->m_line_join);
-        p.set_inner_join(m_impl->m_inner_join);
-        p.set_miter_limit(SCALAR_TO_FLT(m_impl->m_miter_limit));
-
-        m_sraster.add_path(t);
+        out(p);
     } else {
-        picasso::conv_curve c(*const_cast<vertex_source*>(m_impl->m_source));
+        picasso::conv_curve c(vs);
         picasso::conv_stroke p(c);
 
-        bool adjust;
-        trans_affine adjmtx = stable_matrix(*const_cast<trans_affine*>(m_impl->m_transform), &adjust);
-        if (adjust) {
-            adjmtx *= trans_affine_translation(FLT_TO_SCALAR(0.5f), FLT_TO_SCALAR(0.5f)); //adjust edge
-        }
+        p.set_width(SCALAR_TO_FLT(impl->m_line_width));
+        p.set_line_cap(impl->m_line_cap);
+        p.set_line_join(impl->m_line_join);
+        p.set_inner_join(impl->m_inner_join);
+        p.set_miter_limit(SCALAR_TO_FLT(impl->m_miter_limit));
+
+        out(p);
+    }
+}
 
-        picasso::conv_transform t(p, &adjmtx);
+// rasterize the stroked outline in device space.
+struct stroke_raster_output {
+    stroke_raster_output(gfx_rasterizer_scanline_aa<>& r, const trans_affine* m)
+        : raster(r), mtx(m)
+    {
+    }
+
+    void operator()(vertex_source& vs)
+    {
+        picasso::conv_transform t(vs, mtx);
+        raster.add_path(t);
+    }
+
+    gfx_rasterizer_scanline_aa<>& raster;
+    const trans_affine* mtx;
+};
+
+// store the stroked outline in user space.
+struct stroke_path_output {
+    stroke_path_output(graphic_path& p)
+        : path(p)
+    {
+    }
+
+    void operator()(vertex_source& vs)
+    {
+        path.concat_path(vs);
+    }
+
+    graphic_path& path;
+};
+
+void gfx_raster_adapter::setup_stroke_raster(void)
+{
+    bool adjust;
+    trans_affine adjmtx = stable_matrix(*const_cast<trans_affine*>(m_impl->m_transform), &adjust);
+    if (adjust) {
+        adjmtx *= trans_affine_translation(FLT_TO_SCALAR(0.5f), FLT_TO_SCALAR(0.5f)); //adjust edge
+    }
 
-        p.set_width(SCALAR_TO_FLT(m_impl->m_line_width));
-        p.set_line_cap(m_impl->m_line_cap);
-        p.set_line_join(m_impl->m_line_join);
-        p.set_inner_join(m_impl->m_inner_join);
-        p.set_miter_limit(SCALAR_TO_FLT(m_impl->m_miter_limit));
+    if (m_impl->m_cache) {
+        // outline is independent of the transform, reuse it until the path changed.
+        stroke_params params;
+        params.width = m_impl->m_line_width;
+        params.miter_limit = m_impl->m_miter_limit;
+        params.cap = m_impl->m_line_cap;
+        params.join = m_impl->m_line_join;
+        params.inner = m_impl->m_inner_join;
+        params.dashed = m_impl->m_dashline;
+        params.dash_start = m_impl->m_dash_start;
+        params.dashes = m_impl->m_dash_data;
+        params.num_dashes = m_impl->m_dashline ? m_impl->m_dash_num : 0;
+
+        stroke_outline* outline = m_impl->m_cache->find_outline(params);
+        if (!outline) {
+            outline = stroke_outline::create(params);
+            if (outline) {
+                stroke_path_output out(outline->path());
+                _stroke_source(m_impl, *const_cast<vertex_source*>(m_impl->m_source), out);
+                m_impl->m_cache->add_outline(outline);
+            }
+        }
 
-        m_sraster.add_path(t);
+        if (outline) {
+            stroke_outline_source src(outline);
+            stroke_raster_output out(m_sraster, &adjmtx);
+            out(src);
+            outline->unref();
+            return;
+        }
     }
+
+    stroke_raster_output out(m_sraster, &adjmtx);
+    _stroke_source(m_impl, *const_cast<vertex_source*>(m_impl->m_source), out);
 }
 
 void gfx_raster_adapter::setup_fill_raster(void)
 {
     m_fraster.filling(m_impl->m_filling_rule);
+    // convex shape is swept from its edges, without cells to store and sort.
+    m_fraster.convex(m_impl->m_convex);
     trans_affine adjmtx = stable_matrix(*const_cast<trans_affine*>(m_impl->m_transform));
 
     conv_transform mt(*const_cast<vertex_source*>(m_impl->m_source), &adjmtx);
@@ -285,6 +363,11 @@ void gfx_raster_adapter::add_shape(const vertex_source& vs, uint32_t id)
     m_impl->m_source = &vs;
 }
 
+void gfx_raster_adapter::set_shape_cache(path_cache* cache)
+{
+    m_impl->m_cache = cache;
+}
+
 bool gfx_raster_adapter::contains(scalar x, scalar y)
 {
     if (m_impl->m_source) {
@@ -300,4 +383,40 @@ bool gfx_raster_adapter::contains(scalar x, scalar y)
     }
 }
 
+
+uint32_t gfx_raster_adapter::coverage_size(void)
+{
+    gfx_scanline_u8 sl;
+    m_impl->m_coverage.prepare();
+    gfx_render_scanlines(m_fraster, sl, m_impl->m_coverage);
+
+    if (m_impl->m_coverage.rewind_scanlines()) {
+        return m_impl->m_coverage.byte_size();
+    } else {
+        return 0;
+    }
+}
+
+void gfx_raster_adapter::serialize_coverage(byte* data)
+{
+    m_impl->m_coverage.serialize(data);
+}
+
+uint32_t gfx_raster_adapter::cells_size(void)
+{
+    return m_fraster.num_cells() * sizeof(cell);
+}
+
+void gfx_raster_adapter::serialize_cells(byte* data)
+{
+    m_fraster.copy_cells((cell*)data);
+}
+
+void gfx_raster_adapter::add_cells(const byte* data, uint32_t size, int32_t x, int32_t y)
+{
+    m_fraster.filling(m_impl->m_filling_rule);
+    m_fraster.convex(false);
+    m_fraster.add_cells((const cell*)data, size / sizeof(cell), x, y);
+}
+
 }
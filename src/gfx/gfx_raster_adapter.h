@@ -29,6 +29,7 @@ public:
     virtual void set_raster_method(uint32_t m);
 
     virtual void add_shape(const vertex_source& vs, uint32_t id);
+    virtual void set_shape_cache(path_cache* cache);
     virtual void reset(void);
 
     virtual void set_stroke_dashes(scalar start, const scalar* dashes, uint32_t num);
@@ -40,6 +41,13 @@ public:
     virtual bool is_empty(void);
     virtual bool contains(scalar x, scalar y);
 
+    virtual uint32_t coverage_size(void);
+    virtual void serialize_coverage(byte* data);
+
+    virtual uint32_t cells_size(void);
+    virtual void serialize_cells(byte* data);
+    virtual void add_cells(const byte* data, uint32_t size, int32_t x, int32_t y);
+
     uint32_t raster_method(void) const;
     gfx_rasterizer_scanline_aa<>& stroke_impl(void) { return m_sraster; }
     gfx_rasterizer_scanline_aa<>& fill_impl(void) { return m_fraster; }
@@ -8,6 +8,7 @@
 #define _GFX_RASTERIZER_CELL_H_
 
 #include "common.h"
+#include "data_vector.h"
 
 #include "graphic_base.h"
 
@@ -115,6 +116,255 @@ void qsort_cells(Cell** start, uint32_t num)
     }
 }
 
+// cell sort methods of scanline
+enum cell_sort_type {
+    cell_sort_auto = 0, // radix sort for long scanlines, quick sort for short ones.
+    cell_sort_quick,
+    cell_sort_radix,
+};
+
+const uint32_t radix_sort_threshold = 32;
+
+template <typename Cell>
+struct cell_sort_key {
+    uint32_t key;
+    Cell* cell;
+};
+
+// LSD radix sort by x, keys are copied out with the cells, so the passes read
+// and write contiguous arrays only. digits all the same are skipped.
+template <typename Cell>
+void radix_sort_cells(Cell** start, uint32_t num, pod_vector<cell_sort_key<Cell> >& buffer)
+{
+    buffer.allocate(num << 1);
+    cell_sort_key<Cell>* src = buffer.data();
+    cell_sort_key<Cell>* dst = src + num;
+
+    int32_t min_x = start[0]->x;
+    int32_t max_x = start[0]->x;
+    uint32_t i;
+
+    for (i = 1; i < num; i++) {
+        int32_t x = start[i]->x;
+        if (x < min_x) {
+            min_x = x;
+        }
+        if (x > max_x) {
+            max_x = x;
+        }
+    }
+
+    for (i = 0; i < num; i++) {
+        src[i].key = (uint32_t)(start[i]->x - min_x);
+        src[i].cell = start[i];
+    }
+
+    uint32_t range = (uint32_t)(max_x - min_x);
+    for (uint32_t shift = 0; (shift < 32) && (range >> shift); shift += 8) {
+        uint32_t count[256];
+        memset(count, 0, sizeof(count));
+
+        for (i = 0; i < num; i++) {
+            count[(src[i].key >> shift) & 0xFF]++;
+        }
+
+        if (count[(src[0].key >> shift) & 0xFF] == num) {
+            continue;
+        }
+
+        uint32_t pos = 0;
+        for (i = 0; i < 256; i++) {
+            uint32_t v = count[i];
+            count[i] = pos;
+            pos += v;
+        }
+
+        for (i = 0; i < num; i++) {
+            dst[count[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+
+        cell_sort_key<Cell>* t = src;
+        src = dst;
+        dst = t;
+    }
+
+    for (i = 0; i < num; i++) {
+        start[i] = src[i].cell;
+    }
+}
+
+// coverage accumulator
+// Dense accumulation buffer over the bounding box of the cells. A cell adds
+// (cover << (poly_subpixel_shift + 1)) - area to its own pixel and area to the
+// next one, so the prefix sum of a row gives the signed area of every pixel.
+// The X range of each row is kept, the empty rows and columns are not swept.
+class gfx_coverage_accumulator
+{
+public:
+    struct row_span {
+        int32_t x1;
+        int32_t x2;
+    };
+
+    gfx_coverage_accumulator()
+        : m_covers(0)
+        , m_rows(0)
+        , m_capacity(0)
+        , m_rows_capacity(0)
+        , m_min_x(0)
+        , m_min_y(0)
+        , m_width(0)
+        , m_height(0)
+    {
+    }
+
+    ~gfx_coverage_accumulator()
+    {
+        pod_allocator<int32_t>::deallocate(m_covers, m_capacity);
+        pod_allocator<row_span>::deallocate(m_rows, m_rows_capacity);
+    }
+
+    void reset(void)
+    {
+        m_width = 0;
+        m_height = 0;
+    }
+
+    // Make the buffer cover the box, the accumulated values are kept.
+    bool extend(int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t max_area)
+    {
+        if (m_height) {
+            if (x1 >= m_min_x && y1 >= m_min_y
+                && x2 < (m_min_x + m_width - 1) && y2 < (m_min_y + m_height)) {
+                return true;
+            }
+
+            // the growing sides get a margin up to half of the size, the box
+            // of a path usually grows more than once.
+            int32_t ox1 = Min(x1, m_min_x);
+            int32_t oy1 = Min(y1, m_min_y);
+            int32_t ox2 = Max(x2, m_min_x + m_width - 2);
+            int32_t oy2 = Max(y2, m_min_y + m_height - 1);
+
+            for (int32_t shift = 1; shift < 32; shift++) {
+                int32_t mx = m_width >> shift;
+                int32_t my = m_height >> shift;
+                x1 = (ox1 < m_min_x) ? (ox1 - mx) : ox1;
+                y1 = (oy1 < m_min_y) ? (oy1 - my) : oy1;
+                x2 = (ox2 > m_min_x + m_width - 2) ? (ox2 + mx) : ox2;
+                y2 = (oy2 > m_min_y + m_height - 1) ? (oy2 + my) : oy2;
+                if (((int64_t)x2 - x1 + 2) * ((int64_t)y2 - y1 + 1) <= (int64_t)max_area) {
+                    break;
+                }
+            }
+        }
+
+        // one more column for the area of the last pixel.
+        int64_t width = (int64_t)x2 - x1 + 2;
+        int64_t height = (int64_t)y2 - y1 + 1;
+        if (width * height > (int64_t)max_area) {
+            return false;
+        }
+
+        uint32_t size = (uint32_t)(width * height);
+        int32_t* covers = m_covers;
+        row_span* rows = m_rows;
+        bool realloc = m_height || (size > m_capacity) || ((uint32_t)height > m_rows_capacity);
+
+        if (realloc) {
+            covers = pod_allocator<int32_t>::allocate(size);
+            rows = pod_allocator<row_span>::allocate((uint32_t)height);
+            if (!covers || !rows) {
+                pod_allocator<int32_t>::deallocate(covers, size);
+                pod_allocator<row_span>::deallocate(rows, (uint32_t)height);
+                return false;
+            }
+        }
+
+        memset(covers, 0, size * sizeof(int32_t));
+        for (int32_t i = 0; i < (int32_t)height; i++) {
+            rows[i].x1 = 0x7FFFFFFF;
+            rows[i].x2 = -0x7FFFFFFF;
+        }
+
+        // move the accumulated rows into the new box.
+        for (int32_t y = 0; y < m_height; y++) {
+            const row_span& r = m_rows[y];
+            if (r.x1 <= r.x2) {
+                int32_t ny = y + m_min_y - y1;
+                mem_copy(covers + ny * (int32_t)width + (r.x1 - x1),
+                         m_covers + y * m_width + (r.x1 - m_min_x), (r.x2 - r.x1 + 2) * sizeof(int32_t));
+                rows[ny] = r;
+            }
+        }
+
+        if (realloc) {
+            pod_allocator<int32_t>::deallocate(m_covers, m_capacity);
+            pod_allocator<row_span>::deallocate(m_rows, m_rows_capacity);
+            m_covers = covers;
+            m_rows = rows;
+            m_capacity = size;
+            m_rows_capacity = (uint32_t)height;
+        }
+
+        m_min_x = x1;
+        m_min_y = y1;
+        m_width = (int32_t)width;
+        m_height = (int32_t)height;
+        return true;
+    }
+
+    void add(int32_t x, int32_t y, int32_t cover, int32_t area)
+    {
+        row_span& r = m_rows[y - m_min_y];
+        if (x < r.x1) {
+            r.x1 = x;
+        }
+        if (x > r.x2) {
+            r.x2 = x;
+        }
+
+        int32_t* p = m_covers + (y - m_min_y) * m_width + (x - m_min_x);
+        p[0] += (int32_t)((uint32_t)cover << (poly_subpixel_shift + 1)) - area;
+        p[1] += area;
+    }
+
+    // Clip the box to the pixels of the buffer.
+    void clip_box(int32_t* x1, int32_t* y1, int32_t* x2, int32_t* y2) const
+    {
+        *x1 = Max(*x1, m_min_x);
+        *y1 = Max(*y1, m_min_y);
+        *x2 = Min(*x2, m_min_x + m_width - 2);
+        *y2 = Min(*y2, m_min_y + m_height - 1);
+    }
+
+    // Returns the values from x1 to x2 of the row, or null if the row is empty.
+    const int32_t* scanline_covers(int32_t y, int32_t* x1, int32_t* x2) const
+    {
+        const row_span& r = m_rows[y - m_min_y];
+        if (r.x1 > r.x2) {
+            return 0;
+        }
+
+        *x1 = r.x1;
+        *x2 = r.x2;
+        return m_covers + (y - m_min_y) * m_width + (r.x1 - m_min_x);
+    }
+
+private:
+    gfx_coverage_accumulator(const gfx_coverage_accumulator&);
+    const gfx_coverage_accumulator& operator = (const gfx_coverage_accumulator&);
+
+    int32_t* m_covers;
+    row_span* m_rows;
+    uint32_t m_capacity;
+    uint32_t m_rows_capacity;
+    int32_t m_min_x;
+    int32_t m_min_y;
+    int32_t m_width;
+    int32_t m_height;
+};
+
 // rasterizer cells anrialias
 // An internal class that implements the main rasterization algorithm.
 // Used in the rasterizer. Should not be used direcly.
@@ -132,6 +382,15 @@ public:
         cell_block_limit = 1024,
     };
 
+    // the cells are accumulated into a coverage buffer when there are more
+    // than one cell per accumulate_density pixels of the bounding box, or
+    // when the cell blocks are used up.
+    enum {
+        accumulate_min_cells = cell_block_size << 4,
+        accumulate_density = 4,
+        accumulate_area_limit = 1 << 28,
+    };
+
     enum {
         dx_limit = 16384 << poly_subpixel_shift,
     };
@@ -154,7 +413,11 @@ public:
         , m_min_y(0x7FFFFFFF)
         , m_max_x(-0x7FFFFFFF)
         , m_max_y(-0x7FFFFFFF)
+        , m_flushed_cells(0)
+        , m_sort_type(cell_sort_auto)
         , m_sorted(false)
+        , m_binned(false)
+        , m_accumulated(false)
     {
         m_style_cell.initial();
         m_curr_cell.initial();
@@ -179,6 +442,10 @@ public:
         m_curr_cell.initial();
         m_style_cell.initial();
         m_sorted = false;
+        m_binned = false;
+        m_accumulated = false;
+        m_flushed_cells = 0;
+        m_accumulator.reset();
         m_min_x = 0x7FFFFFFF;
         m_min_y = 0x7FFFFFFF;
         m_max_x = -0x7FFFFFFF;
@@ -334,16 +601,49 @@ public:
             return; //Perform sort only the first time.
         }
 
+        bin_cells();
+        if (m_num_cells && !m_sorted) {
+            sort_scanline_cells(m_min_y, m_max_y);
+            m_sorted = true;
+        }
+    }
+
+    // Distribute cells into scanlines by Y, the X-arrays are not sorted.
+    void bin_cells(void)
+    {
+        if (m_sorted || m_binned) {
+            return;
+        }
+
         add_curr_cell();
         m_curr_cell.x = 0x7FFFFFFF;
         m_curr_cell.y = 0x7FFFFFFF;
         m_curr_cell.cover = 0;
         m_curr_cell.area = 0;
 
+        if (m_accumulated || ((m_num_cells >= accumulate_min_cells)
+            && (((int64_t)m_max_x - m_min_x + 2) * ((int64_t)m_max_y - m_min_y + 1)
+                <= (int64_t)m_num_cells * accumulate_density))) {
+            // cells out of the area limit are dropped as the blocks used up.
+            if (!flush_cells() && m_accumulated) {
+                // the box can not be grown, the scanlines out of the buffer are empty.
+                m_num_cells = 0;
+                m_accumulator.clip_box(&m_min_x, &m_min_y, &m_max_x, &m_max_y);
+            }
+        }
+
+        if (m_accumulated) {
+            m_binned = true;
+            m_sorted = true;
+            return;
+        }
+
         if (m_num_cells == 0) {
             return;
         }
 
+        m_binned = true;
+
         // Allocate the array of cell pointers
         m_sorted_cells.allocate(m_num_cells + 16);
 
@@ -403,19 +703,93 @@ public:
             ++cell_ptr;
         }
 
-        // Finally arrange the X-arrays
-        for (i = 0; i < m_sorted_y.size(); i++) {
-            const sorted_y& curr_y = m_sorted_y[i];
+    }
+
+    // Arrange the X-arrays of scanlines from y1 to y2, scanlines do not share
+    // any cells, so different ranges can be arranged at the same time.
+    void sort_scanline_cells(int32_t y1, int32_t y2)
+    {
+        if (m_accumulated) {
+            return;
+        }
+
+        // radix buffer is local, different ranges can be arranged by threads.
+        pod_vector<cell_sort_key<cell_type> > buffer;
+
+        for (int32_t y = y1; y <= y2; y++) {
+            const sorted_y& curr_y = m_sorted_y[y - m_min_y];
             if (curr_y.num) {
-                qsort_cells(m_sorted_cells.data() + curr_y.start, curr_y.num);
+                if ((m_sort_type == cell_sort_radix)
+                    || ((m_sort_type == cell_sort_auto) && (curr_y.num > radix_sort_threshold))) {
+                    radix_sort_cells(m_sorted_cells.data() + curr_y.start, curr_y.num, buffer);
+                } else {
+                    qsort_cells(m_sorted_cells.data() + curr_y.start, curr_y.num);
+                }
             }
         }
+    }
+
+    void sort_type(cell_sort_type type) { m_sort_type = type; }
+    cell_sort_type sort_type(void) const { return m_sort_type; }
+
+    // All X-arrays are arranged by caller.
+    void set_sorted(void)
+    {
         m_sorted = true;
     }
 
     uint32_t total_cells(void) const
     {
-        return m_num_cells;
+        return m_num_cells + m_flushed_cells;
+    }
+
+    // The cells are accumulated into the coverage buffer instead of the scanlines.
+    bool accumulated(void) const { return m_accumulated; }
+
+    // Copy the cells in the blocks, the current cell has been added by sort_cells.
+    void copy_cells(cell_type* cells) const
+    {
+        cell_type* const* block_ptr = m_cells;
+        uint32_t nb = m_num_cells >> cell_block_shift;
+        uint32_t rest = m_num_cells & cell_block_mask;
+
+        while (nb--) {
+            mem_copy(cells, *block_ptr++, cell_block_size * sizeof(cell_type));
+            cells += cell_block_size;
+        }
+
+        if (rest) {
+            mem_copy(cells, *block_ptr, rest * sizeof(cell_type));
+        }
+    }
+
+    // Add the cells copied by copy_cells, moved by whole pixels. The cells of
+    // the same pixel are summed up by the sweep, as the cells of the lines are.
+    void add_cells(const cell_type* cells, uint32_t num, int32_t dx, int32_t dy)
+    {
+        add_curr_cell();
+
+        for (uint32_t i = 0; i < num; i++) {
+            m_curr_cell = cells[i];
+            m_curr_cell.x += dx;
+            m_curr_cell.y += dy;
+
+            if (m_curr_cell.x < m_min_x) { m_min_x = m_curr_cell.x; }
+            if (m_curr_cell.x > m_max_x) { m_max_x = m_curr_cell.x; }
+            if (m_curr_cell.y < m_min_y) { m_min_y = m_curr_cell.y; }
+            if (m_curr_cell.y > m_max_y) { m_max_y = m_curr_cell.y; }
+
+            add_curr_cell();
+        }
+
+        // the last cell has been added, next line starts from an empty one.
+        m_curr_cell.cover = 0;
+        m_curr_cell.area = 0;
+    }
+
+    const int32_t* scanline_covers(int32_t y, int32_t* x1, int32_t* x2) const
+    {
+        return m_accumulator.scanline_covers(y, x1, x2);
     }
 
     uint32_t scanline_num_cells(uint32_t y) const
@@ -447,7 +821,7 @@ private:
     {
         if (m_curr_cell.area | m_curr_cell.cover) {
             if ((m_num_cells & cell_block_mask) == 0) {
-                if (m_num_blocks >= cell_block_limit) {
+                if ((m_curr_block >= cell_block_limit) && !flush_cells()) {
                     return;
                 }
                 allocate_block();
@@ -541,6 +915,40 @@ private:
         m_curr_cell.area += (fx2 + poly_subpixel_scale - first) * delta;
     }
 
+    // Move all the cells into the coverage buffer, the cell blocks are reused.
+    bool flush_cells(void)
+    {
+        if (!m_accumulator.extend(m_min_x, m_min_y, m_max_x, m_max_y, accumulate_area_limit)) {
+            return false;
+        }
+
+        cell_type** block_ptr = m_cells;
+        uint32_t nb = m_num_cells >> cell_block_shift;
+        uint32_t rest = m_num_cells & cell_block_mask;
+
+        while (nb--) {
+            accumulate_block(*block_ptr++, cell_block_size);
+        }
+
+        if (rest) {
+            accumulate_block(*block_ptr, rest);
+        }
+
+        m_flushed_cells += m_num_cells;
+        m_num_cells = 0;
+        m_curr_block = 0;
+        m_accumulated = true;
+        return true;
+    }
+
+    void accumulate_block(const cell_type* cell_ptr, uint32_t num)
+    {
+        while (num--) {
+            m_accumulator.add(cell_ptr->x, cell_ptr->y, cell_ptr->cover, cell_ptr->area);
+            ++cell_ptr;
+        }
+    }
+
     void allocate_block(void)
     {
         if (m_curr_block >= m_num_blocks) {
@@ -574,13 +982,649 @@ private:
     cell_type* m_curr_cell_ptr;
     pod_vector<cell_type*> m_sorted_cells;
     pod_vector<sorted_y> m_sorted_y;
+    gfx_coverage_accumulator m_accumulator;
     cell_type m_curr_cell;
     cell_type m_style_cell;
     int32_t m_min_x;
     int32_t m_min_y;
     int32_t m_max_x;
     int32_t m_max_y;
+    uint32_t m_flushed_cells;
+    cell_sort_type m_sort_type;
     bool m_sorted;
+    bool m_binned;
+    bool m_accumulated;
+};
+
+// rasterizer convex cells
+// Outline of a single y-monotone contour, such as a convex polygon. The edges
+// are split into the descending and the ascending chains, which are walked
+// down together, so the cells are made in the order of scanlines. The cells
+// of each chain in a scanline are a dense run, there are no cell blocks to
+// fill and sort. The cells are the same as gfx_rasterizer_cells_aa gives.
+// An axis aligned rectangle keeps no cells, the coverage of its scanlines is
+// computed from its box.
+class gfx_rasterizer_convex_cells
+{
+public:
+    struct cover_cell {
+        int32_t cover;
+        int32_t area;
+    };
+
+    // runs of a scanline, the cells of them are stored one by one.
+    struct scanline_runs {
+        int32_t x[2];
+        uint32_t len[2];
+        uint32_t start;
+        uint32_t num;
+    };
+
+    enum {
+        dx_limit = 16384 << poly_subpixel_shift,
+        max_row_segments = 8,
+    };
+
+    gfx_rasterizer_convex_cells()
+        : m_cells(0)
+        , m_num_cells(0)
+        , m_capacity(0)
+        , m_min_x(0x7FFFFFFF)
+        , m_min_y(0x7FFFFFFF)
+        , m_max_x(-0x7FFFFFFF)
+        , m_max_y(-0x7FFFFFFF)
+        , m_built(false)
+        , m_rect(false)
+    {
+    }
+
+    ~gfx_rasterizer_convex_cells()
+    {
+        pod_allocator<cover_cell>::deallocate(m_cells, m_capacity);
+    }
+
+    void reset(void)
+    {
+        m_lines.clear();
+        m_num_cells = 0;
+        m_min_x = 0x7FFFFFFF;
+        m_min_y = 0x7FFFFFFF;
+        m_max_x = -0x7FFFFFFF;
+        m_max_y = -0x7FFFFFFF;
+        m_built = false;
+        m_rect = false;
+    }
+
+    void line(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+    {
+        int32_t ex1 = x1 >> poly_subpixel_shift;
+        int32_t ex2 = x2 >> poly_subpixel_shift;
+        int32_t ey1 = y1 >> poly_subpixel_shift;
+        int32_t ey2 = y2 >> poly_subpixel_shift;
+
+        if (ex1 < m_min_x) { m_min_x = ex1; }
+        if (ex1 > m_max_x) { m_max_x = ex1; }
+        if (ey1 < m_min_y) { m_min_y = ey1; }
+        if (ey1 > m_max_y) { m_max_y = ey1; }
+        if (ex2 < m_min_x) { m_min_x = ex2; }
+        if (ex2 > m_max_x) { m_max_x = ex2; }
+        if (ey2 < m_min_y) { m_min_y = ey2; }
+        if (ey2 > m_max_y) { m_max_y = ey2; }
+
+        edge e;
+        e.x1 = x1;
+        e.y1 = y1;
+        e.x2 = x2;
+        e.y2 = y2;
+        m_lines.add(e);
+    }
+
+    // Pass the edges to the cells rasterizer in the same order.
+    template <typename Cells>
+    void replay(Cells& outline) const
+    {
+        for (uint32_t i = 0; i < m_lines.size(); i++) {
+            const edge& e = m_lines[i];
+            outline.line(e.x1, e.y1, e.x2, e.y2);
+        }
+    }
+
+    // Make the cells of scanlines, return false if the edges are not one
+    // closed contour which goes down once and up once. The contour of only
+    // horizontal and vertical edges has no cells, it is kept as a rectangle
+    // if it is one.
+    bool build(void)
+    {
+        if (m_built) {
+            return true;
+        }
+
+        uint32_t num = m_lines.size();
+        uint32_t turns = 0;
+        uint32_t start = num;
+        int32_t last_dir = 0;
+        bool aligned = true;
+        uint32_t i;
+
+        for (i = 0; i < num; i++) {
+            const edge& e = m_lines[i];
+            const edge& p = m_lines[i ? (i - 1) : (num - 1)];
+            if (e.x1 != p.x2 || e.y1 != p.y2) {
+                return false; // not connected.
+            }
+
+            if (e.x2 - e.x1 >= dx_limit || e.x1 - e.x2 >= dx_limit) {
+                return false; // split by the cells rasterizer.
+            }
+
+            if (e.y1 != e.y2) {
+                last_dir = (e.y2 > e.y1) ? 1 : -1;
+                if (e.x1 != e.x2) {
+                    aligned = false;
+                }
+            }
+        }
+
+        // direction changes around the contour, horizontal edges have no cells.
+        for (i = 0; i < num; i++) {
+            const edge& e = m_lines[i];
+            if (e.y1 != e.y2) {
+                int32_t dir = (e.y2 > e.y1) ? 1 : -1;
+                if (dir != last_dir) {
+                    if (dir > 0) {
+                        start = i;
+                    }
+                    turns++;
+                }
+                last_dir = dir;
+            }
+        }
+
+        if (turns != 2) {
+            return false;
+        }
+
+        if (aligned) {
+            return build_rectangle();
+        }
+
+        // descending chain in order, ascending chain reversed, both from top to bottom.
+        m_edges.allocate(num);
+        uint32_t n = 0;
+
+        m_chains[0].start = 0;
+        m_chains[0].up = false;
+        for (i = 0; i < num; i++) {
+            const edge& e = m_lines[(start + i) % num];
+            if (e.y1 < e.y2) {
+                add_edge(n++, e.x1, e.y1, e.x2, e.y2);
+            } else if (e.y1 > e.y2) {
+                break;
+            }
+        }
+        m_chains[0].end = n;
+
+        m_chains[1].start = n;
+        m_chains[1].up = true;
+        for (i = num; i > 0; i--) {
+            const edge& e = m_lines[(start + i - 1) % num];
+            if (e.y1 > e.y2) {
+                add_edge(n++, e.x2, e.y2, e.x1, e.y1);
+            } else if (e.y1 < e.y2) {
+                break;
+            }
+        }
+        m_chains[1].end = n;
+
+        if (!render_scanlines()) {
+            return false;
+        }
+
+        m_built = true;
+        return true;
+    }
+
+    bool built(void) const { return m_built; }
+    bool empty(void) const
+    {
+        if (m_rect) {
+            return m_rect_box.x1 == m_rect_box.x2 || m_rect_box.y1 == m_rect_box.y2;
+        }
+        return m_num_cells == 0;
+    }
+
+    // the rectangle in subpixels if the contour is one, dir is the sign of
+    // the cover of its left edge.
+    struct rect_box {
+        int32_t x1;
+        int32_t y1;
+        int32_t x2;
+        int32_t y2;
+        int32_t dir;
+    };
+
+    const rect_box* rectangle(void) const { return m_rect ? &m_rect_box : 0; }
+    uint32_t total_lines(void) const { return m_lines.size(); }
+
+    int32_t min_x(void) const { return m_min_x; }
+    int32_t min_y(void) const { return m_min_y; }
+    int32_t max_x(void) const { return m_max_x; }
+    int32_t max_y(void) const { return m_max_y; }
+
+    const scanline_runs& scanline(int32_t y) const
+    {
+        return m_rows[y - m_min_y];
+    }
+
+    const cover_cell* scanline_cells(const scanline_runs& r) const
+    {
+        return m_cells + r.start;
+    }
+
+private:
+    // edge from top to bottom, ey1 and ey2 are the scanlines of its ends.
+    struct edge {
+        int32_t x1;
+        int32_t y1;
+        int32_t x2;
+        int32_t y2;
+        int32_t ey1;
+        int32_t ey2;
+    };
+
+    struct chain {
+        uint32_t start;
+        uint32_t end;
+        bool up;
+    };
+
+    // position of a chain, X of the edge at the top of scanline is stepped
+    // the same as gfx_rasterizer_cells_aa::line does.
+    struct chain_walker {
+        uint32_t edge;
+        int32_t x;
+        int32_t dy;
+        int32_t lift;
+        int32_t rem;
+        int32_t mod;
+    };
+
+    // Vertical edges of a rectangle go down at one X and go up at another.
+    bool build_rectangle(void)
+    {
+        int32_t x[2] = {0, 0};
+        bool found[2] = {false, false};
+        int32_t y1 = 0x7FFFFFFF;
+        int32_t y2 = -0x7FFFFFFF;
+
+        for (uint32_t i = 0; i < m_lines.size(); i++) {
+            const edge& e = m_lines[i];
+            if (e.y1 != e.y2) {
+                uint32_t c = (e.y2 > e.y1) ? 0 : 1;
+                if (found[c] && x[c] != e.x1) {
+                    return false;
+                }
+                x[c] = e.x1;
+                found[c] = true;
+                y1 = Min(y1, Min(e.y1, e.y2));
+                y2 = Max(y2, Max(e.y1, e.y2));
+            }
+        }
+
+        m_rect_box.x1 = Min(x[0], x[1]);
+        m_rect_box.y1 = y1;
+        m_rect_box.x2 = Max(x[0], x[1]);
+        m_rect_box.y2 = y2;
+        m_rect_box.dir = (x[0] <= x[1]) ? 1 : -1;
+        m_rect = true;
+        m_built = true;
+        return true;
+    }
+
+    void add_edge(uint32_t i, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+    {
+        edge& e = m_edges[i];
+        e.x1 = x1;
+        e.y1 = y1;
+        e.x2 = x2;
+        e.y2 = y2;
+        e.ey1 = y1 >> poly_subpixel_shift;
+        e.ey2 = y2 >> poly_subpixel_shift;
+    }
+
+    // X at the bottom of the first scanline of edge.
+    static int32_t start_edge(const edge& e, chain_walker* w)
+    {
+        int32_t dx = e.x2 - e.x1;
+        int32_t dy = e.y2 - e.y1;
+        int32_t p = (poly_subpixel_scale - (e.y1 & poly_subpixel_mask)) * dx;
+        int32_t delta = p / dy;
+        int32_t mod = p % dy;
+
+        if (mod < 0) {
+            delta--;
+            mod += dy;
+        }
+
+        p = (int32_t)((uint32_t)dx << poly_subpixel_shift);
+        w->dy = dy;
+        w->lift = p / dy;
+        w->rem = p % dy;
+        if (w->rem < 0) {
+            w->lift--;
+            w->rem += dy;
+        }
+        w->mod = mod - dy;
+        return e.x1 + delta;
+    }
+
+    static int32_t step_edge(chain_walker* w)
+    {
+        int32_t delta = w->lift;
+        w->mod += w->rem;
+        if (w->mod >= 0) {
+            w->mod -= w->dy;
+            delta++;
+        }
+        return w->x + delta;
+    }
+
+    // Walk the edges of chain in scanline y, the ascending edges go upwards as
+    // they were added.
+    template <typename Output>
+    void walk_chain(const chain& c, chain_walker* w, int32_t y, Output& out) const
+    {
+        int32_t top = (int32_t)((uint32_t)y << poly_subpixel_shift);
+
+        while (w->edge < c.end) {
+            const edge& e = m_edges[w->edge];
+            if (e.ey1 > y) {
+                break;
+            }
+
+            int32_t x1, y1, x2, y2;
+            if (e.ey1 == y) {
+                x1 = e.x1;
+                y1 = e.y1 - top;
+            } else {
+                x1 = w->x;
+                y1 = 0;
+            }
+
+            bool last = (e.ey2 == y);
+            if (last) {
+                x2 = e.x2;
+                y2 = e.y2 - top;
+            } else {
+                x2 = (e.ey1 == y) ? start_edge(e, w) : step_edge(w);
+                y2 = poly_subpixel_scale;
+                w->x = x2;
+            }
+
+            if (c.up) {
+                out(x2, y2, x1, y1);
+            } else {
+                out(x1, y1, x2, y2);
+            }
+
+            if (!last) {
+                break;
+            }
+            w->edge++;
+        }
+    }
+
+    // segments of a chain in scanline and the cells X range of them, the
+    // segments are kept unless there are too many.
+    struct segment_output {
+        int32_t x1;
+        int32_t x2;
+        uint32_t num;
+        int32_t segs[max_row_segments][4];
+
+        segment_output()
+            : x1(0x7FFFFFFF), x2(-0x7FFFFFFF), num(0)
+        {
+        }
+
+        void operator()(int32_t sx1, int32_t sy1, int32_t sx2, int32_t sy2)
+        {
+            if (num < max_row_segments) {
+                segs[num][0] = sx1;
+                segs[num][1] = sy1;
+                segs[num][2] = sx2;
+                segs[num][3] = sy2;
+            }
+            num++;
+
+            int32_t ex1 = sx1 >> poly_subpixel_shift;
+            int32_t ex2 = sx2 >> poly_subpixel_shift;
+            if (ex1 > ex2) {
+                int32_t t = ex1;
+                ex1 = ex2;
+                ex2 = t;
+            }
+            if (ex1 < x1) { x1 = ex1; }
+            if (ex2 > x2) { x2 = ex2; }
+        }
+
+        bool empty(void) const { return x1 > x2; }
+    };
+
+    struct cell_output {
+        cover_cell* cells;
+        int32_t x0;
+
+        cell_output(cover_cell* c, int32_t x)
+            : cells(c), x0(x)
+        {
+        }
+
+        void operator()(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+        {
+            render_hline(cells, x0, x1, y1, x2, y2);
+        }
+    };
+
+    // Render the segments of chain into cells, the chain is walked again if
+    // the segments are not all kept.
+    void render_chain(uint32_t c, int32_t y, const segment_output& segs,
+                      chain_walker* w, const chain_walker& next, cover_cell* cells, int32_t x0) const
+    {
+        if (segs.num > max_row_segments) {
+            cell_output out(cells, x0);
+            walk_chain(m_chains[c], w, y, out);
+            return;
+        }
+
+        for (uint32_t i = 0; i < segs.num; i++) {
+            render_hline(cells, x0, segs.segs[i][0], segs.segs[i][1], segs.segs[i][2], segs.segs[i][3]);
+        }
+        *w = next;
+    }
+
+    bool render_scanlines(void)
+    {
+        m_rows.allocate((uint32_t)(m_max_y - m_min_y + 1));
+        m_num_cells = 0;
+
+        chain_walker w[2];
+        w[0].edge = m_chains[0].start;
+        w[1].edge = m_chains[1].start;
+        w[0].x = w[1].x = 0;
+
+        for (int32_t y = m_min_y; y <= m_max_y; y++) {
+            scanline_runs& r = m_rows[y - m_min_y];
+            segment_output segs[2];
+            chain_walker t[2] = {w[0], w[1]};
+            walk_chain(m_chains[0], &t[0], y, segs[0]);
+            walk_chain(m_chains[1], &t[1], y, segs[1]);
+
+            r.start = m_num_cells;
+            r.num = 0;
+
+            if (segs[0].empty() && segs[1].empty()) {
+                continue;
+            }
+
+            // chains touched each other share one run.
+            cover_cell* cells;
+            if (segs[0].empty() || segs[1].empty()
+                || (segs[0].x1 <= segs[1].x2 + 1 && segs[1].x1 <= segs[0].x2 + 1)) {
+                r.x[0] = Min(segs[0].x1, segs[1].x1);
+                r.len[0] = (uint32_t)(Max(segs[0].x2, segs[1].x2) - r.x[0] + 1);
+                r.num = 1;
+                if (!(cells = allocate_cells(r.len[0]))) {
+                    return false;
+                }
+                render_chain(0, y, segs[0], &w[0], t[0], cells, r.x[0]);
+                render_chain(1, y, segs[1], &w[1], t[1], cells, r.x[0]);
+            } else {
+                uint32_t a = (segs[0].x1 < segs[1].x1) ? 0 : 1;
+                r.x[0] = segs[a].x1;
+                r.len[0] = (uint32_t)(segs[a].x2 - segs[a].x1 + 1);
+                r.x[1] = segs[a ^ 1].x1;
+                r.len[1] = (uint32_t)(segs[a ^ 1].x2 - segs[a ^ 1].x1 + 1);
+                r.num = 2;
+                if (!(cells = allocate_cells(r.len[0] + r.len[1]))) {
+                    return false;
+                }
+                render_chain(a, y, segs[a], &w[a], t[a], cells, r.x[0]);
+                render_chain(a ^ 1, y, segs[a ^ 1], &w[a ^ 1], t[a ^ 1], cells + r.len[0], r.x[1]);
+            }
+        }
+        return true;
+    }
+
+    // zeroed cells at the end of storage.
+    cover_cell* allocate_cells(uint32_t num)
+    {
+        if (m_num_cells + num > m_capacity) {
+            uint32_t cap = Max(m_capacity << 1, m_num_cells + num + 256);
+            cover_cell* cells = pod_allocator<cover_cell>::allocate(cap);
+            if (!cells) {
+                return 0;
+            }
+            if (m_cells) {
+                mem_copy(cells, m_cells, m_num_cells * sizeof(cover_cell));
+                pod_allocator<cover_cell>::deallocate(m_cells, m_capacity);
+            }
+            m_cells = cells;
+            m_capacity = cap;
+        }
+
+        cover_cell* cells = m_cells + m_num_cells;
+        for (uint32_t i = 0; i < num; i++) {
+            cells[i].cover = 0;
+            cells[i].area = 0;
+        }
+        m_num_cells += num;
+        return cells;
+    }
+
+    // same steps as render_hline of gfx_rasterizer_cells_aa, cells[0] is at x0.
+    static void render_hline(cover_cell* cells, int32_t x0, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+    {
+        int32_t ex1 = x1 >> poly_subpixel_shift;
+        int32_t ex2 = x2 >> poly_subpixel_shift;
+        int32_t fx1 = x1 & poly_subpixel_mask;
+        int32_t fx2 = x2 & poly_subpixel_mask;
+
+        int32_t delta, p, first, dx;
+        int32_t incr, lift, mod, rem;
+
+        if (y1 == y2) {
+            return;
+        }
+
+        cover_cell* cell = cells + (ex1 - x0);
+
+        // everything is located in a single cell.
+        if (ex1 == ex2) {
+            delta = y2 - y1;
+            cell->cover += delta;
+            cell->area += (fx1 + fx2) * delta;
+            return;
+        }
+
+        p = (poly_subpixel_scale - fx1) * (y2 - y1);
+        first = poly_subpixel_scale;
+        incr = 1;
+
+        dx = x2 - x1;
+
+        if (dx < 0) {
+            p = fx1 * (y2 - y1);
+            first = 0;
+            incr = -1;
+            dx = -dx;
+        }
+
+        delta = p / dx;
+        mod = p % dx;
+
+        if (mod < 0) {
+            delta--;
+            mod += dx;
+        }
+
+        cell->cover += delta;
+        cell->area += (fx1 + first) * delta;
+
+        ex1 += incr;
+        cell += incr;
+        y1 += delta;
+
+        if (ex1 != ex2) {
+            p = (int32_t)((uint32_t)(y2 - y1 + delta) << poly_subpixel_shift);
+            lift = p / dx;
+            rem = p % dx;
+
+            if (rem < 0) {
+                lift--;
+                rem += dx;
+            }
+
+            mod -= dx;
+
+            while (ex1 != ex2) {
+                delta = lift;
+                mod += rem;
+                if (mod >= 0) {
+                    mod -= dx;
+                    delta++;
+                }
+
+                cell->cover += delta;
+                cell->area += (int32_t)((uint32_t)delta << poly_subpixel_shift);
+                y1 += delta;
+                ex1 += incr;
+                cell += incr;
+            }
+        }
+        delta = y2 - y1;
+        cell->cover += delta;
+        cell->area += (fx2 + poly_subpixel_scale - first) * delta;
+    }
+
+private:
+    gfx_rasterizer_convex_cells(const gfx_rasterizer_convex_cells&);
+    const gfx_rasterizer_convex_cells& operator = (const gfx_rasterizer_convex_cells&);
+
+    pod_bvector<edge> m_lines;
+    pod_vector<edge> m_edges;
+    pod_vector<scanline_runs> m_rows;
+    chain m_chains[2];
+    cover_cell* m_cells;
+    uint32_t m_num_cells;
+    uint32_t m_capacity;
+    int32_t m_min_x;
+    int32_t m_min_y;
+    int32_t m_max_x;
+    int32_t m_max_y;
+    bool m_built;
+    bool m_rect;
+    rect_box m_rect_box;
 };
 
 }
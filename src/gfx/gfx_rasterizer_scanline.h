@@ -163,6 +163,7 @@ public:
         , m_status(status_initial)
         , m_scan_y(0)
         , m_auto_close(true)
+        , m_convex(false)
     {
         if (!m_gamma) {
             for (int32_t i = 0; i < aa_scale; i++) {
@@ -176,6 +177,7 @@ public:
     void reset(void)
     {
         m_outline.reset();
+        m_convex_outline.reset();
         m_status = status_initial;
     }
 
@@ -189,6 +191,20 @@ public:
         m_auto_close = flag;
     }
 
+    void sort_type(cell_sort_type type)
+    {
+        m_outline.sort_type(type);
+    }
+
+    // The outline is a single convex contour, its cells are made in the order
+    // of scanlines by walking the edge chains, there is nothing to sort. It is
+    // checked when the outline is swept, the edges go into the cells rasterizer
+    // if the contour is not y-monotone.
+    void convex(bool flag)
+    {
+        m_convex = flag;
+    }
+
     bool initial(void)
     {
         return m_status == status_initial;
@@ -201,7 +217,7 @@ public:
 
     void move_to(int32_t x, int32_t y)
     {
-        if (m_outline.sorted()) {
+        if (sorted()) {
             reset();
         }
         if (m_auto_close) {
@@ -215,14 +231,17 @@ public:
 
     void line_to(int32_t x, int32_t y)
     {
-        m_gen.line_to(m_outline, gen_type::downscale(x),
-                      gen_type::downscale(y));
+        if (m_convex) {
+            m_gen.line_to(m_convex_outline, gen_type::downscale(x), gen_type::downscale(y));
+        } else {
+            m_gen.line_to(m_outline, gen_type::downscale(x), gen_type::downscale(y));
+        }
         m_status = status_line_to;
     }
 
     void move_to_d(scalar x, scalar y)
     {
-        if (m_outline.sorted()) {
+        if (sorted()) {
             reset();
         }
         if (m_auto_close) {
@@ -236,15 +255,22 @@ public:
 
     void line_to_d(scalar x, scalar y)
     {
-        m_gen.line_to(m_outline, gen_type::upscale(x),
-                      gen_type::upscale(y));
+        if (m_convex) {
+            m_gen.line_to(m_convex_outline, gen_type::upscale(x), gen_type::upscale(y));
+        } else {
+            m_gen.line_to(m_outline, gen_type::upscale(x), gen_type::upscale(y));
+        }
         m_status = status_line_to;
     }
 
     void close_polygon(void)
     {
         if (m_status == status_line_to) {
-            m_gen.line_to(m_outline, m_start_x, m_start_y);
+            if (m_convex) {
+                m_gen.line_to(m_convex_outline, m_start_x, m_start_y);
+            } else {
+                m_gen.line_to(m_outline, m_start_x, m_start_y);
+            }
             m_status = status_closed;
         }
     }
@@ -262,7 +288,7 @@ public:
 
     void edge(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
     {
-        if (m_outline.sorted()) {
+        if (sorted()) {
             reset();
         }
 
@@ -273,7 +299,7 @@ public:
 
     void edge_d(scalar x1, scalar y1, scalar x2, scalar y2)
     {
-        if (m_outline.sorted()) {
+        if (sorted()) {
             reset();
         }
 
@@ -289,7 +315,7 @@ public:
 
         uint32_t cmd;
         vs.rewind(path_id);
-        if (m_outline.sorted()) {
+        if (sorted()) {
             reset();
         }
 
@@ -298,10 +324,40 @@ public:
         }
     }
 
-    int32_t min_x(void) const { return m_outline.min_x(); }
-    int32_t min_y(void) const { return m_outline.min_y(); }
-    int32_t max_x(void) const { return m_outline.max_x(); }
-    int32_t max_y(void) const { return m_outline.max_y(); }
+    // Number of the cells of the outline, they can be copied by copy_cells.
+    // Zero if there is nothing to copy, or the cells are not kept.
+    uint32_t num_cells(void)
+    {
+        sort();
+        if (convex_outline() || m_outline.accumulated()) {
+            return 0;
+        }
+        return m_outline.total_cells();
+    }
+
+    void copy_cells(cell* cells) const
+    {
+        m_outline.copy_cells(cells);
+    }
+
+    // Add the cells of another outline at a pixel offset.
+    void add_cells(const cell* cells, uint32_t num, int32_t dx, int32_t dy)
+    {
+        if (sorted()) {
+            reset();
+        }
+        if (m_auto_close) {
+            close_polygon();
+        }
+
+        m_outline.add_cells(cells, num, dx, dy);
+        m_status = status_closed;
+    }
+
+    int32_t min_x(void) const { return convex_outline() ? m_convex_outline.min_x() : m_outline.min_x(); }
+    int32_t min_y(void) const { return convex_outline() ? m_convex_outline.min_y() : m_outline.min_y(); }
+    int32_t max_x(void) const { return convex_outline() ? m_convex_outline.max_x() : m_outline.max_x(); }
+    int32_t max_y(void) const { return convex_outline() ? m_convex_outline.max_y() : m_outline.max_y(); }
 
     void sort(void)
     {
@@ -309,7 +365,9 @@ public:
             close_polygon();
         }
 
-        m_outline.sort_cells();
+        if (!build_convex()) {
+            m_outline.sort_cells();
+        }
     }
 
     bool rewind_scanlines(void)
@@ -318,6 +376,14 @@ public:
             close_polygon();
         }
 
+        if (build_convex()) {
+            if (m_convex_outline.empty()) {
+                return false;
+            }
+            m_scan_y = m_convex_outline.min_y();
+            return true;
+        }
+
         m_outline.sort_cells();
         if (m_outline.total_cells() == 0) {
             return false;
@@ -327,12 +393,48 @@ public:
         return true;
     }
 
+    // Return true if the outline is an axis aligned rectangle on pixel
+    // boundaries, its pixels are from (x1, y1) to (x2, y2) exclusive and
+    // alpha is the coverage of each of them.
+    bool pixel_rectangle(int32_t* x1, int32_t* y1, int32_t* x2, int32_t* y2, uint32_t* alpha)
+    {
+        if (m_auto_close) {
+            close_polygon();
+        }
+
+        if (!build_convex() || m_convex_outline.empty()) {
+            return false;
+        }
+
+        const gfx_rasterizer_convex_cells::rect_box* r = m_convex_outline.rectangle();
+        if (!r || ((r->x1 | r->y1 | r->x2 | r->y2) & poly_subpixel_mask)) {
+            return false;
+        }
+
+        *x1 = r->x1 >> poly_subpixel_shift;
+        *y1 = r->y1 >> poly_subpixel_shift;
+        *x2 = r->x2 >> poly_subpixel_shift;
+        *y2 = r->y2 >> poly_subpixel_shift;
+        *alpha = calculate_alpha(r->dir << ((poly_subpixel_shift << 1) + 1));
+        return true;
+    }
+
     bool navigate_scanline(int32_t y)
     {
         if (m_auto_close) {
             close_polygon();
         }
 
+        if (build_convex()) {
+            if (m_convex_outline.empty()
+                || y < m_convex_outline.min_y()
+                || y > m_convex_outline.max_y()) {
+                return false;
+            }
+            m_scan_y = y;
+            return true;
+        }
+
         m_outline.sort_cells();
         if (m_outline.total_cells() == 0
             || y < m_outline.min_y()
@@ -365,17 +467,64 @@ public:
         return m_gamma[cover];
     }
 
+    // Bin the cells into scanlines for tile sweeping, the X-arrays are
+    // arranged by each tile with arrange_scanlines.
+    bool rewind_tiles(void)
+    {
+        if (m_auto_close) {
+            close_polygon();
+        }
+
+        if (build_convex()) {
+            return !m_convex_outline.empty();
+        }
+
+        m_outline.bin_cells();
+        return m_outline.total_cells() != 0;
+    }
+
+    void arrange_scanlines(int32_t y1, int32_t y2)
+    {
+        if (!sorted()) {
+            m_outline.sort_scanline_cells(y1, y2);
+        }
+    }
+
+    // Tiles from y1 to y2 are arranged, the rasterizer is sorted if they cover all scanlines.
+    void finish_tiles(int32_t y1, int32_t y2)
+    {
+        if (y1 <= m_outline.min_y() && y2 >= m_outline.max_y()) {
+            m_outline.set_sorted();
+        }
+    }
+
     template <typename Scanline>
     bool sweep_scanline(Scanline& sl)
     {
+        return sweep_scanline(sl, m_scan_y, max_y());
+    }
+
+    // Sweep scanlines from scan_y to max_y, it does not change the rasterizer,
+    // so tiles of one rasterizer can be swept at the same time.
+    template <typename Scanline>
+    bool sweep_scanline(Scanline& sl, int32_t& scan_y, int32_t max_y) const
+    {
+        if (convex_outline()) {
+            return sweep_scanline_convex(sl, scan_y, max_y);
+        }
+
+        if (m_outline.accumulated()) {
+            return sweep_scanline_covers(sl, scan_y, max_y);
+        }
+
         for (;;) {
-            if (m_scan_y > m_outline.max_y()) {
+            if (scan_y > max_y) {
                 return false;
             }
 
             sl.reset_spans();
-            uint32_t num_cells = m_outline.scanline_num_cells(m_scan_y);
-            const cell* const* cells = m_outline.scanline_cells(m_scan_y);
+            uint32_t num_cells = m_outline.scanline_num_cells(scan_y);
+            const cell* const* cells = m_outline.scanline_cells(scan_y);
             int32_t cover = 0;
 
             while (num_cells) {
@@ -415,21 +564,124 @@ public:
             if (sl.num_spans()) {
                 break;
             }
-            ++m_scan_y;
+            ++scan_y;
+        }
+
+        sl.finalize(scan_y);
+        ++scan_y;
+        return true;
+    }
+
+    // Sweep the accumulated coverage buffer, the prefix sum of the row is the
+    // area of each pixel, pixels with the same area are added as a span.
+    template <typename Scanline>
+    bool sweep_scanline_covers(Scanline& sl, int32_t& scan_y, int32_t max_y) const
+    {
+        for (;;) {
+            if (scan_y > max_y) {
+                return false;
+            }
+
+            sl.reset_spans();
+            int32_t x1 = 0, x2 = -1;
+            const int32_t* covers = m_outline.scanline_covers(scan_y, &x1, &x2);
+            int32_t area = 0;
+            int32_t x = x1;
+
+            while (x <= x2) {
+                int32_t start = x++;
+                area += *covers++;
+
+                while (x <= x2 && *covers == 0) {
+                    ++covers;
+                    ++x;
+                }
+
+                uint32_t alpha = calculate_alpha(area);
+                if (alpha) {
+                    if (x - start > 1) {
+                        sl.add_span(start, x - start, alpha);
+                    } else {
+                        sl.add_cell(start, alpha);
+                    }
+                }
+            }
+
+            if (sl.num_spans()) {
+                break;
+            }
+            ++scan_y;
+        }
+
+        sl.finalize(scan_y);
+        ++scan_y;
+        return true;
+    }
+
+    // Sweep the scanlines computed from the convex outline.
+    template <typename Scanline>
+    bool sweep_scanline_convex(Scanline& sl, int32_t& scan_y, int32_t max_y) const
+    {
+        for (;;) {
+            if (scan_y > max_y) {
+                return false;
+            }
+
+            sl.reset_spans();
+            if (m_convex_outline.rectangle()) {
+                add_rect_cells(sl, scan_y);
+            } else {
+                add_convex_cells(sl, m_convex_outline.scanline(scan_y));
+            }
+
+            if (sl.num_spans()) {
+                break;
+            }
+            ++scan_y;
         }
 
-        sl.finalize(m_scan_y);
-        ++m_scan_y;
+        sl.finalize(scan_y);
+        ++scan_y;
         return true;
     }
 
     template <typename Scanline>
     bool sweep_scanline_hit(Scanline& sl)
     {
-        if (m_scan_y > m_outline.max_y()) {
+        if (m_scan_y > max_y()) {
             return false;
         }
 
+        if (convex_outline()) {
+            if (m_convex_outline.rectangle()) {
+                add_rect_cells(sl, m_scan_y);
+            } else {
+                add_convex_cells(sl, m_convex_outline.scanline(m_scan_y));
+            }
+            return true;
+        }
+
+        if (m_outline.accumulated()) {
+            int32_t x1 = 0, x2 = -1;
+            const int32_t* covers = m_outline.scanline_covers(m_scan_y, &x1, &x2);
+            int32_t tx = sl.x();
+            int32_t area = 0;
+
+            if (tx < x1 || tx > x2) {
+                return false;
+            }
+
+            for (int32_t x = x1; x <= tx; x++) {
+                area += *covers++;
+            }
+
+            uint32_t alpha = calculate_alpha(area);
+            if (alpha) {
+                sl.add_cell(tx, alpha);
+            }
+            return true;
+        }
+
         uint32_t num_cells = m_outline.scanline_num_cells(m_scan_y);
         const cell* const* cells = m_outline.scanline_cells(m_scan_y);
         int32_t cover = 0;
@@ -497,7 +749,127 @@ public:
     }
 
 private:
+    bool convex_outline(void) const
+    {
+        return m_convex && (m_convex_outline.built() || m_convex_outline.total_lines());
+    }
+
+    bool sorted(void) const
+    {
+        return m_outline.sorted() || m_convex_outline.built();
+    }
+
+    // Return true if the scanlines are computed from the convex outline,
+    // the edges are moved into the cells if it is not convex.
+    bool build_convex(void)
+    {
+        if (!m_convex || m_convex_outline.built() || !m_convex_outline.total_lines()) {
+            return m_convex_outline.built();
+        }
+
+        if (!m_convex_outline.build()) {
+            m_convex_outline.replay(m_outline);
+            m_convex_outline.reset();
+            return false;
+        }
+        return true;
+    }
+
+    // Cells of the runs are added as sweep_scanline does with the sorted cells,
+    // the empty cells are skipped.
+    template <typename Scanline>
+    void add_convex_cells(Scanline& sl, const gfx_rasterizer_convex_cells::scanline_runs& runs) const
+    {
+        const gfx_rasterizer_convex_cells::cover_cell* c = m_convex_outline.scanline_cells(runs);
+        int32_t cover = 0;
+        int32_t x = 0;
+        bool prev = false;
+
+        for (uint32_t r = 0; r < runs.num; r++) {
+            int32_t cx = runs.x[r];
+            uint32_t alpha;
+
+            for (uint32_t i = runs.len[r]; i; i--, c++, cx++) {
+                if (!(c->cover | c->area)) {
+                    continue;
+                }
+
+                if (prev && cx > x) {
+                    alpha = calculate_alpha((int32_t)((uint32_t)cover << (poly_subpixel_shift + 1)));
+                    if (alpha) {
+                        sl.add_span(x, cx - x, alpha);
+                    }
+                }
+
+                cover += c->cover;
+                x = cx;
+                if (c->area) {
+                    alpha = calculate_alpha((int32_t)((uint32_t)cover << (poly_subpixel_shift + 1)) - c->area);
+                    if (alpha) {
+                        sl.add_cell(x, alpha);
+                    }
+                    x++;
+                }
+                prev = true;
+            }
+        }
+    }
+
+    // Cells of the rectangle in scanline y, the same as sweep_scanline gives
+    // with the cells of its vertical edges. Full covered pixels are one span.
+    template <typename Scanline>
+    void add_rect_cells(Scanline& sl, int32_t y) const
+    {
+        const gfx_rasterizer_convex_cells::rect_box* r = m_convex_outline.rectangle();
+        int32_t top = (int32_t)((uint32_t)y << poly_subpixel_shift);
+        int32_t h = Min(r->y2, top + poly_subpixel_scale) - Max(r->y1, top);
+        if (h <= 0) {
+            return;
+        }
+
+        int32_t ex1 = r->x1 >> poly_subpixel_shift;
+        int32_t ex2 = r->x2 >> poly_subpixel_shift;
+        int32_t fx1 = r->x1 & poly_subpixel_mask;
+        int32_t fx2 = r->x2 & poly_subpixel_mask;
+        int32_t cover = h * r->dir;
+        uint32_t alpha;
+
+        if (ex1 == ex2) {
+            if (fx2 > fx1) {
+                alpha = calculate_alpha(cover * (fx2 - fx1) * 2);
+                if (alpha) {
+                    sl.add_cell(ex1, alpha);
+                }
+            }
+            return;
+        }
+
+        int32_t x = ex1;
+        if (fx1) {
+            alpha = calculate_alpha(cover * (poly_subpixel_scale - fx1) * 2);
+            if (alpha) {
+                sl.add_cell(ex1, alpha);
+            }
+            x++;
+        }
+
+        if (ex2 > x) {
+            alpha = calculate_alpha((int32_t)((uint32_t)cover << (poly_subpixel_shift + 1)));
+            if (alpha) {
+                sl.add_span(x, ex2 - x, alpha);
+            }
+        }
+
+        if (fx2) {
+            alpha = calculate_alpha(cover * fx2 * 2);
+            if (alpha) {
+                sl.add_cell(ex2, alpha);
+            }
+        }
+    }
+
     gfx_rasterizer_cells_aa<cell> m_outline;
+    gfx_rasterizer_convex_cells m_convex_outline;
     gen_type m_gen;
     int32_t m_gamma_table[aa_scale];
     int32_t* m_gamma;
@@ -507,6 +879,7 @@ private:
     uint32_t m_status;
     int32_t m_scan_y;
     bool m_auto_close;
+    bool m_convex;
 };
 
 }
@@ -24,6 +24,7 @@ public:
         : m_pixfmt(0)
         , m_clip_rect(1, 1, 0, 0)
         , m_is_path_clip(false)
+        , m_inside(false)
     {
     }
 
@@ -31,6 +32,7 @@ public:
         : m_pixfmt(&fmt)
         , m_clip_rect(0, 0, fmt.width() - 1, fmt.height() - 1)
         , m_is_path_clip(false)
+        , m_inside(false)
     {
     }
 
@@ -54,6 +56,10 @@ public:
     }
 
     const rect& clip_rect(void) const { return m_clip_rect; }
+    bool has_clip_path(void) const { return m_is_path_clip; }
+
+    // spans are known to be in the clip box, they are blended without clipping.
+    void set_inside(bool b) { m_inside = b; }
 
     int32_t xmin(void) const { return m_clip_rect.x1; }
     int32_t ymin(void) const { return m_clip_rect.y1; }
@@ -284,9 +290,52 @@ public:
         }
     }
 
+    // blend a color with an alpha only source as coverage.
+    template <typename SrcPixelFormatRenderer>
+    void blend_from_color(const SrcPixelFormatRenderer& from, const color_type& color,
+                          const rect* rect_src_ptr = 0, int32_t dx = 0, int32_t dy = 0,
+                          cover_type cover = cover_full)
+    {
+        rect rsrc(0, 0, from.width(), from.height());
+        if (rect_src_ptr) {
+            rsrc.x1 = rect_src_ptr->x1;
+            rsrc.y1 = rect_src_ptr->y1;
+            rsrc.x2 = rect_src_ptr->x2 + 1;
+            rsrc.y2 = rect_src_ptr->y2 + 1;
+        }
+
+        rect rdst(rsrc.x1 + dx, rsrc.y1 + dy, rsrc.x2 + dx, rsrc.y2 + dy);
+        rect rc = clip_rect_area(rdst, rsrc, from.width(), from.height());
+
+        if (rc.x2 <= 0 || rc.y2 <= 0) {
+            return;
+        }
+
+        if (m_is_path_clip) {
+            for (int32_t y = 0; y < rc.y2; y++) {
+                const uint8_t* psrc = from.pix_ptr(rsrc.x1, rsrc.y1 + y);
+                for (int32_t x = 0; x < rc.x2; x++) {
+                    if (psrc[x] && pixel_in_path(rdst.x1 + x, rdst.y1 + y)) {
+                        m_pixfmt->blend_pixel(rdst.x1 + x, rdst.y1 + y, color,
+                                              (cover_type)((psrc[x] * cover + cover_mask) >> cover_shift));
+                    }
+                }
+            }
+        } else {
+            for (int32_t y = 0; y < rc.y2; y++) {
+                m_pixfmt->blend_from_color(from, color, rdst.x1, rdst.y1 + y, rsrc.x1, rsrc.y1 + y, rc.x2, cover);
+            }
+        }
+    }
+
     void blend_hline(int32_t x1, int32_t y, int32_t x2, const color_type& c, cover_type cover)
     {
         normalize(x1, x2);
+        if (m_inside) {
+            m_pixfmt->blend_hline(x1, y, x2 - x1 + 1, c, cover);
+            return;
+        }
+
         if (m_is_path_clip) { // blend for per pixel.
             for (int32_t i = 0; i < (x2 - x1) + 1; i++)
                 if (pixel_in_path(x1 + i, y)) {
@@ -315,6 +364,11 @@ public:
 
     void blend_solid_hspan(int32_t x, int32_t y, int32_t len, const color_type& c, const cover_type* covers)
     {
+        if (m_inside) {
+            m_pixfmt->blend_solid_hspan(x, y, len, c, covers);
+            return;
+        }
+
         if (m_is_path_clip) {
             for (int32_t i = 0; i < len; i++)
                 if (pixel_in_path(x + i, y)) {
@@ -349,6 +403,11 @@ public:
     void blend_color_hspan(int32_t x, int32_t y, int32_t len, const color_type* colors,
                            const cover_type* covers, cover_type cover = cover_full)
     {
+        if (m_inside) {
+            m_pixfmt->blend_color_hspan(x, y, len, colors, covers, cover);
+            return;
+        }
+
         if (m_is_path_clip) {
             for (int32_t i = 0; i < len; i++)
                 if (pixel_in_path(x + i, y)) {
@@ -463,6 +522,7 @@ private:
     pixfmt_type* m_pixfmt;
     rect m_clip_rect;
     bool m_is_path_clip;
+    bool m_inside;
     gfx_rasterizer_scanline_aa<> m_clip_path;
 };
 
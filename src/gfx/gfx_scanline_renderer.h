@@ -131,6 +131,37 @@ void gfx_render_scanlines(Rasterizer& ras, Scanline& sl, Renderer& ren)
     }
 }
 
+// render scanline antialias
+template <typename Scanline, typename Renderer, typename SpanAllocator, typename SpanGenerator>
+void gfx_render_scanline_aa(const Scanline& sl, Renderer& ren,
+                            SpanAllocator& alloc, SpanGenerator& span_gen)
+{
+    int32_t y = sl.y();
+
+    uint32_t num_spans = sl.num_spans();
+    typename Scanline::const_iterator span = sl.begin();
+    for (;;) {
+        int32_t x = span->x;
+        int32_t len = span->len;
+        const typename Scanline::cover_type* covers = span->covers;
+
+        if (len < 0) {
+            len = -len;
+        }
+
+        typename Renderer::color_type* colors = alloc.allocate(len);
+        span_gen.generate(colors, x, y, len);
+
+        ren.blend_color_hspan(x, y, len, colors, (span->len < 0) ? 0 : covers, *covers);
+
+        if (--num_spans == 0) {
+            break;
+        }
+
+        ++span;
+    }
+}
+
 // render scanlines antialias
 template <typename Rasterizer, typename Scanline, typename Renderer,
           typename SpanAllocator, typename SpanGenerator>
@@ -141,30 +172,7 @@ void gfx_render_scanlines_aa(Rasterizer& ras, Scanline& sl, Renderer& ren,
         sl.reset(ras.min_x(), ras.max_x());
         span_gen.prepare();
         while (ras.sweep_scanline(sl)) {
-            int32_t y = sl.y();
-
-            uint32_t num_spans = sl.num_spans();
-            typename Scanline::const_iterator span = sl.begin();
-            for (;;) {
-                int32_t x = span->x;
-                int32_t len = span->len;
-                const typename Scanline::cover_type* covers = span->covers;
-
-                if (len < 0) {
-                    len = -len;
-                }
-
-                typename Renderer::color_type* colors = alloc.allocate(len);
-                span_gen.generate(colors, x, y, len);
-
-                ren.blend_color_hspan(x, y, len, colors, (span->len < 0) ? 0 : covers, *covers);
-
-                if (--num_spans == 0) {
-                    break;
-                }
-
-                ++span;
-            }
+            gfx_render_scanline_aa(sl, ren, alloc, span_gen);
         }
     }
 }
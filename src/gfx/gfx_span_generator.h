@@ -90,6 +90,8 @@ public:
         *y = m_li_y.y();
     }
 
+    const trans_affine& transformer(void) const { return *m_trans; }
+
 private:
     const trans_affine* m_trans;
     gfx_dda2_line_interpolator m_li_x;
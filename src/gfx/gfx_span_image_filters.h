@@ -68,6 +68,159 @@ private:
     uint32_t m_dy_int;
 };
 
+// separable filter for axis aligned transform, the span is filtered by rows and
+// then by columns. source rows filtered horizontally are kept and reused by the
+// following scanlines which use the same rows.
+template <typename ColorType, typename Source, typename Interpolator>
+class gfx_span_image_filter_axis
+{
+public:
+    typedef ColorType color_type;
+    typedef Source source_type;
+    typedef Interpolator interpolator_type;
+    typedef typename color_type::value_type value_type;
+
+    enum {
+        max_rows = image_filter_max_diameter,
+        row_shift = image_filter_shift - 8, // rows keep 8 bits fraction.
+        span_shift = image_filter_shift + 8,
+    };
+
+    gfx_span_image_filter_axis()
+        : m_next(0)
+    {
+        for (uint32_t i = 0; i < max_rows; i++) {
+            m_keys[i].x = m_keys[i].y = 0;
+            m_keys[i].len = 0;
+        }
+    }
+
+    static bool is_axis_aligned(const interpolator_type& inter)
+    {
+        const trans_affine& mtx = inter.transformer();
+        return (mtx.shx() == FLT_TO_SCALAR(0.0f)) && (mtx.shy() == FLT_TO_SCALAR(0.0f));
+    }
+
+    // interpolator must begin at the span, return 4 channels of each pixel in source order.
+    const int32_t* generate(source_type& src, interpolator_type& inter, const image_filter_adapter& filter,
+                            int32_t dx, int32_t dy, int32_t x, uint32_t len)
+    {
+        uint32_t diameter = filter.diameter();
+        int32_t start = filter.start();
+        const int16_t* weight_array = filter.weight_array();
+
+        // column weights of the span.
+        m_cols.allocate(len);
+        m_weights.allocate(len * diameter);
+
+        int32_t sx = 0, sy = 0;
+        for (uint32_t i = 0; i < len; i++) {
+            inter.coordinates(&sx, &sy);
+            sx -= dx;
+            m_cols[i] = (sx >> image_subpixel_shift) + start;
+
+            int32_t x_hr = image_subpixel_mask - (sx & image_subpixel_mask);
+            for (uint32_t j = 0; j < diameter; j++) {
+                m_weights[i * diameter + j] = weight_array[x_hr];
+                x_hr += image_subpixel_scale;
+            }
+            ++inter;
+        }
+
+        // all pixels of the span are on the same source row.
+        sy -= dy;
+        int32_t y_lr = (sy >> image_subpixel_shift) + start;
+        int32_t y_hr = image_subpixel_mask - (sy & image_subpixel_mask);
+
+        uint32_t count = len << 2;
+        m_span.allocate(count);
+        int32_t* fg = &m_span[0];
+
+        for (uint32_t i = 0; i < count; i++) {
+            fg[i] = 1 << (span_shift - 1);
+        }
+
+        for (uint32_t j = 0; j < diameter; j++) {
+            const int32_t* row = filter_row(src, diameter, y_lr + (int32_t)j, x, len);
+            int32_t weight = weight_array[y_hr];
+
+            for (uint32_t i = 0; i < count; i++) {
+                fg[i] += weight * row[i];
+            }
+            y_hr += image_subpixel_scale;
+        }
+
+        for (uint32_t i = 0; i < count; i++) {
+            fg[i] >>= span_shift;
+        }
+        return fg;
+    }
+
+private:
+    const int32_t* filter_row(source_type& src, uint32_t diameter, int32_t y, int32_t x, uint32_t len)
+    {
+        for (uint32_t i = 0; i < max_rows; i++) {
+            if ((m_keys[i].y == y) && (m_keys[i].x == x) && (m_keys[i].len == len)) {
+                return &m_rows[i][0];
+            }
+        }
+
+        // rows are needed from top to bottom, the oldest one is replaced.
+        uint32_t slot = m_next;
+        m_next = (m_next + 1) % max_rows;
+
+        m_keys[slot].x = x;
+        m_keys[slot].y = y;
+        m_keys[slot].len = len;
+        m_rows[slot].allocate(len << 2);
+
+        int32_t* row = &m_rows[slot][0];
+        const int32_t* weights = &m_weights[0];
+
+        for (uint32_t i = 0; i < len; i++) {
+            int32_t fg[4];
+            fg[0] = fg[1] = fg[2] = fg[3] = 1 << (row_shift - 1);
+
+            const value_type* fg_ptr = (const value_type*)src.span(m_cols[i], y, diameter);
+            uint32_t x_count = diameter;
+
+            for (;;) {
+                int32_t weight = *weights++;
+
+                fg[0] += weight * *fg_ptr++;
+                fg[1] += weight * *fg_ptr++;
+                fg[2] += weight * *fg_ptr++;
+                fg[3] += weight * *fg_ptr;
+
+                if (--x_count == 0) {
+                    break;
+                }
+
+                fg_ptr = (const value_type*)src.next_x();
+            }
+
+            *row++ = fg[0] >> row_shift;
+            *row++ = fg[1] >> row_shift;
+            *row++ = fg[2] >> row_shift;
+            *row++ = fg[3] >> row_shift;
+        }
+        return &m_rows[slot][0];
+    }
+
+    struct row_key {
+        int32_t x;
+        int32_t y;
+        uint32_t len;
+    };
+
+    uint32_t m_next;
+    row_key m_keys[max_rows];
+    pod_vector<int32_t> m_rows[max_rows];
+    pod_vector<int32_t> m_cols;
+    pod_vector<int32_t> m_weights;
+    pod_vector<int32_t> m_span;
+};
+
 // rgba color format filters
 // span image filter rgba
 template <typename ColorType, typename Source, typename Interpolator>
@@ -81,6 +234,7 @@ public:
     typedef gfx_span_image_filter<color_type, source_type, interpolator_type> base_type;
     typedef typename color_type::value_type value_type;
     typedef typename color_type::calc_type calc_type;
+    typedef gfx_span_image_filter_axis<color_type, source_type, interpolator_type> axis_type;
 
     enum {
         base_shift = color_type::base_shift,
@@ -90,6 +244,7 @@ public:
     explicit gfx_span_image_filter_rgba(source_type& src,
                                         interpolator_type& inter, const image_filter_adapter& filter)
         : base_type(src, inter, &filter)
+        , m_axis_aligned(axis_type::is_axis_aligned(inter))
     {
     }
 
@@ -98,6 +253,21 @@ public:
         base_type::interpolator().begin(x + base_type::filter_dx_flt(),
                                         y + base_type::filter_dy_flt(), len);
 
+        if (m_axis_aligned) {
+            const int32_t* fg = m_axis.generate(base_type::source(), base_type::interpolator(), base_type::filter(),
+                                                base_type::filter_dx_int(), base_type::filter_dy_int(), x, len);
+            do {
+                int32_t a = Min(Max(fg[order_type::A], 0), (int32_t)base_mask);
+                span->r = (value_type)Min(Max(fg[order_type::R], 0), a);
+                span->g = (value_type)Min(Max(fg[order_type::G], 0), a);
+                span->b = (value_type)Min(Max(fg[order_type::B], 0), a);
+                span->a = (value_type)a;
+                ++span;
+                fg += 4;
+            } while (--len);
+            return;
+        }
+
         int32_t fg[4];
         const value_type* fg_ptr;
 
@@ -182,6 +352,10 @@ public:
 
         } while (--len);
     }
+
+private:
+    bool m_axis_aligned;
+    axis_type m_axis;
 };
 
 // span image filter rgba no blending
@@ -196,6 +370,7 @@ public:
     typedef gfx_span_image_filter<color_type, source_type, interpolator_type> base_type;
     typedef typename color_type::value_type value_type;
     typedef typename color_type::calc_type calc_type;
+    typedef gfx_span_image_filter_axis<color_type, source_type, interpolator_type> axis_type;
 
     enum {
         base_shift = color_type::base_shift,
@@ -205,6 +380,7 @@ public:
     explicit gfx_span_image_filter_rgba_nb(source_type& src,
                                            interpolator_type& inter, const image_filter_adapter& filter)
         : base_type(src, inter, &filter)
+        , m_axis_aligned(axis_type::is_axis_aligned(inter))
     {
     }
 
@@ -213,6 +389,20 @@ public:
         base_type::interpolator().begin(x + base_type::filter_dx_flt(),
                                         y + base_type::filter_dy_flt(), len);
 
+        if (m_axis_aligned) {
+            const int32_t* fg = m_axis.generate(base_type::source(), base_type::interpolator(), base_type::filter(),
+                                                base_type::filter_dx_int(), base_type::filter_dy_int(), x, len);
+            do {
+                span->r = (value_type)Max(fg[order_type::R], 0);
+                span->g = (value_type)Max(fg[order_type::G], 0);
+                span->b = (value_type)Max(fg[order_type::B], 0);
+                span->a = base_mask;
+                ++span;
+                fg += 4;
+            } while (--len);
+            return;
+        }
+
         int32_t fg[4];
         const value_type* fg_ptr;
 
@@ -291,6 +481,10 @@ public:
             ++base_type::interpolator();
         } while (--len);
     }
+
+private:
+    bool m_axis_aligned;
+    axis_type m_axis;
 };
 
 //span image filter rgba nearest
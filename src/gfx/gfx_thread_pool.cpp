@@ -0,0 +1,225 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#include "common.h"
+#include "thread_sync.h"
+#include "gfx_thread_pool.h"
+
+#if ENABLE(MULTI_THREADS)
+
+using namespace picasso;
+
+namespace gfx {
+
+class gfx_thread_pool_impl
+{
+public:
+    gfx_thread_pool_impl(uint32_t threads)
+        : m_threads(threads)
+        , m_workers(0)
+        , m_handles(0)
+        , m_generation(0)
+        , m_busy(0)
+        , m_quit(false)
+        , m_func(0)
+        , m_data(0)
+        , m_count(0)
+        , m_next(0)
+    {
+        mutex_init(&m_run_lock);
+        mutex_init(&m_lock);
+        cond_init(&m_work_cond);
+        cond_init(&m_done_cond);
+    }
+
+    ~gfx_thread_pool_impl()
+    {
+        mutex_lock(&m_lock);
+        m_quit = true;
+        cond_broadcast(&m_work_cond);
+        mutex_unlock(&m_lock);
+
+        for (uint32_t i = 0; i < m_workers; i++) {
+#if defined(WIN32)
+            WaitForSingleObject(m_handles[i], INFINITE);
+            CloseHandle(m_handles[i]);
+#else
+            pthread_join(m_handles[i], NULL);
+#endif
+        }
+
+        if (m_handles) {
+            mem_free(m_handles);
+        }
+
+        cond_destroy(&m_done_cond);
+        cond_destroy(&m_work_cond);
+        mutex_destroy(&m_lock);
+        mutex_destroy(&m_run_lock);
+    }
+
+    bool start(void)
+    {
+        m_handles = (thread_type*)mem_calloc(m_threads, sizeof(thread_type));
+        if (!m_handles) {
+            return false;
+        }
+
+        // the calling thread is one of the threads.
+        for (uint32_t i = 1; i < m_threads; i++) {
+#if defined(WIN32)
+            HANDLE h = CreateThread(NULL, 0, worker_entry, this, 0, NULL);
+            if (!h) {
+                return false;
+            }
+            m_handles[m_workers++] = h;
+#else
+            if (pthread_create(&m_handles[m_workers], NULL, worker_entry, this) != 0) {
+                return false;
+            }
+            m_workers++;
+#endif
+        }
+        return true;
+    }
+
+    void run(gfx_thread_pool::task_func func, void* data, uint32_t count)
+    {
+        mutex_lock(&m_run_lock);
+
+        mutex_lock(&m_lock);
+        m_func = func;
+        m_data = data;
+        m_count = count;
+        m_next = 0;
+        m_busy = m_workers;
+        m_generation++;
+        cond_broadcast(&m_work_cond);
+        mutex_unlock(&m_lock);
+
+        execute();
+
+        mutex_lock(&m_lock);
+        while (m_busy) {
+            cond_wait(&m_done_cond, &m_lock);
+        }
+        mutex_unlock(&m_lock);
+
+        mutex_unlock(&m_run_lock);
+    }
+
+    uint32_t m_threads;
+private:
+    void execute(void)
+    {
+        for (;;) {
+            uint32_t index = atomic_fetch_inc(&m_next);
+            if (index >= m_count) {
+                break;
+            }
+            m_func(m_data, index);
+        }
+    }
+
+    void worker(void)
+    {
+        uint32_t generation = 0;
+
+        mutex_lock(&m_lock);
+        for (;;) {
+            while (!m_quit && generation == m_generation) {
+                cond_wait(&m_work_cond, &m_lock);
+            }
+
+            if (m_quit) {
+                break;
+            }
+
+            generation = m_generation;
+            mutex_unlock(&m_lock);
+
+            execute();
+
+            mutex_lock(&m_lock);
+            if (--m_busy == 0) {
+                cond_signal(&m_done_cond);
+            }
+        }
+        mutex_unlock(&m_lock);
+    }
+
+#if defined(WIN32)
+    static DWORD WINAPI worker_entry(LPVOID param)
+    {
+        static_cast<gfx_thread_pool_impl*>(param)->worker();
+        return 0;
+    }
+#else
+    static void* worker_entry(void* param)
+    {
+        static_cast<gfx_thread_pool_impl*>(param)->worker();
+        return NULL;
+    }
+#endif
+
+    uint32_t m_workers;
+    thread_type* m_handles;
+    mutex_type m_run_lock;
+    mutex_type m_lock;
+    cond_type m_work_cond;
+    cond_type m_done_cond;
+    uint32_t m_generation;
+    uint32_t m_busy;
+    bool m_quit;
+    // current tasks
+    gfx_thread_pool::task_func m_func;
+    void* m_data;
+    uint32_t m_count;
+    volatile uint32_t m_next;
+};
+
+gfx_thread_pool* gfx_thread_pool::create(uint32_t threads)
+{
+    if (threads < 2) {
+        return 0;
+    }
+
+    gfx_thread_pool_impl* impl = new gfx_thread_pool_impl(threads);
+    if (!impl->start()) {
+        delete impl;
+        return 0;
+    }
+
+    return new gfx_thread_pool(impl);
+}
+
+gfx_thread_pool::gfx_thread_pool(gfx_thread_pool_impl* impl)
+    : m_impl(impl)
+{
+}
+
+gfx_thread_pool::~gfx_thread_pool()
+{
+    delete m_impl;
+}
+
+uint32_t gfx_thread_pool::threads(void) const
+{
+    return m_impl->m_threads;
+}
+
+void gfx_thread_pool::run(task_func func, void* data, uint32_t count)
+{
+    if (count == 1) {
+        func(data, 0);
+        return;
+    }
+
+    m_impl->run(func, data, count);
+}
+
+}
+#endif /*MULTI_THREADS*/
@@ -0,0 +1,41 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#ifndef _GFX_THREAD_POOL_H_
+#define _GFX_THREAD_POOL_H_
+
+#include "common.h"
+#include "non_copy.h"
+
+namespace gfx {
+
+class gfx_thread_pool_impl;
+
+// thread pool for tile rendering, the calling thread works as one of the threads.
+// tasks are taken from a shared counter, so an idle thread always takes the next
+// one and a slow tile does not hold the others. it is only available when
+// multi threads is enabled.
+class gfx_thread_pool : public picasso::non_copyable
+{
+public:
+    typedef void (*task_func)(void* data, uint32_t index);
+
+    static gfx_thread_pool* create(uint32_t threads);
+    ~gfx_thread_pool();
+
+    uint32_t threads(void) const;
+
+    // call func with each index in [0, count) and wait until all tasks done.
+    // calls from different threads are serialized.
+    void run(task_func func, void* data, uint32_t count);
+private:
+    gfx_thread_pool(gfx_thread_pool_impl* impl);
+
+    gfx_thread_pool_impl* m_impl;
+};
+
+}
+#endif /*_GFX_THREAD_POOL_H_*/
@@ -0,0 +1,207 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#ifndef _GFX_TILE_RENDERER_H_
+#define _GFX_TILE_RENDERER_H_
+
+#include "common.h"
+#include "math_type.h"
+
+#include "gfx_scanline_renderer.h"
+#include "gfx_scanline_storage.h"
+#include "gfx_thread_pool.h"
+
+namespace gfx {
+
+enum {
+    tile_min_rows = 16, // minimum scanlines of a tile.
+    tile_min_pixels = 65536, // shape with smaller bounding box is rendered by one thread.
+    tile_per_thread = 4, // more tiles than threads for balance.
+};
+
+// Scanlines of a rasterizer are split into horizontal tiles. Cells of a tile are
+// arranged and swept by the thread which takes it, the tile only blends its own rows,
+// so tiles are independent and give the same pixels as rendering in one thread.
+template <typename Rasterizer>
+class gfx_tile_scanlines
+{
+public:
+    explicit gfx_tile_scanlines(Rasterizer& ras)
+        : m_ras(ras)
+        , m_y1(0)
+        , m_y2(0)
+        , m_height(0)
+        , m_count(0)
+    {
+    }
+
+    // split visible scanlines into tiles, return false if the shape is too small.
+    bool plan(uint32_t threads, int32_t clip_y1, int32_t clip_y2)
+    {
+        if (!m_ras.rewind_tiles()) {
+            return false;
+        }
+
+        m_y1 = Max(m_ras.min_y(), clip_y1);
+        m_y2 = Min(m_ras.max_y(), clip_y2);
+        if (m_y1 > m_y2) {
+            return false;
+        }
+
+        int32_t rows = m_y2 - m_y1 + 1;
+        if (rows < (tile_min_rows << 1)
+            || (int64_t)(m_ras.max_x() - m_ras.min_x() + 1) * rows < tile_min_pixels) {
+            return false;
+        }
+
+        m_height = rows / (int32_t)(threads * tile_per_thread);
+        if (m_height < tile_min_rows) {
+            m_height = tile_min_rows;
+        }
+
+        m_count = (uint32_t)((rows + m_height - 1) / m_height);
+        return true;
+    }
+
+    // arrange cells of tile and give its scanlines range.
+    void arrange(uint32_t index, int32_t* y1, int32_t* y2)
+    {
+        *y1 = m_y1 + (int32_t)index * m_height;
+        *y2 = Min(*y1 + m_height - 1, m_y2);
+        m_ras.arrange_scanlines(*y1, *y2);
+    }
+
+    void finish(void)
+    {
+        m_ras.finish_tiles(m_y1, m_y2);
+    }
+
+    Rasterizer& rasterizer(void) { return m_ras; }
+    uint32_t count(void) const { return m_count; }
+private:
+    Rasterizer& m_ras;
+    int32_t m_y1;
+    int32_t m_y2;
+    int32_t m_height;
+    uint32_t m_count;
+};
+
+// tile task with solid renderer
+template <typename Rasterizer, typename Scanline, typename Renderer>
+struct gfx_tile_task_solid {
+    gfx_tile_scanlines<Rasterizer>* tiles;
+    const Renderer* ren;
+
+    static void render(void* data, uint32_t index)
+    {
+        gfx_tile_task_solid* t = static_cast<gfx_tile_task_solid*>(data);
+        Rasterizer& ras = t->tiles->rasterizer();
+
+        int32_t y1, y2;
+        t->tiles->arrange(index, &y1, &y2);
+
+        Scanline sl;
+        Renderer ren(*(t->ren));
+        sl.reset(ras.min_x(), ras.max_x());
+        ren.prepare();
+        while (ras.sweep_scanline(sl, y1, y2)) {
+            ren.render(sl);
+        }
+    }
+};
+
+// tile task with span generator, each tile has its own interpolator.
+template <typename Rasterizer, typename Scanline, typename Renderer,
+          typename SpanAllocator, typename SpanGenerator, typename Interpolator>
+struct gfx_tile_task_aa {
+    gfx_tile_scanlines<Rasterizer>* tiles;
+    Renderer* ren;
+    const SpanGenerator* span_gen;
+    const Interpolator* inter;
+
+    static void render(void* data, uint32_t index)
+    {
+        gfx_tile_task_aa* t = static_cast<gfx_tile_task_aa*>(data);
+        Rasterizer& ras = t->tiles->rasterizer();
+
+        int32_t y1, y2;
+        t->tiles->arrange(index, &y1, &y2);
+
+        Scanline sl;
+        SpanAllocator alloc;
+        Interpolator inter(*(t->inter));
+        SpanGenerator span_gen(*(t->span_gen));
+        span_gen.interpolator(inter);
+
+        sl.reset(ras.min_x(), ras.max_x());
+        span_gen.prepare();
+        while (ras.sweep_scanline(sl, y1, y2)) {
+            gfx_render_scanline_aa(sl, *(t->ren), alloc, span_gen);
+        }
+    }
+};
+
+// render scanlines with tiles in thread pool, visible rows are from clip_y1 to clip_y2.
+template <typename Rasterizer, typename Scanline, typename Renderer>
+void gfx_render_scanlines_tiles(gfx_thread_pool* pool, Rasterizer& ras, Scanline& sl, Renderer& ren,
+                                int32_t clip_y1, int32_t clip_y2)
+{
+#if ENABLE(MULTI_THREADS)
+    gfx_tile_scanlines<Rasterizer> tiles(ras);
+    if (pool && tiles.plan(pool->threads(), clip_y1, clip_y2)) {
+        gfx_tile_task_solid<Rasterizer, Scanline, Renderer> task;
+        task.tiles = &tiles;
+        task.ren = &ren;
+        pool->run(task.render, &task, tiles.count());
+        tiles.finish();
+        return;
+    }
+#endif
+    gfx_render_scanlines(ras, sl, ren);
+}
+
+// render scanlines antialias with tiles in thread pool, visible rows are from clip_y1 to clip_y2.
+template <typename Rasterizer, typename Scanline, typename Renderer,
+          typename SpanAllocator, typename SpanGenerator, typename Interpolator>
+void gfx_render_scanlines_aa_tiles(gfx_thread_pool* pool, Rasterizer& ras, Scanline& sl, Renderer& ren,
+                                   SpanAllocator& alloc, SpanGenerator& span_gen, const Interpolator& inter,
+                                   int32_t clip_y1, int32_t clip_y2)
+{
+#if ENABLE(MULTI_THREADS)
+    gfx_tile_scanlines<Rasterizer> tiles(ras);
+    if (pool && tiles.plan(pool->threads(), clip_y1, clip_y2)) {
+        gfx_tile_task_aa<Rasterizer, Scanline, Renderer, SpanAllocator, SpanGenerator, Interpolator> task;
+        task.tiles = &tiles;
+        task.ren = &ren;
+        task.span_gen = &span_gen;
+        task.inter = &inter;
+        pool->run(task.render, &task, tiles.count());
+        tiles.finish();
+        return;
+    }
+#endif
+    gfx_render_scanlines_aa(ras, sl, ren, alloc, span_gen);
+}
+
+// serialized scanlines have no cells to arrange, they are rendered by one thread.
+template <typename T, typename Scanline, typename Renderer>
+void gfx_render_scanlines_tiles(gfx_thread_pool*, gfx_serialized_scanlines_adaptor_aa<T>& ras, Scanline& sl,
+                                Renderer& ren, int32_t, int32_t)
+{
+    gfx_render_scanlines(ras, sl, ren);
+}
+
+template <typename T, typename Scanline, typename Renderer,
+          typename SpanAllocator, typename SpanGenerator, typename Interpolator>
+void gfx_render_scanlines_aa_tiles(gfx_thread_pool*, gfx_serialized_scanlines_adaptor_aa<T>& ras, Scanline& sl,
+                                   Renderer& ren, SpanAllocator& alloc, SpanGenerator& span_gen, const Interpolator&,
+                                   int32_t, int32_t)
+{
+    gfx_render_scanlines_aa(ras, sl, ren, alloc, span_gen);
+}
+
+}
+#endif /*_GFX_TILE_RENDERER_H_*/
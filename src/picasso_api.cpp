@@ -43,13 +43,29 @@ static inline void _clip_path(context_state* state, const graphic_path& p, filli
     state->clip.rule = r;
 }
 
+static inline void _render_clip(ps_context* ctx, bool clip)
+{
+    if (ctx->record) {
+        ctx->record->pic.record(clip ? picture_op_clip : picture_op_reset_clip, ctx->state);
+    } else {
+        ctx->canvas->p->render_clip(ctx->state, clip);
+    }
+}
+
+static inline void _render_gamma(ps_context* ctx)
+{
+    if (!ctx->record) { // recorded with state.
+        ctx->canvas->p->render_gamma(ctx->state, ctx->raster);
+    }
+}
+
 }
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-ps_status global_status = STATUS_SUCCEED;
+THREAD_LOCAL ps_status global_status = STATUS_SUCCEED;
 
 int32_t PICAPI ps_version(void)
 {
@@ -105,6 +121,23 @@ ps_bool PICAPI ps_set_memory_functions(const ps_memory_funcs* funcs)
 #endif
 }
 
+ps_bool PICAPI ps_set_render_threads(uint32_t threads)
+{
+#if ENABLE(MULTI_THREADS)
+    if (picasso::is_valid_system_device()) { // render threads must be set before call ps_initialize
+        global_status = STATUS_NOT_SUPPORT;
+        return False;
+    }
+
+    picasso::_set_system_device_threads(threads);
+    global_status = STATUS_SUCCEED;
+    return True;
+#else
+    global_status = STATUS_NOT_SUPPORT;
+    return False;
+#endif
+}
+
 ps_context* PICAPI ps_context_create(ps_canvas* canvas, ps_context* ctx)
 {
     if (!picasso::is_valid_system_device()) {
@@ -141,6 +174,7 @@ ps_context* PICAPI ps_context_create(ps_canvas* canvas, ps_context* ctx)
         new ((void*) & (c->text_matrix)) picasso::trans_affine;
         new ((void*) & (c->path)) picasso::graphic_path;
         new ((void*) & (c->raster)) picasso::raster_adapter;
+        c->record = NULL;
         global_status = STATUS_SUCCEED;
         return c;
     } else {
@@ -163,7 +197,9 @@ ps_canvas* PICAPI ps_context_set_canvas(ps_context* ctx, ps_canvas* canvas)
     }
     ps_canvas* old = ctx->canvas; // context's canvas must more than 2
     ctx->canvas = ps_canvas_ref(canvas);
-    ps_canvas_unref(old);// release context's reference
+    if (old) { // recording context has no canvas.
+        ps_canvas_unref(old);// release context's reference
+    }
     global_status = STATUS_SUCCEED;
     return old;
 }
@@ -197,7 +233,7 @@ ps_context* PICAPI ps_context_ref(ps_context* ctx)
         return NULL;
     }
 
-    ctx->refcount++;
+    picasso::atomic_inc(&ctx->refcount);
     global_status = STATUS_SUCCEED;
     return ctx;
 }
@@ -214,9 +250,13 @@ void PICAPI ps_context_unref(ps_context* ctx)
         return;
     }
 
-    ctx->refcount--;
-    if (ctx->refcount <= 0) {
-        ps_canvas_unref(ctx->canvas);
+    if (picasso::atomic_dec(&ctx->refcount) <= 0) {
+        if (ctx->canvas) {
+            ps_canvas_unref(ctx->canvas);
+        }
+        if (ctx->record) {
+            ps_picture_unref(ctx->record);
+        }
         while (ctx->state) {
             picasso::context_state* p = ctx->state;
             ctx->state = ctx->state->next;
@@ -443,9 +483,13 @@ void PICAPI ps_stroke(ps_context* ctx)
         return;
     }
 
-    ctx->canvas->p->render_shadow(ctx->state, ctx->path, false, true);
-    ctx->canvas->p->render_stroke(ctx->state, ctx->raster, ctx->path);
-    ctx->canvas->p->render_blur(ctx->state);
+    if (ctx->record) {
+        ctx->record->pic.record(picasso::picture_op_stroke, ctx->state, ctx->path);
+    } else {
+        ctx->canvas->p->render_shadow(ctx->state, ctx->path, false, true);
+        ctx->canvas->p->render_stroke(ctx->state, ctx->raster, ctx->path);
+        ctx->canvas->p->render_blur(ctx->state);
+    }
     ctx->path.free_all();
     ctx->raster.reset();
     global_status = STATUS_SUCCEED;
@@ -463,9 +507,13 @@ void PICAPI ps_fill(ps_context* ctx)
         return;
     }
 
-    ctx->canvas->p->render_shadow(ctx->state, ctx->path, true, false);
-    ctx->canvas->p->render_fill(ctx->state, ctx->raster, ctx->path);
-    ctx->canvas->p->render_blur(ctx->state);
+    if (ctx->record) {
+        ctx->record->pic.record(picasso::picture_op_fill, ctx->state, ctx->path);
+    } else {
+        ctx->canvas->p->render_shadow(ctx->state, ctx->path, true, false);
+        ctx->canvas->p->render_fill(ctx->state, ctx->raster, ctx->path);
+        ctx->canvas->p->render_blur(ctx->state);
+    }
     ctx->path.free_all();
     ctx->raster.reset();
     global_status = STATUS_SUCCEED;
@@ -483,9 +531,13 @@ void PICAPI ps_paint(ps_context* ctx)
         return;
     }
 
-    ctx->canvas->p->render_shadow(ctx->state, ctx->path, true, true);
-    ctx->canvas->p->render_paint(ctx->state, ctx->raster, ctx->path);
-    ctx->canvas->p->render_blur(ctx->state);
+    if (ctx->record) {
+        ctx->record->pic.record(picasso::picture_op_paint, ctx->state, ctx->path);
+    } else {
+        ctx->canvas->p->render_shadow(ctx->state, ctx->path, true, true);
+        ctx->canvas->p->render_paint(ctx->state, ctx->raster, ctx->path);
+        ctx->canvas->p->render_blur(ctx->state);
+    }
     ctx->path.free_all();
     ctx->raster.reset();
     global_status = STATUS_SUCCEED;
@@ -503,7 +555,11 @@ void PICAPI ps_clear(ps_context* ctx)
         return;
     }
 
-    ctx->canvas->p->render_clear(ctx->state);
+    if (ctx->record) {
+        ctx->record->pic.record(picasso::picture_op_clear, ctx->state);
+    } else {
+        ctx->canvas->p->render_clear(ctx->state);
+    }
     global_status = STATUS_SUCCEED;
 }
 
@@ -579,7 +635,7 @@ float PICAPI ps_set_gamma(ps_context* ctx, float g)
     float rd = SCALAR_TO_FLT(ctx->state->gamma);
     if (rd != g) {
         ctx->state->gamma = FLT_TO_SCALAR(g);
-        ctx->canvas->p->render_gamma(ctx->state, ctx->raster);
+        picasso::_render_gamma(ctx);
     }
     global_status = STATUS_SUCCEED;
     return rd;
@@ -600,7 +656,7 @@ void PICAPI ps_set_antialias(ps_context* ctx, ps_bool anti)
     ps_bool old = ctx->state->antialias ? True : False;
     if (old != anti) {
         ctx->state->antialias = anti ? true : false;
-        ctx->canvas->p->render_gamma(ctx->state, ctx->raster);
+        picasso::_render_gamma(ctx);
     }
     global_status = STATUS_SUCCEED;
 }
@@ -1155,6 +1211,7 @@ void PICAPI ps_set_path(ps_context* ctx, const ps_path* path)
         return;
     }
 
+    path->path.attach_cache(); // stroked outline reused by copies of the path.
     ctx->path = path->path;
     global_status = STATUS_SUCCEED;
 }
@@ -1476,7 +1533,7 @@ void PICAPI ps_clip(ps_context* ctx)
 
     ctx->state->clip.type = picasso::clip_content;
     picasso::_clip_path(ctx->state, ctx->path, ctx->state->brush.rule);
-    ctx->canvas->p->render_clip(ctx->state, true);
+    picasso::_render_clip(ctx, true);
     ctx->path.free_all();
     global_status = STATUS_SUCCEED;
 }
@@ -1495,7 +1552,7 @@ void PICAPI ps_clip_path(ps_context* ctx, const ps_path* p, ps_fill_rule r)
 
     ctx->state->clip.type = picasso::clip_content;
     picasso::_clip_path(ctx->state, p->path, (picasso::filling_rule)r);
-    ctx->canvas->p->render_clip(ctx->state, true);
+    picasso::_render_clip(ctx, true);
     global_status = STATUS_SUCCEED;
 }
 
@@ -1518,7 +1575,7 @@ void PICAPI ps_scissor_rect(ps_context* ctx, const ps_rect* r)
 
     ctx->state->clip.type = picasso::clip_device;
     ctx->state->clip.rect = tr;
-    ctx->canvas->p->render_clip(ctx->state, true);
+    picasso::_render_clip(ctx, true);
     global_status = STATUS_SUCCEED;
 }
 
@@ -1543,7 +1600,7 @@ void PICAPI ps_clip_rect(ps_context* ctx, const ps_rect* r)
 
     ctx->state->clip.type = picasso::clip_content;
     picasso::_clip_path(ctx->state, path, picasso::fill_non_zero);
-    ctx->canvas->p->render_clip(ctx->state, true);
+    picasso::_render_clip(ctx, true);
     global_status = STATUS_SUCCEED;
 }
 
@@ -1569,7 +1626,7 @@ void PICAPI ps_clip_rects(ps_context* ctx, const ps_rect* rs, uint32_t num_rs)
     }
     ctx->state->clip.type = picasso::clip_content;
     picasso::_clip_path(ctx->state, path, picasso::fill_non_zero);
-    ctx->canvas->p->render_clip(ctx->state, true);
+    picasso::_render_clip(ctx, true);
     global_status = STATUS_SUCCEED;
 }
 
@@ -1585,7 +1642,7 @@ void PICAPI ps_reset_clip(ps_context* ctx)
         return;
     }
 
-    ctx->canvas->p->render_clip(ctx->state, false);
+    picasso::_render_clip(ctx, false);
     ctx->state->clip.rule = picasso::fill_non_zero;
     ctx->state->clip.path.free_all();
     ctx->state->clip.rect = picasso::rect_s(0, 0, 0, 0);
@@ -1633,13 +1690,13 @@ void PICAPI ps_restore(ps_context* ctx)
     ctx->state = ctx->state->next;
 
     if (old_state->clip.is_not_same(ctx->state->clip)) {
-        ctx->canvas->p->render_clip(ctx->state, false);
-        ctx->canvas->p->render_clip(ctx->state, true);
+        picasso::_render_clip(ctx, false);
+        picasso::_render_clip(ctx, true);
     }
 
     if ((old_state->gamma != ctx->state->gamma)
         || (old_state->antialias != ctx->state->antialias)) {
-        ctx->canvas->p->render_gamma(ctx->state, ctx->raster);
+        picasso::_render_gamma(ctx);
     }
 
     delete old_state;
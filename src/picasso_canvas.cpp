@@ -475,7 +475,7 @@ ps_canvas* PICAPI ps_canvas_ref(ps_canvas* canvas)
         return NULL;
     }
 
-    canvas->refcount++;
+    picasso::atomic_inc(&canvas->refcount);
     global_status = STATUS_SUCCEED;
     return canvas;
 }
@@ -492,8 +492,7 @@ void PICAPI ps_canvas_unref(ps_canvas* canvas)
         return;
     }
 
-    canvas->refcount--;
-    if (canvas->refcount <= 0) {
+    if (picasso::atomic_dec(&canvas->refcount) <= 0) {
         delete canvas->p; //mem_free painter
         if (canvas->flage == buffer_alloc_surface) {
             BufferFree(canvas->buffer.buffer());
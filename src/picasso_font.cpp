@@ -19,16 +19,19 @@
 
 namespace picasso {
 
-font_engine::font_engine(uint32_t max_fonts)
-    : m_fonts(pod_allocator<font*>::allocate(max_fonts))
+font_engine::font_engine(uint32_t budget)
+    : m_head(0)
+    , m_tail(0)
     , m_current(0)
-    , m_max_fonts(max_fonts)
+    , m_budget(budget)
+    , m_used(0)
     , m_num_fonts(0)
     , m_signature(0)
     , m_stamp_change(false)
     , m_antialias(false)
 {
-    memset(m_fonts, 0, sizeof(font*) * max_fonts);
+    memset(m_buckets, 0, sizeof(m_buckets));
+    memset(&m_freed_stats, 0, sizeof(m_freed_stats));
     m_signature = (char*)mem_calloc(1, MAX_SIGNATURE_BUFFER_LEN);
 }
 
@@ -38,11 +41,13 @@ font_engine::~font_engine()
         mem_free(m_signature);
     }
 
-    for (uint32_t i = 0; i < m_num_fonts; ++i) {
-        delete m_fonts[i];
+    font_entry* e = m_head;
+    while (e) {
+        font_entry* next = e->lru_next;
+        delete e->inst;
+        mem_free(e);
+        e = next;
     }
-
-    pod_allocator<font*>::deallocate(m_fonts, m_max_fonts);
 }
 
 void font_engine::set_antialias(bool b)
@@ -61,21 +66,117 @@ void font_engine::set_transform(const trans_affine& mtx)
     }
 }
 
-int32_t font_engine::find_font(const char* font_signature)
+void font_engine::set_cache_budget(uint32_t budget)
+{
+    m_budget = budget;
+
+    if (m_current) {
+        update_bytes(m_current);
+    }
+    trim_fonts();
+}
+
+uint32_t font_engine::used_bytes(void) const
+{
+    // glyphs of current font are cached since it is actived.
+    return m_current ? (m_used - m_current->bytes + m_current->inst->memory_used()) : m_used;
+}
+
+void font_engine::glyph_stats(glyph_cache_stats* stats) const
+{
+    *stats = m_freed_stats;
+    for (font_entry* e = m_head; e; e = e->lru_next) {
+        const glyph_cache_stats& s = e->inst->glyph_stats();
+        stats->hits += s.hits;
+        stats->misses += s.misses;
+        stats->evictions += s.evictions;
+    }
+}
+
+uint32_t font_engine::hash(const char* font_signature)
+{
+    // FNV-1a
+    uint32_t h = 2166136261U;
+    while (*font_signature) {
+        h ^= (byte)(*font_signature++);
+        h *= 16777619U;
+    }
+    return h;
+}
+
+font_entry* font_engine::find_font(const char* font_signature, uint32_t h)
 {
-    for (uint32_t i = 0; i < m_num_fonts; i++) {
-        if (strcmp(m_fonts[i]->signature(), font_signature) == 0) {
-            return (int32_t)i;
+    font_entry* e = m_buckets[h & hash_mask];
+    while (e) {
+        if ((e->hash == h) && (strcmp(e->inst->signature(), font_signature) == 0)) {
+            return e;
         }
+        e = e->hash_next;
+    }
+    return 0;
+}
+
+void font_engine::update_bytes(font_entry* e)
+{
+    uint32_t bytes = e->inst->memory_used();
+    m_used = m_used - e->bytes + bytes;
+    e->bytes = bytes;
+}
+
+void font_engine::trim_fonts(void)
+{
+    // current font is the most recently used one, it is never freed.
+    while (m_tail && (m_tail != m_current) && (m_used > m_budget)) {
+        remove(m_tail);
+    }
+}
+
+void font_engine::link_front(font_entry* e)
+{
+    e->lru_prev = 0;
+    e->lru_next = m_head;
+    if (m_head) {
+        m_head->lru_prev = e;
+    } else {
+        m_tail = e;
+    }
+    m_head = e;
+}
+
+void font_engine::unlink(font_entry* e)
+{
+    if (e->lru_prev) {
+        e->lru_prev->lru_next = e->lru_next;
+    } else {
+        m_head = e->lru_next;
+    }
+
+    if (e->lru_next) {
+        e->lru_next->lru_prev = e->lru_prev;
+    } else {
+        m_tail = e->lru_prev;
     }
-    return -1;
 }
 
-void font_engine::relayout_fonts(void)
+void font_engine::remove(font_entry* e)
 {
-    for (uint32_t i = 0; i < m_max_fonts - 1; i++) {
-        m_fonts[i] = m_fonts[i + 1];
+    font_entry** p = &m_buckets[e->hash & hash_mask];
+    while (*p != e) {
+        p = &((*p)->hash_next);
     }
+    *p = e->hash_next;
+
+    unlink(e);
+    m_used -= e->bytes;
+    m_num_fonts--;
+
+    const glyph_cache_stats& s = e->inst->glyph_stats();
+    m_freed_stats.hits += s.hits;
+    m_freed_stats.misses += s.misses;
+    m_freed_stats.evictions += s.evictions;
+
+    delete e->inst;
+    mem_free(e);
 }
 
 bool font_engine::create_font(const font_desc& desc)
@@ -85,25 +186,45 @@ bool font_engine::create_font(const font_desc& desc)
     }
 
     if (m_current) {
-        m_current->deactive();
+        m_current->inst->deactive();
+        // glyphs cached while the font is in use.
+        update_bytes(m_current);
+        m_current = 0;
     }
 
-    int32_t idx = find_font(m_signature);
-    if (idx >= 0) {
-        m_current = m_fonts[idx];
+    uint32_t h = hash(m_signature);
+    font_entry* e = find_font(m_signature, h);
+    if (e) {
+        if (e != m_head) {
+            unlink(e);
+            link_front(e);
+        }
     } else {
-        if (m_num_fonts >= m_max_fonts) {
-            delete m_fonts[0];
-            relayout_fonts(); // just make asan happy!
-            m_num_fonts = m_max_fonts - 1;
+        e = (font_entry*)mem_malloc(sizeof(font_entry));
+        if (!e) {
+            return false;
+        }
+
+        e->inst = new font(desc, m_signature, m_affine, m_antialias);
+        if (!e->inst) {
+            mem_free(e);
+            return false;
         }
 
-        m_fonts[m_num_fonts] = new font(desc, m_signature, m_affine, m_antialias);
-        m_current = m_fonts[m_num_fonts];
+        e->hash = h;
+        e->bytes = e->inst->memory_used();
+        e->hash_next = m_buckets[h & hash_mask];
+        m_buckets[h & hash_mask] = e;
+        link_front(e);
+
+        m_used += e->bytes;
         m_num_fonts++;
     }
 
-    m_current->active();
+    m_current = e;
+    trim_fonts();
+
+    m_current->inst->active();
     m_stamp_change = false;
     return true;
 }
@@ -181,17 +302,25 @@ const glyph* font::get_glyph(uint32_t code)
     } else {
         if (m_impl->prepare_glyph(code)) {
             m_prev_glyph = m_last_glyph;
-            gl = m_cache->cache_glyph(code,
-                                      m_impl->glyph_index(),
-                                      m_impl->data_size(),
-                                      m_impl->data_type(),
-                                      m_impl->bounds(),
-                                      m_impl->height(),
-                                      m_impl->advance_x(),
-                                      m_impl->advance_y());
-            m_impl->write_glyph_to(gl->data);
-            m_last_glyph = gl;
-            return gl;
+            gl = m_cache->find_glyph_index(code, m_impl->glyph_index());
+            if (gl) {
+                m_last_glyph = gl;
+                return gl;
+            }
+
+            glyph* g = m_cache->cache_glyph(code,
+                                            m_impl->glyph_index(),
+                                            m_impl->data_size(),
+                                            m_impl->data_type(),
+                                            m_impl->bounds(),
+                                            m_impl->height(),
+                                            m_impl->advance_x(),
+                                            m_impl->advance_y());
+            if (g) {
+                m_impl->write_glyph_to(g->data);
+            }
+            m_last_glyph = g;
+            return g;
         }
     }
     return 0;
@@ -19,9 +19,13 @@
 #include "picasso_font_cache.h"
 
 #if ENABLE(LOW_MEMORY)
-    #define MAX_FONTS 4
+    #define MAX_FONT_CACHE_BYTES 1048576
+    #define MAX_GLYPH_CACHE_BYTES 262144
+    #define MAX_GLYPH_COVERAGE_BYTES 65536
 #else
-    #define MAX_FONTS 16
+    #define MAX_FONT_CACHE_BYTES 8388608
+    #define MAX_GLYPH_CACHE_BYTES 1048576
+    #define MAX_GLYPH_COVERAGE_BYTES 262144
 #endif
 
 #define MAX_FONT_NAME_LENGTH 128
@@ -187,7 +191,8 @@ class font : public non_copyable
 public:
     font(const font_desc& desc, const char* signature, const trans_affine& mtx, bool antialias)
         : m_desc(desc)
-        , m_cache(new glyph_cache_manager)
+        , m_cache(new glyph_cache_manager(MAX_GLYPH_CACHE_BYTES))
+        , m_coverage(new glyph_coverage_cache(MAX_GLYPH_COVERAGE_BYTES))
         , m_impl(0)
         , m_prev_glyph(0)
         , m_last_glyph(0)
@@ -206,6 +211,7 @@ public:
         m_mono_storage.clear();
 
         delete m_impl;
+        delete m_coverage;
         delete m_cache;
     }
 
@@ -216,6 +222,7 @@ public:
     uint32_t units_per_em(void) const { return m_impl->units_per_em(); }
 
     const glyph* get_glyph(uint32_t code);
+    void pin_glyph(const glyph* g) { m_cache->pin_glyph(g); }
 
     const char* signature(void) const { return m_cache->signature(); }
     const font_desc& desc(void) const { return m_desc; }
@@ -224,6 +231,12 @@ public:
     void add_kerning(scalar* x, scalar* y);
     graphic_path& path_adaptor(void) { return m_path_adaptor; }
     mono_storage& mono_adaptor(void) { return m_mono_storage; }
+    glyph_coverage_cache& coverage_cache(void) { return *m_coverage; }
+    const glyph_cache_stats& glyph_stats(void) const { return m_cache->stats(); }
+    uint32_t memory_used(void) const
+    {
+        return sizeof(font) + m_cache->memory_used() + sizeof(glyph_coverage_cache) + m_coverage->used_bytes();
+    }
 public:
     void active(void);
     void deactive(void);
@@ -232,6 +245,7 @@ public:
 private:
     font_desc m_desc;
     glyph_cache_manager* m_cache;
+    glyph_coverage_cache* m_coverage;
     font_adapter* m_impl;
     graphic_path m_path_adaptor;
     mono_storage m_mono_storage;
@@ -239,32 +253,64 @@ private:
     const glyph* m_last_glyph;
 };
 
-// font engine
+// cached font of font engine.
+typedef struct _font_entry {
+    font* inst;
+    uint32_t hash;
+    uint32_t bytes; // memory used by the font when it is last deactived.
+    struct _font_entry* hash_next;
+    struct _font_entry* lru_prev;
+    struct _font_entry* lru_next;
+} font_entry;
+
+// font engine, fonts are indexed by signature, the least recently used ones
+// are freed when the byte budget is exceeded. contexts created with a shared
+// context use the same font engine.
 class font_engine : public non_copyable
 {
+    enum {
+        hash_size = 64,
+        hash_mask = hash_size - 1,
+    };
+
 public:
-    font_engine(uint32_t max_fonts = MAX_FONTS);
+    font_engine(uint32_t budget = MAX_FONT_CACHE_BYTES);
     ~font_engine();
 
     void set_antialias(bool b);
     void set_transform(const trans_affine& mtx);
+    void set_cache_budget(uint32_t budget);
 
     bool create_font(const font_desc& desc);
 
     bool stamp_change(void) const { return m_stamp_change; }
     bool antialias(void) const { return m_antialias; }
-    font* current_font(void) const { return m_current; }
+    font* current_font(void) const { return m_current ? m_current->inst : 0; }
+
+    uint32_t num_fonts(void) const { return m_num_fonts; }
+    uint32_t used_bytes(void) const;
+    uint32_t cache_budget(void) const { return m_budget; }
+    void glyph_stats(glyph_cache_stats* stats) const;
 
     static bool initialize(void);
     static void shutdown(void);
 private:
-    int32_t find_font(const char* font_signature);
-    void relayout_fonts(void);
-
-    font** m_fonts;
-    font* m_current;
-    uint32_t m_max_fonts;
+    static uint32_t hash(const char* font_signature);
+    font_entry* find_font(const char* font_signature, uint32_t hash);
+    void update_bytes(font_entry* e);
+    void trim_fonts(void);
+    void link_front(font_entry* e);
+    void unlink(font_entry* e);
+    void remove(font_entry* e);
+
+    font_entry* m_buckets[hash_size];
+    font_entry* m_head;
+    font_entry* m_tail;
+    font_entry* m_current;
+    uint32_t m_budget;
+    uint32_t m_used;
     uint32_t m_num_fonts;
+    glyph_cache_stats m_freed_stats; // glyph statistics of freed fonts.
     char* m_signature;
     trans_affine m_affine;
     bool m_stamp_change;
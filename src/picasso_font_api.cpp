@@ -87,6 +87,16 @@ static inline void _add_glyph_to_path(ps_context* ctx, picasso::graphic_path& pa
     }
 }
 
+static inline bool create_record_font(ps_context* ctx)
+{
+    // recording context keeps glyphs outline, mono glyphs can not be recorded.
+    ps_bool text_antialias = ctx->font_antialias;
+    ctx->font_antialias = True;
+    bool ret = create_device_font(ctx);
+    ctx->font_antialias = text_antialias;
+    return ret;
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -163,7 +173,7 @@ ps_font* PICAPI ps_font_ref(ps_font* f)
         return NULL;
     }
 
-    f->refcount++;
+    picasso::atomic_inc(&f->refcount);
     global_status = STATUS_SUCCEED;
     return f;
 }
@@ -180,8 +190,7 @@ void PICAPI ps_font_unref(ps_font* f)
         return;
     }
 
-    f->refcount--;
-    if (f->refcount <= 0) {
+    if (picasso::atomic_dec(&f->refcount) <= 0) {
         (&f->desc)->font_desc::~font_desc();
         mem_free(f);
     }
@@ -305,8 +314,9 @@ void PICAPI ps_text_out_length(ps_context* ctx, float x, float y, const char* te
 
     scalar gx = FLT_TO_SCALAR(x);
     scalar gy = FLT_TO_SCALAR(y);
+    picasso::graphic_path text_path;
 
-    if (create_device_font(ctx)) {
+    if (ctx->record ? create_record_font(ctx) : create_device_font(ctx)) {
         gy += ctx->fonts->current_font()->ascent() + ctx->fonts->current_font()->leading();
 
         const char* p = text;
@@ -318,7 +328,14 @@ void PICAPI ps_text_out_length(ps_context* ctx, float x, float y, const char* te
                     ctx->fonts->current_font()->add_kerning(&gx, &gy);
                 }
                 if (ctx->fonts->current_font()->generate_raster(glyph, gx, gy)) {
-                    ctx->canvas->p->render_glyph(ctx->state, ctx->raster, ctx->fonts->current_font(), glyph->type);
+                    if (ctx->record) {
+                        if (glyph->type != picasso::glyph_type_mono) {
+                            _add_glyph_to_path(ctx, text_path);
+                        }
+                    } else {
+                        ctx->canvas->p->render_glyph(ctx->state, ctx->raster, ctx->fonts->current_font(),
+                                                     glyph, gx, gy, ctx->font_render_type);
+                    }
                 }
 
                 gx += glyph->advance_x;
@@ -327,7 +344,11 @@ void PICAPI ps_text_out_length(ps_context* ctx, float x, float y, const char* te
             len--;
             p++;
         }
-        ctx->canvas->p->render_glyphs_raster(ctx->state, ctx->raster, ctx->font_render_type);
+        if (ctx->record) {
+            ctx->record->pic.record(picasso::picture_op_text, ctx->state, text_path, ctx->font_render_type);
+        } else {
+            ctx->canvas->p->render_glyphs_raster(ctx->state, ctx->raster, ctx->font_render_type);
+        }
     }
     global_status = STATUS_SUCCEED;
 }
@@ -346,8 +367,9 @@ void PICAPI ps_wide_text_out_length(ps_context* ctx, float x, float y, const ps_
 
     scalar gx = FLT_TO_SCALAR(x);
     scalar gy = FLT_TO_SCALAR(y);
+    picasso::graphic_path text_path;
 
-    if (create_device_font(ctx)) {
+    if (ctx->record ? create_record_font(ctx) : create_device_font(ctx)) {
         gy += ctx->fonts->current_font()->ascent();
 
         const ps_uchar16* p = text;
@@ -359,7 +381,14 @@ void PICAPI ps_wide_text_out_length(ps_context* ctx, float x, float y, const ps_
                     ctx->fonts->current_font()->add_kerning(&gx, &gy);
                 }
                 if (ctx->fonts->current_font()->generate_raster(glyph, gx, gy)) {
-                    ctx->canvas->p->render_glyph(ctx->state, ctx->raster, ctx->fonts->current_font(), glyph->type);
+                    if (ctx->record) {
+                        if (glyph->type != picasso::glyph_type_mono) {
+                            _add_glyph_to_path(ctx, text_path);
+                        }
+                    } else {
+                        ctx->canvas->p->render_glyph(ctx->state, ctx->raster, ctx->fonts->current_font(),
+                                                     glyph, gx, gy, ctx->font_render_type);
+                    }
                 }
 
                 gx += glyph->advance_x;
@@ -368,7 +397,11 @@ void PICAPI ps_wide_text_out_length(ps_context* ctx, float x, float y, const ps_
             len--;
             p++;
         }
-        ctx->canvas->p->render_glyphs_raster(ctx->state, ctx->raster, ctx->font_render_type);
+        if (ctx->record) {
+            ctx->record->pic.record(picasso::picture_op_text, ctx->state, text_path, ctx->font_render_type);
+        } else {
+            ctx->canvas->p->render_glyphs_raster(ctx->state, ctx->raster, ctx->font_render_type);
+        }
     }
     global_status = STATUS_SUCCEED;
 }
@@ -497,22 +530,32 @@ void PICAPI ps_draw_text(ps_context* ctx, const ps_rect* area, const void* text,
     ctx->state->brush.color = ctx->state->font_fcolor;
     ctx->state->pen.color = ctx->state->font_scolor;
 
-    switch (type) {
-        case DRAW_TEXT_FILL:
-            ctx->canvas->p->render_shadow(ctx->state, text_path, true, false);
-            ctx->canvas->p->render_fill(ctx->state, ctx->raster, text_path);
-            ctx->canvas->p->render_blur(ctx->state);
-            break;
-        case DRAW_TEXT_STROKE:
-            ctx->canvas->p->render_shadow(ctx->state, text_path, false, true);
-            ctx->canvas->p->render_stroke(ctx->state, ctx->raster, text_path);
-            ctx->canvas->p->render_blur(ctx->state);
-            break;
-        case DRAW_TEXT_BOTH:
-            ctx->canvas->p->render_shadow(ctx->state, text_path, true, true);
-            ctx->canvas->p->render_paint(ctx->state, ctx->raster, text_path);
-            ctx->canvas->p->render_blur(ctx->state);
-            break;
+    if (ctx->record) {
+        if (type == DRAW_TEXT_FILL) {
+            ctx->record->pic.record(picasso::picture_op_fill, ctx->state, text_path);
+        } else if (type == DRAW_TEXT_STROKE) {
+            ctx->record->pic.record(picasso::picture_op_stroke, ctx->state, text_path);
+        } else if (type == DRAW_TEXT_BOTH) {
+            ctx->record->pic.record(picasso::picture_op_paint, ctx->state, text_path);
+        }
+    } else {
+        switch (type) {
+            case DRAW_TEXT_FILL:
+                ctx->canvas->p->render_shadow(ctx->state, text_path, true, false);
+                ctx->canvas->p->render_fill(ctx->state, ctx->raster, text_path);
+                ctx->canvas->p->render_blur(ctx->state);
+                break;
+            case DRAW_TEXT_STROKE:
+                ctx->canvas->p->render_shadow(ctx->state, text_path, false, true);
+                ctx->canvas->p->render_stroke(ctx->state, ctx->raster, text_path);
+                ctx->canvas->p->render_blur(ctx->state);
+                break;
+            case DRAW_TEXT_BOTH:
+                ctx->canvas->p->render_shadow(ctx->state, text_path, true, true);
+                ctx->canvas->p->render_paint(ctx->state, ctx->raster, text_path);
+                ctx->canvas->p->render_blur(ctx->state);
+                break;
+        }
     }
 
     ctx->state->brush.color = bc;
@@ -583,8 +626,9 @@ void PICAPI ps_show_glyphs(ps_context* ctx, float x, float y, ps_glyph* g, uint3
 
     scalar gx = FLT_TO_SCALAR(x);
     scalar gy = FLT_TO_SCALAR(y);
+    picasso::graphic_path text_path;
 
-    if (create_device_font(ctx)) {
+    if (ctx->record ? create_record_font(ctx) : create_device_font(ctx)) {
         gy += ctx->fonts->current_font()->ascent();
         for (uint32_t i = 0; i < len; i++) {
             const picasso::glyph* glyph = (const picasso::glyph*)g[i].glyph;
@@ -593,14 +637,25 @@ void PICAPI ps_show_glyphs(ps_context* ctx, float x, float y, ps_glyph* g, uint3
                     ctx->fonts->current_font()->add_kerning(&gx, &gy);
                 }
                 if (ctx->fonts->current_font()->generate_raster(glyph, gx, gy)) {
-                    ctx->canvas->p->render_glyph(ctx->state, ctx->raster, ctx->fonts->current_font(), glyph->type);
+                    if (ctx->record) {
+                        if (glyph->type != picasso::glyph_type_mono) {
+                            _add_glyph_to_path(ctx, text_path);
+                        }
+                    } else {
+                        ctx->canvas->p->render_glyph(ctx->state, ctx->raster, ctx->fonts->current_font(),
+                                                     glyph, gx, gy, ctx->font_render_type);
+                    }
                 }
 
                 gx += glyph->advance_x;
                 gy += glyph->advance_y;
             }
         }
-        ctx->canvas->p->render_glyphs_raster(ctx->state, ctx->raster, ctx->font_render_type);
+        if (ctx->record) {
+            ctx->record->pic.record(picasso::picture_op_text, ctx->state, text_path, ctx->font_render_type);
+        } else {
+            ctx->canvas->p->render_glyphs_raster(ctx->state, ctx->raster, ctx->font_render_type);
+        }
     }
     global_status = STATUS_SUCCEED;
 }
@@ -663,8 +718,10 @@ ps_bool PICAPI ps_get_glyph(ps_context* ctx, int32_t ch, ps_glyph* g)
             char c = (char)ch;
             g->glyph = (void*)ctx->fonts->current_font()->get_glyph(c);
         } else {
-            ps_uchar16 c = (ps_uchar16)ch;
-            g->glyph = (void*)ctx->fonts->current_font()->get_glyph(c);
+            g->glyph = (void*)ctx->fonts->current_font()->get_glyph((uint32_t)ch);
+        }
+        if (g->glyph) { // glyph is used by ps_show_glyphs later.
+            ctx->fonts->current_font()->pin_glyph((const picasso::glyph*)g->glyph);
         }
         global_status = STATUS_SUCCEED;
         return True;
@@ -741,6 +798,47 @@ ps_font* PICAPI ps_set_font(ps_context* ctx, const ps_font* f)
     return old;
 }
 
+void PICAPI ps_set_font_cache_size(ps_context* ctx, uint32_t size)
+{
+    if (!picasso::is_valid_system_device()) {
+        global_status = STATUS_DEVICE_ERROR;
+        return;
+    }
+
+    if (!ctx) {
+        global_status = STATUS_INVALID_ARGUMENT;
+        return;
+    }
+
+    ctx->fonts->set_cache_budget(size);
+    global_status = STATUS_SUCCEED;
+}
+
+ps_bool PICAPI ps_get_font_cache_info(ps_context* ctx, ps_font_cache_info* info)
+{
+    if (!picasso::is_valid_system_device()) {
+        global_status = STATUS_DEVICE_ERROR;
+        return False;
+    }
+
+    if (!ctx || !info) {
+        global_status = STATUS_INVALID_ARGUMENT;
+        return False;
+    }
+
+    picasso::glyph_cache_stats stats;
+    ctx->fonts->glyph_stats(&stats);
+
+    info->fonts = ctx->fonts->num_fonts();
+    info->used_size = ctx->fonts->used_bytes();
+    info->cache_size = ctx->fonts->cache_budget();
+    info->glyph_hits = stats.hits;
+    info->glyph_misses = stats.misses;
+    info->glyph_evictions = stats.evictions;
+    global_status = STATUS_SUCCEED;
+    return True;
+}
+
 void PICAPI ps_set_text_render_type(ps_context* ctx, ps_text_type type)
 {
     if (!picasso::is_valid_system_device()) {
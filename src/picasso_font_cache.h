@@ -35,29 +35,175 @@
 
 namespace picasso {
 
+// page of glyphs, glyph data follows the header.
+typedef struct _glyph_page {
+    uint32_t size;
+    uint32_t used;
+    uint32_t glyphs;
+    uint32_t pinned;
+    struct _glyph_page* lru_prev;
+    struct _glyph_page* lru_next;
+} glyph_page;
+
+// glyph cache statistics.
+typedef struct _glyph_cache_stats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+} glyph_cache_stats;
+
+// open addressed glyph table with linear probing.
+class glyph_table : public non_copyable
+{
+public:
+    typedef struct {
+        uint32_t key;
+        glyph_page* page;
+        glyph* data;
+    } slot_type;
+
+    glyph_table()
+        : m_slots(0)
+        , m_capacity(0)
+        , m_count(0)
+    {
+    }
+
+    ~glyph_table()
+    {
+        if (m_slots) {
+            mem_free(m_slots);
+        }
+    }
+
+    slot_type* find(uint32_t key) const
+    {
+        if (!m_count) {
+            return 0;
+        }
+
+        uint32_t mask = m_capacity - 1;
+        uint32_t i = hash(key) & mask;
+        while (m_slots[i].data) {
+            if (m_slots[i].key == key) {
+                return &m_slots[i];
+            }
+            i = (i + 1) & mask;
+        }
+        return 0;
+    }
+
+    bool insert(uint32_t key, glyph_page* page, glyph* data)
+    {
+        if ((m_count + 1) * 4 > m_capacity * 3) { // load factor 3/4
+            if (!rehash(m_capacity ? m_capacity << 1 : 64, 0)) {
+                return false;
+            }
+        }
+
+        put(m_slots, m_capacity, key, page, data);
+        m_count++;
+        return true;
+    }
+
+    // remove all glyphs of the page.
+    bool remove_page(const glyph_page* page)
+    {
+        return rehash(m_capacity, page);
+    }
+
+    uint32_t memory_used(void) const { return m_capacity * sizeof(slot_type); }
+
+private:
+    static uint32_t hash(uint32_t key)
+    {
+        key *= 0x9E3779B1;
+        return key ^ (key >> 16);
+    }
+
+    static void put(slot_type* slots, uint32_t capacity, uint32_t key, glyph_page* page, glyph* data)
+    {
+        uint32_t mask = capacity - 1;
+        uint32_t i = hash(key) & mask;
+        while (slots[i].data) {
+            i = (i + 1) & mask;
+        }
+
+        slots[i].key = key;
+        slots[i].page = page;
+        slots[i].data = data;
+    }
+
+    bool rehash(uint32_t capacity, const glyph_page* skip)
+    {
+        slot_type* slots = (slot_type*)mem_calloc(capacity, sizeof(slot_type));
+        if (!slots) {
+            return false;
+        }
+
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < m_capacity; i++) {
+            if (m_slots[i].data && (m_slots[i].page != skip)) {
+                put(slots, capacity, m_slots[i].key, m_slots[i].page, m_slots[i].data);
+                count++;
+            }
+        }
+
+        if (m_slots) {
+            mem_free(m_slots);
+        }
+
+        m_slots = slots;
+        m_capacity = capacity;
+        m_count = count;
+        return true;
+    }
+
+    slot_type* m_slots;
+    uint32_t m_capacity;
+    uint32_t m_count;
+};
+
+// glyphs of a font indexed by character code and glyph index, glyphs are stored
+// in pages, the least recently used pages are freed when the byte budget is exceeded.
+// pinned pages are moved out of the LRU list and kept until the cache is freed.
 class glyph_cache_manager : public non_copyable
 {
     enum {
-        block_size = 16384 - 16
+        page_size = 16384 - 64
     };
 
 public:
-    glyph_cache_manager()
-        : m_allocator(block_size)
+    glyph_cache_manager(uint32_t budget)
+        : m_budget(budget)
+        , m_used(sizeof(glyph_cache_manager))
+        , m_head(0)
+        , m_tail(0)
+        , m_pinned(0)
         , m_signature(0)
     {
-        memset(m_glyphs, 0, sizeof(m_glyphs));
+        m_recent[0] = m_recent[1] = 0;
+        memset(&m_stats, 0, sizeof(m_stats));
     }
 
     ~glyph_cache_manager()
     {
-        // block_allocator will free all memory.
+        free_pages(m_head);
+        free_pages(m_pinned);
+
+        if (m_signature) {
+            mem_free(m_signature);
+        }
     }
 
     void set_signature(const char* font_signature)
     {
-        m_signature = (char*)m_allocator.allocate((uint32_t)strlen(font_signature) + 1, 4);
-        strcpy(m_signature, font_signature);
+        size_t len = strlen(font_signature) + 1;
+        m_signature = (char*)mem_malloc(len);
+        if (m_signature) {
+            mem_copy(m_signature, font_signature, len);
+            m_used += (uint32_t)len;
+        }
     }
 
     const char* signature(void) const
@@ -65,48 +211,362 @@ public:
         return m_signature;
     }
 
-    const glyph* find_glyph(uint32_t code) const
+    uint32_t memory_used(void) const
+    {
+        return m_used + m_codes.memory_used() + m_indexes.memory_used();
+    }
+
+    const glyph_cache_stats& stats(void) const { return m_stats; }
+
+    const glyph* find_glyph(uint32_t code)
     {
-        uint32_t msb = (code >> 8) & 0xFF;
-        if (m_glyphs[msb]) { // find row
-            return m_glyphs[msb][code & 0xFF];
+        glyph_table::slot_type* s = m_codes.find(code);
+        if (s) {
+            m_stats.hits++;
+            touch(s->page);
+            return s->data;
         }
+        m_stats.misses++;
         return 0;
     }
 
-    glyph* cache_glyph(uint32_t code, uint32_t index, uint32_t data_size, glyph_type data_type,
-                       const rect& bounds, scalar height, scalar advance_x, scalar advance_y)
+    // glyph of the same index shared by other codes.
+    const glyph* find_glyph_index(uint32_t code, uint32_t index)
     {
-        uint32_t msb = (code >> 8) & 0xFF;
-        if (m_glyphs[msb] == 0) { // cache row is empty.
-            // alloc cache row.
-            m_glyphs[msb] = (glyph**)m_allocator.allocate(sizeof(glyph*) * 256, sizeof(glyph*));
-            memset(m_glyphs[msb], 0, sizeof(glyph*) * 256);
+        glyph_table::slot_type* s = m_indexes.find(index);
+        if (s && m_codes.insert(code, s->page, s->data)) {
+            touch(s->page);
+            return s->data;
         }
+        return 0;
+    }
 
-        uint32_t lsb = code & 0xFF;
-        if (m_glyphs[msb][lsb]) {
+    glyph* cache_glyph(uint32_t code, uint32_t index, uint32_t data_size, glyph_type data_type,
+                       const rect& bounds, scalar height, scalar advance_x, scalar advance_y)
+    {
+        if (m_codes.find(code)) {
             return 0; // already exists.
         }
 
-        glyph* g = (glyph*)m_allocator.allocate(sizeof(glyph), sizeof(intptr_t));
+        glyph_page* page = 0;
+        byte* ptr = allocate(sizeof(glyph) + data_size, &page);
+        if (!ptr) {
+            return 0;
+        }
 
+        glyph* g = (glyph*)ptr;
         g->code = code;
         g->index = index;
-        g->data = m_allocator.allocate(data_size);
+        g->data = ptr + sizeof(glyph);
         g->data_size = data_size;
         g->type = data_type;
         g->bounds = bounds;
         g->height = height;
         g->advance_x = advance_x;
         g->advance_y = advance_y;
-        return m_glyphs[msb][lsb] = g;
+
+        if (!m_codes.insert(code, page, g)) {
+            return 0; // page memory is reused by next glyph.
+        }
+
+        if (!m_indexes.find(index)) {
+            m_indexes.insert(index, page, g);
+        }
+
+        page->used += align_size(sizeof(glyph) + data_size);
+        page->glyphs++;
+        touch(page);
+        return g;
+    }
+
+    // the page of a glyph given out to the user is never freed as a cold page.
+    void pin_glyph(const glyph* g)
+    {
+        glyph_table::slot_type* s = m_codes.find(g->code);
+        if (s && !s->page->pinned) {
+            glyph_page* p = s->page;
+            unlink(p);
+            p->pinned = 1;
+            p->lru_prev = 0;
+            p->lru_next = m_pinned;
+            m_pinned = p;
+        }
     }
 
 private:
-    block_allocator m_allocator;
-    glyph** m_glyphs[256];
+    static void free_pages(glyph_page* p)
+    {
+        while (p) {
+            glyph_page* next = p->lru_next;
+            mem_free(p);
+            p = next;
+        }
+    }
+
+    static uint32_t align_size(uint32_t size)
+    {
+        return (size + sizeof(intptr_t) - 1) & ~(uint32_t)(sizeof(intptr_t) - 1);
+    }
+
+    static byte* page_data(glyph_page* p)
+    {
+        return (byte*)p + align_size(sizeof(glyph_page));
+    }
+
+    byte* allocate(uint32_t size, glyph_page** page)
+    {
+        size = align_size(size);
+
+        // new glyph is always in the most recently used page.
+        if (m_head && (m_head->size - m_head->used >= size)) {
+            *page = m_head;
+            return page_data(m_head) + m_head->used;
+        }
+
+        uint32_t psize = Max(size, (uint32_t)page_size);
+        uint32_t bytes = align_size(sizeof(glyph_page)) + psize;
+        while (m_tail && (m_used + bytes > m_budget) && evict(m_tail)) {
+            ;
+        }
+
+        glyph_page* p = (glyph_page*)mem_malloc(bytes);
+        if (!p) {
+            return 0;
+        }
+
+        p->size = psize;
+        p->used = 0;
+        p->glyphs = 0;
+        p->pinned = 0;
+        link_front(p);
+        m_used += bytes;
+
+        *page = p;
+        return page_data(p);
+    }
+
+    bool evict(glyph_page* p)
+    {
+        // the pages of glyphs being used are kept.
+        if ((p == m_recent[0]) || (p == m_recent[1])) {
+            return false;
+        }
+
+        if (!m_codes.remove_page(p) || !m_indexes.remove_page(p)) {
+            return false;
+        }
+
+        unlink(p);
+        m_used -= align_size(sizeof(glyph_page)) + p->size;
+        m_stats.evictions += p->glyphs;
+        mem_free(p);
+        return true;
+    }
+
+    void touch(glyph_page* p)
+    {
+        if (p != m_recent[0]) {
+            m_recent[1] = m_recent[0];
+            m_recent[0] = p;
+        }
+
+        if (!p->pinned && (p != m_head)) {
+            unlink(p);
+            link_front(p);
+        }
+    }
+
+    void link_front(glyph_page* p)
+    {
+        p->lru_prev = 0;
+        p->lru_next = m_head;
+        if (m_head) {
+            m_head->lru_prev = p;
+        } else {
+            m_tail = p;
+        }
+        m_head = p;
+    }
+
+    void unlink(glyph_page* p)
+    {
+        if (p->lru_prev) {
+            p->lru_prev->lru_next = p->lru_next;
+        } else {
+            m_head = p->lru_next;
+        }
+
+        if (p->lru_next) {
+            p->lru_next->lru_prev = p->lru_prev;
+        } else {
+            m_tail = p->lru_prev;
+        }
+    }
+
+    uint32_t m_budget;
+    uint32_t m_used;
+    glyph_table m_codes;
+    glyph_table m_indexes;
+    glyph_page* m_head;
+    glyph_page* m_tail;
+    glyph_page* m_pinned;
+    glyph_page* m_recent[2];
     char* m_signature;
+    glyph_cache_stats m_stats;
+};
+
+// coverage cells of an outline glyph rasterized at a subpixel offset.
+typedef struct _glyph_coverage {
+    uint32_t code;
+    scalar x; // offset in pixel
+    scalar y;
+    byte* data; // serialized cells
+    uint32_t size;
+    struct _glyph_coverage* hash_next;
+    struct _glyph_coverage* lru_prev;
+    struct _glyph_coverage* lru_next;
+} glyph_coverage;
+
+// glyph coverages, the least recently used ones are freed when the byte budget is exceeded.
+class glyph_coverage_cache : public non_copyable
+{
+    enum {
+        hash_size = 256,
+        hash_mask = hash_size - 1,
+    };
+
+public:
+    glyph_coverage_cache(uint32_t budget)
+        : m_budget(budget)
+        , m_used(0)
+        , m_head(0)
+        , m_tail(0)
+    {
+        memset(m_buckets, 0, sizeof(m_buckets));
+    }
+
+    ~glyph_coverage_cache()
+    {
+        clear();
+    }
+
+    void clear(void)
+    {
+        glyph_coverage* c = m_head;
+        while (c) {
+            glyph_coverage* next = c->lru_next;
+            mem_free(c);
+            c = next;
+        }
+
+        memset(m_buckets, 0, sizeof(m_buckets));
+        m_head = m_tail = 0;
+        m_used = 0;
+    }
+
+    const glyph_coverage* find_coverage(uint32_t code, scalar x, scalar y)
+    {
+        glyph_coverage* c = m_buckets[hash(code, x, y)];
+        while (c) {
+            if ((c->code == code) && (c->x == x) && (c->y == y)) {
+                // most recently used
+                if (c != m_head) {
+                    unlink(c);
+                    link_front(c);
+                }
+                return c;
+            }
+            c = c->hash_next;
+        }
+        return 0;
+    }
+
+    glyph_coverage* cache_coverage(uint32_t code, scalar x, scalar y, uint32_t size)
+    {
+        uint32_t bytes = sizeof(glyph_coverage) + size;
+        if (bytes > m_budget) {
+            return 0; // never fits.
+        }
+
+        while (m_tail && (m_used + bytes > m_budget)) {
+            remove(m_tail);
+        }
+
+        glyph_coverage* c = (glyph_coverage*)mem_malloc(bytes);
+        if (!c) {
+            return 0;
+        }
+
+        c->code = code;
+        c->x = x;
+        c->y = y;
+        c->data = (byte*)(c + 1);
+        c->size = size;
+
+        uint32_t idx = hash(code, x, y);
+        c->hash_next = m_buckets[idx];
+        m_buckets[idx] = c;
+        link_front(c);
+
+        m_used += bytes;
+        return c;
+    }
+
+    uint32_t used_bytes(void) const { return m_used; }
+    uint32_t budget(void) const { return m_budget; }
+
+private:
+    static uint32_t hash(uint32_t code, scalar x, scalar y)
+    {
+        uint32_t phase = (uint32_t)iround(x * 256) | ((uint32_t)iround(y * 256) << 16);
+        return (code ^ (phase * 0x9E3779B1) ^ (phase >> 13)) & hash_mask;
+    }
+
+    void link_front(glyph_coverage* c)
+    {
+        c->lru_prev = 0;
+        c->lru_next = m_head;
+        if (m_head) {
+            m_head->lru_prev = c;
+        } else {
+            m_tail = c;
+        }
+        m_head = c;
+    }
+
+    void unlink(glyph_coverage* c)
+    {
+        if (c->lru_prev) {
+            c->lru_prev->lru_next = c->lru_next;
+        } else {
+            m_head = c->lru_next;
+        }
+
+        if (c->lru_next) {
+            c->lru_next->lru_prev = c->lru_prev;
+        } else {
+            m_tail = c->lru_prev;
+        }
+    }
+
+    void remove(glyph_coverage* c)
+    {
+        glyph_coverage** p = &m_buckets[hash(c->code, c->x, c->y)];
+        while (*p != c) {
+            p = &((*p)->hash_next);
+        }
+        *p = c->hash_next;
+
+        unlink(c);
+        m_used -= sizeof(glyph_coverage) + c->size;
+        mem_free(c);
+    }
+
+    uint32_t m_budget;
+    uint32_t m_used;
+    glyph_coverage* m_buckets[hash_size];
+    glyph_coverage* m_head;
+    glyph_coverage* m_tail;
 };
 
 }
@@ -159,7 +159,7 @@ ps_gradient* PICAPI ps_gradient_ref(ps_gradient* g)
         return 0;
     }
 
-    g->refcount++;
+    picasso::atomic_inc(&g->refcount);
     global_status = STATUS_SUCCEED;
     return g;
 }
@@ -176,8 +176,7 @@ void PICAPI ps_gradient_unref(ps_gradient* g)
         return;
     }
 
-    g->refcount--;
-    if (g->refcount <= 0) {
+    if (picasso::atomic_dec(&g->refcount) <= 0) {
         (&g->gradient)->picasso::gradient_adapter::~gradient_adapter();
         mem_free(g);
     }
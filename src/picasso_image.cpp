@@ -294,7 +294,7 @@ ps_image* PICAPI ps_image_ref(ps_image* img)
         return NULL;
     }
 
-    img->refcount++;
+    picasso::atomic_inc(&img->refcount);
     global_status = STATUS_SUCCEED;
     return img;
 }
@@ -311,8 +311,7 @@ void PICAPI ps_image_unref(ps_image* img)
         return;
     }
 
-    img->refcount--;
-    if (img->refcount <= 0) {
+    if (picasso::atomic_dec(&img->refcount) <= 0) {
         if (img->flage == buffer_alloc_surface) {
             BufferFree(img->buffer.buffer());
         } else if (img->flage == buffer_alloc_malloc) {
@@ -91,7 +91,7 @@ ps_mask* PICAPI ps_mask_ref(ps_mask* mask)
         return NULL;
     }
 
-    mask->refcount++;
+    picasso::atomic_inc(&mask->refcount);
     global_status = STATUS_SUCCEED;
     return mask;
 }
@@ -108,8 +108,7 @@ void PICAPI ps_mask_unref(ps_mask* mask)
         return;
     }
 
-    mask->refcount--;
-    if (mask->refcount <= 0) {
+    if (picasso::atomic_dec(&mask->refcount) <= 0) {
         if (mask->flage == buffer_alloc_surface) {
             BufferFree(mask->mask.buffer());
         } else if (mask->flage == buffer_alloc_malloc) {
@@ -166,7 +166,7 @@ ps_matrix* PICAPI ps_matrix_ref(ps_matrix* matrix)
         global_status = STATUS_INVALID_ARGUMENT;
         return NULL;
     }
-    matrix->refcount++;
+    picasso::atomic_inc(&matrix->refcount);
     global_status = STATUS_SUCCEED;
     return matrix;
 }
@@ -183,8 +183,7 @@ void PICAPI ps_matrix_unref(ps_matrix* matrix)
         return;
     }
 
-    matrix->refcount--;
-    if (matrix->refcount <= 0) {
+    if (picasso::atomic_dec(&matrix->refcount) <= 0) {
         (&matrix->matrix)->trans_affine::~trans_affine();
         mem_free(matrix);
     }
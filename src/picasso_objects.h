@@ -17,6 +17,8 @@
 #include "picasso_font.h"
 #include "picasso_gradient.h"
 #include "picasso_painter.h"
+#include "picasso_picture.h"
+#include "picasso_prepared_path.h"
 #include "picasso_private.h"
 #include "picasso_rendering_buffer.h"
 #include "picasso_raster_adapter.h"
@@ -588,6 +590,7 @@ struct _ps_context {
     picasso::trans_affine text_matrix;
     picasso::graphic_path path;
     picasso::raster_adapter raster;
+    ps_picture* record; // picture of recording context
 };
 
 enum {
@@ -651,6 +654,16 @@ struct _ps_font {
     picasso::font_desc desc;
 };
 
+struct _ps_picture {
+    int32_t refcount;
+    picasso::picture pic;
+};
+
+struct _ps_prepared_path {
+    int32_t refcount;
+    picasso::prepared_path prepared;
+};
+
 #ifdef __cplusplus
 }
 #endif
@@ -67,27 +67,24 @@ void painter::init_source_data(context_state* state, uint32_t methods, const gra
     if (methods & raster_stroke) {
         switch (state->pen.style) {
             case pen_style_canvas: {
-                    scalar x1 = 1, y1 = 1, x2 = 0, y2 = 0;
-                    bounding_rect(const_cast<graphic_path&>(p), 0, &x1, &y1, &x2, &y2);
+                    rect_s rect;
+                    p.bounds(&rect);
                     ps_canvas* canvas = static_cast<ps_canvas*>(state->pen.data);
-                    rect_s rect(x1, y1, x2, y2);
                     m_impl->set_stroke_canvas(canvas->buffer.impl(), (pix_fmt)(canvas->fmt), (int32_t)state->filter, rect);
                 }
                 break;
             case pen_style_pattern: {
-                    scalar x1 = 1, y1 = 1, x2 = 0, y2 = 0;
-                    bounding_rect(const_cast<graphic_path&>(p), 0, &x1, &y1, &x2, &y2);
+                    rect_s rect;
+                    p.bounds(&rect);
                     ps_pattern* pattern = static_cast<ps_pattern*>(state->pen.data);
-                    rect_s rect(x1, y1, x2, y2);
                     m_impl->set_stroke_pattern(pattern->img->buffer.impl(), (pix_fmt)(pattern->img->fmt), (int32_t)state->filter, rect,
                                                pattern->xtype, pattern->ytype, &(pattern->matrix));
                 }
                 break;
             case pen_style_image: {
-                    scalar x1 = 1, y1 = 1, x2 = 0, y2 = 0;
-                    bounding_rect(const_cast<graphic_path&>(p), 0, &x1, &y1, &x2, &y2);
+                    rect_s rect;
+                    p.bounds(&rect);
                     ps_image* img = static_cast<ps_image*>(state->pen.data);
-                    rect_s rect(x1, y1, x2, y2);
                     m_impl->set_stroke_image(img->buffer.impl(), (pix_fmt)(img->fmt), (int32_t)state->filter, rect);
                 }
                 break;
@@ -108,27 +105,24 @@ void painter::init_source_data(context_state* state, uint32_t methods, const gra
     if (methods & raster_fill) {
         switch (state->brush.style) {
             case brush_style_canvas: {
-                    scalar x1 = 1, y1 = 1, x2 = 0, y2 = 0;
-                    bounding_rect(const_cast<graphic_path&>(p), 0, &x1, &y1, &x2, &y2);
+                    rect_s rect;
+                    p.bounds(&rect);
                     ps_canvas* canvas = static_cast<ps_canvas*>(state->brush.data);
-                    rect_s rect(x1, y1, x2, y2);
                     m_impl->set_fill_canvas(canvas->buffer.impl(), (pix_fmt)(canvas->fmt), (int32_t)state->filter, rect);
                 }
                 break;
             case brush_style_pattern: {
-                    scalar x1 = 1, y1 = 1, x2 = 0, y2 = 0;
-                    bounding_rect(const_cast<graphic_path&>(p), 0, &x1, &y1, &x2, &y2);
+                    rect_s rect;
+                    p.bounds(&rect);
                     ps_pattern* pattern = static_cast<ps_pattern*>(state->brush.data);
-                    rect_s rect(x1, y1, x2, y2);
                     m_impl->set_fill_pattern(pattern->img->buffer.impl(), (pix_fmt)(pattern->img->fmt), (int32_t)state->filter, rect,
                                              pattern->xtype, pattern->ytype, &(pattern->matrix));
                 }
                 break;
             case brush_style_image: {
-                    scalar x1 = 1, y1 = 1, x2 = 0, y2 = 0;
-                    bounding_rect(const_cast<graphic_path&>(p), 0, &x1, &y1, &x2, &y2);
+                    rect_s rect;
+                    p.bounds(&rect);
                     ps_image* img = static_cast<ps_image*>(state->brush.data);
-                    rect_s rect(x1, y1, x2, y2);
                     m_impl->set_fill_image(img->buffer.impl(), (pix_fmt)(img->fmt), (int32_t)state->filter, rect);
                 }
                 break;
@@ -147,34 +141,87 @@ void painter::init_source_data(context_state* state, uint32_t methods, const gra
     }
 }
 
+// device space bounds of drawing the path, return false if the path is empty.
+static bool _draw_bounds(context_state* state, uint32_t methods, const graphic_path& p, rect_s* rc)
+{
+    rect_s b;
+    if (!p.bounds(&b)) {
+        return false;
+    }
+
+    if (methods & raster_stroke) {
+        // square caps reach sqrt(2) of half width, miter joins reach miter limit of it.
+        scalar w = Fabs(state->pen.width) * FLT_TO_SCALAR(0.5f);
+        scalar ext = w * FLT_TO_SCALAR(1.5f);
+        if ((state->pen.join != round_join) && (state->pen.join != bevel_join)) {
+            ext = Max(ext, w * state->pen.miter_limit);
+        }
+        b.x1 -= ext;
+        b.y1 -= ext;
+        b.x2 += ext;
+        b.y2 += ext;
+    }
+
+    scalar xs[4] = { b.x1, b.x2, b.x2, b.x1 };
+    scalar ys[4] = { b.y1, b.y1, b.y2, b.y2 };
+    for (uint32_t i = 0; i < 4; i++) {
+        state->world_matrix.transform(&xs[i], &ys[i]);
+    }
+
+    // two pixels for antialias and pixel alignment of the raster.
+    rc->x1 = Min(Min(xs[0], xs[1]), Min(xs[2], xs[3])) - INT_TO_SCALAR(2);
+    rc->y1 = Min(Min(ys[0], ys[1]), Min(ys[2], ys[3])) - INT_TO_SCALAR(2);
+    rc->x2 = Max(Max(xs[0], xs[1]), Max(xs[2], xs[3])) + INT_TO_SCALAR(2);
+    rc->y2 = Max(Max(ys[0], ys[1]), Max(ys[2], ys[3])) + INT_TO_SCALAR(2);
+    return true;
+}
+
 void painter::render_stroke(context_state* state, raster_adapter& raster, const graphic_path& p)
 {
     if (raster.is_empty()) {
+        rect_s rc;
+        if (!_draw_bounds(state, raster_stroke, p, &rc) || !m_impl->begin_bounds(rc)) {
+            return; // nothing visible.
+        }
         init_raster_data(state, raster_stroke, raster, p, state->world_matrix);
+        raster.set_shape_cache(p.cache());
     }
 
     init_source_data(state, raster_stroke, p);
 
     raster.commit(); //calc raster data.
     m_impl->apply_stroke(raster.impl());
+    m_impl->end_bounds();
 }
 
 void painter::render_fill(context_state* state, raster_adapter& raster, const graphic_path& p)
 {
     if (raster.is_empty()) {
+        rect_s rc;
+        if (!_draw_bounds(state, raster_fill, p, &rc) || !m_impl->begin_bounds(rc)) {
+            return; // nothing visible.
+        }
         init_raster_data(state, raster_fill, raster, p, state->world_matrix);
+        raster.set_fill_attr(FIA_CONVEX, p.get_class() != graphic_path::path_complex);
     }
 
     init_source_data(state, raster_fill, p);
 
     raster.commit(); //calc raster data.
     m_impl->apply_fill(raster.impl());
+    m_impl->end_bounds();
 }
 
 void painter::render_paint(context_state* state, raster_adapter& raster, const graphic_path& p)
 {
     if (raster.is_empty()) {
+        rect_s rc;
+        if (!_draw_bounds(state, raster_fill | raster_stroke, p, &rc) || !m_impl->begin_bounds(rc)) {
+            return; // nothing visible.
+        }
         init_raster_data(state, raster_fill | raster_stroke, raster, p, state->world_matrix);
+        raster.set_fill_attr(FIA_CONVEX, p.get_class() != graphic_path::path_complex);
+        raster.set_shape_cache(p.cache());
     }
 
     init_source_data(state, raster_fill | raster_stroke, p);
@@ -182,6 +229,23 @@ void painter::render_paint(context_state* state, raster_adapter& raster, const g
     raster.commit(); //calc raster data.
     m_impl->apply_fill(raster.impl());
     m_impl->apply_stroke(raster.impl());
+    m_impl->end_bounds();
+}
+
+void painter::render_prepared_fill(context_state* state, prepared_path* p, scalar x, scalar y)
+{
+    // coverage of the subpixel phase is replayed at the pixel offset.
+    int32_t px, py;
+    uint32_t phase = prepared_path::phase_of(x, y, &px, &py);
+    const prepared_coverage* c = p->coverage(phase);
+    if (c && c->size) {
+        init_source_data(state, raster_fill, p->path());
+
+        trans_affine mtx = p->matrix();
+        mtx.translate(INT_TO_SCALAR(px) + prepared_path::phase_x(phase),
+                      INT_TO_SCALAR(py) + prepared_path::phase_y(phase));
+        m_impl->apply_fill_coverage(c->data, c->size, px, py, mtx);
+    }
 }
 
 void painter::render_clear(context_state* state)
@@ -249,11 +313,13 @@ void painter::render_shadow(context_state* state, const graphic_path& p, bool fi
         trans_affine mtx = state->world_matrix;
         mtx.translate(-x1, -y1); // translate to (0,0) of shadow layer.
 
-        if (m_impl->begin_shadow(rect)) { //switch to shadow layer.
+        if (m_impl->begin_shadow(rect, state->shadow.x_offset, state->shadow.y_offset)) { //switch to shadow layer.
 
             raster_adapter shadow_raster;
 
             init_raster_data(state, method, shadow_raster, p, mtx);
+            shadow_raster.set_fill_attr(FIA_CONVEX, p.get_class() != graphic_path::path_complex);
+            shadow_raster.set_shape_cache(p.cache());
 
             m_impl->set_alpha(state->alpha);
             m_impl->set_composite(state->composite);
@@ -297,7 +363,50 @@ void painter::render_copy(rendering_buffer& src, const rect* r, const painter* d
     }
 }
 
-void painter::render_glyph(context_state* state, raster_adapter& raster, const font* ft, int32_t type)
+static inline bool _is_translation(const trans_affine& mtx)
+{
+    return (mtx.sx() == FLT_TO_SCALAR(1.0f)) && (mtx.sy() == FLT_TO_SCALAR(1.0f))
+           && (mtx.shx() == FLT_TO_SCALAR(0.0f)) && (mtx.shy() == FLT_TO_SCALAR(0.0f));
+}
+
+void painter::render_glyph_coverage(context_state* state, raster_adapter& raster, font* ft, const glyph* g, scalar x, scalar y)
+{
+    // glyph outline has been placed at (x, y). the cells are cached for the offset
+    // in pixel of the position and added to the raster at any integer pixel offset,
+    // the glyphs of the text are blended together as the outlines are.
+    scalar fx = Floor(x);
+    scalar fy = Floor(y);
+
+    int32_t dx = iround(fx) + iround(Round(state->world_matrix.tx()));
+    int32_t dy = iround(fy) + iround(Round(state->world_matrix.ty()));
+
+    conv_curve curve(ft->path_adaptor());
+    glyph_coverage_cache& cache = ft->coverage_cache();
+    const glyph_coverage* cov = cache.find_coverage(g->code, x - fx, y - fy);
+    if (!cov) {
+        raster_adapter glyph_raster;
+        trans_affine mtx = trans_affine_translation(-fx, -fy);
+        init_raster_data(state, raster_fill, glyph_raster, curve, mtx);
+
+        glyph_raster.commit(); //calc raster data.
+        uint32_t size = glyph_raster.cells_size();
+        glyph_coverage* c = size ? cache.cache_coverage(g->code, x - fx, y - fy, size) : 0;
+        if (!c) { // no cells to keep, rasterize the outline.
+            init_raster_data(state, raster_fill, raster, curve, state->world_matrix);
+            raster.commit(); //calc raster data.
+            return;
+        }
+
+        glyph_raster.serialize_cells(c->data);
+        cov = c;
+    }
+
+    raster.set_fill_attr(FIA_FILL_RULE, state->brush.rule);
+    raster.add_cells(cov->data, cov->size, dx, dy);
+}
+
+void painter::render_glyph(context_state* state, raster_adapter& raster, const font* ft,
+                           const glyph* g, scalar x, scalar y, int32_t style)
 {
     //FIXME: support other source !
     m_impl->set_alpha(state->alpha);
@@ -305,12 +414,14 @@ void painter::render_glyph(context_state* state, raster_adapter& raster, const f
 
     m_impl->set_font_fill_color(state->font_fcolor);
 
-    if (type == glyph_type_mono) {
+    if (g->type == glyph_type_mono) {
         mono_storage& mono = const_cast<font*>(ft)->mono_adaptor();
         scalar tx = state->world_matrix.tx();
         scalar ty = state->world_matrix.ty();
         mono.translate(tx, ty);
         m_impl->apply_mono_text_fill(mono.get_storage());
+    } else if ((style != text_mono) && _is_translation(state->world_matrix)) {
+        render_glyph_coverage(state, raster, const_cast<font*>(ft), g, x, y);
     } else {
         conv_curve curve(const_cast<font*>(ft)->path_adaptor());
         //FIXME: support stroke feature!
@@ -328,4 +439,19 @@ void painter::render_glyphs_raster(context_state* state, raster_adapter& raster,
     }
 }
 
+void painter::render_text(context_state* state, raster_adapter& raster, const graphic_path& p, int32_t style)
+{
+    // glyphs outline of text.
+    m_impl->set_alpha(state->alpha);
+    m_impl->set_composite(state->composite);
+
+    m_impl->set_font_fill_color(state->font_fcolor);
+
+    init_raster_data(state, raster_fill, raster, p, state->world_matrix);
+
+    raster.commit(); //calc raster data.
+    m_impl->apply_text_fill(raster.impl(), (text_style)style);
+    raster.reset();
+}
+
 }
@@ -24,6 +24,7 @@ class graphic_path;
 class trans_affine;
 class mask_layer;
 class font;
+class prepared_path;
 
 class painter
 {
@@ -41,15 +42,19 @@ public:
     void render_gamma(context_state* state, raster_adapter& raster);
     void render_clip(context_state* state, bool clip);
     void render_shadow(context_state* state, const graphic_path& p, bool fill, bool stroke);
+    void render_prepared_fill(context_state* state, prepared_path* p, scalar x, scalar y);
 
     void render_mask(const mask_layer& m, bool mask);
     void render_copy(rendering_buffer& src, const rect* rect, const painter* dst, int32_t off_x, int32_t off_y);
 
-    void render_glyph(context_state* state, raster_adapter& raster, const font* f, int32_t type);
+    void render_glyph(context_state* state, raster_adapter& raster, const font* f,
+                      const glyph* g, scalar x, scalar y, int32_t style);
     void render_glyphs_raster(context_state* state, raster_adapter& raster, int32_t style);
+    void render_text(context_state* state, raster_adapter& raster, const graphic_path& p, int32_t style);
 private:
     void init_raster_data(context_state*, uint32_t, raster_adapter&, const vertex_source&, const trans_affine&);
     void init_source_data(context_state*, uint32_t, const graphic_path&);
+    void render_glyph_coverage(context_state*, raster_adapter&, font*, const glyph*, scalar, scalar);
 private:
     abstract_painter* m_impl;
 };
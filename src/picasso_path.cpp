@@ -21,12 +21,12 @@ namespace picasso {
 static ps_rect _path_bounding_rect(const graphic_path& path)
 {
     ps_rect r = {1, 1, 0, 0};
-    scalar x1 = 1, y1 = 1, x2 = 0, y2 = 0;
-    if (bounding_rect(const_cast<graphic_path&>(path), 0, &x1, &y1, &x2, &y2)) {
-        r.x = x1;
-        r.y = y1;
-        r.w = x2 - x1;
-        r.h = y2 - y1;
+    rect_s rc;
+    if (path.bounds(&rc)) {
+        r.x = SCALAR_TO_FLT(rc.x1);
+        r.y = SCALAR_TO_FLT(rc.y1);
+        r.w = SCALAR_TO_FLT(rc.x2 - rc.x1);
+        r.h = SCALAR_TO_FLT(rc.y2 - rc.y1);
     }
     return r;
 }
@@ -105,7 +105,7 @@ ps_path* PICAPI ps_path_ref(ps_path* path)
         return NULL;
     }
 
-    path->refcount++;
+    picasso::atomic_inc(&path->refcount);
     global_status = STATUS_SUCCEED;
     return path;
 }
@@ -122,8 +122,7 @@ void PICAPI ps_path_unref(ps_path* path)
         return;
     }
 
-    path->refcount--;
-    if (path->refcount <= 0) {
+    if (picasso::atomic_dec(&path->refcount) <= 0) {
         (&path->path)->picasso::graphic_path::~graphic_path();
         mem_free(path);
     }
@@ -57,7 +57,7 @@ ps_pattern* PICAPI ps_pattern_ref(ps_pattern* pattern)
         return NULL;
     }
 
-    pattern->refcount++;
+    picasso::atomic_inc(&pattern->refcount);
     global_status = STATUS_SUCCEED;
     return pattern;
 }
@@ -74,8 +74,7 @@ void PICAPI ps_pattern_unref(ps_pattern* pattern)
         return;
     }
 
-    pattern->refcount--;
-    if (pattern->refcount <= 0) {
+    if (picasso::atomic_dec(&pattern->refcount) <= 0) {
         ps_image_unref(pattern->img);
         mem_free(pattern);
     }
@@ -0,0 +1,226 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#include "common.h"
+#include "device.h"
+#include "graphic_path.h"
+
+#include "picasso.h"
+#include "picasso_objects.h"
+#include "picasso_painter.h"
+#include "picasso_picture.h"
+
+namespace picasso {
+
+static inline bool _same_color(const rgba& a, const rgba& b)
+{
+    return (a.r == b.r) && (a.g == b.g) && (a.b == b.b) && (a.a == b.a);
+}
+
+static inline bool _same_pen(const graphic_pen& a, const graphic_pen& b)
+{
+    if ((a.style != b.style) || (a.data != b.data) || (a.width != b.width)
+        || (a.miter_limit != b.miter_limit) || (a.cap != b.cap) || (a.join != b.join)
+        || (a.inner != b.inner) || !_same_color(a.color, b.color) || (a.is_dash != b.is_dash)) {
+        return false;
+    }
+
+    if (a.is_dash) {
+        if ((a.ndashes != b.ndashes) || (a.dstart != b.dstart)) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < a.ndashes; i++) {
+            if (a.dashes[i] != b.dashes[i]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static inline bool _same_brush(const graphic_brush& a, const graphic_brush& b)
+{
+    return (a.style == b.style) && (a.data == b.data) && (a.rule == b.rule) && _same_color(a.color, b.color);
+}
+
+static inline bool _same_shadow(const shadow_state& a, const shadow_state& b)
+{
+    return (a.use_shadow == b.use_shadow) && (a.x_offset == b.x_offset) && (a.y_offset == b.y_offset)
+           && (a.blur == b.blur) && _same_color(a.color, b.color);
+}
+
+static bool _same_state(const context_state& a, const context_state& b)
+{
+    return (a.filter == b.filter)
+           && (a.antialias == b.antialias)
+           && (a.gamma == b.gamma)
+           && (a.alpha == b.alpha)
+           && (a.blur == b.blur)
+           && _same_color(a.font_fcolor, b.font_fcolor)
+           && (a.composite == b.composite)
+           && (a.world_matrix == b.world_matrix)
+           && _same_pen(a.pen, b.pen)
+           && _same_brush(a.brush, b.brush)
+           && _same_shadow(a.shadow, b.shadow)
+           && !a.clip.is_not_same(b.clip)
+           && (a.clip.clip_matrix == b.clip.clip_matrix);
+}
+
+picture::picture()
+{
+}
+
+picture::~picture()
+{
+    for (uint32_t i = 0; i < m_states.size(); i++) {
+        delete m_states[i];
+    }
+
+    for (uint32_t i = 0; i < m_paths.size(); i++) {
+        delete m_paths[i];
+    }
+}
+
+uint32_t picture::add_state(const context_state* state)
+{
+    uint32_t count = m_states.size();
+    if (count && _same_state(*m_states[count - 1], *state)) {
+        return count - 1;
+    }
+
+    m_states.add(new context_state(*state));
+    return count;
+}
+
+void picture::record(uint32_t op, const context_state* state)
+{
+    picture_command cmd;
+    cmd.op = op;
+    cmd.state = add_state(state);
+    cmd.path = no_index;
+    cmd.style = 0;
+    m_commands.add(cmd);
+}
+
+void picture::record(uint32_t op, const context_state* state, const graphic_path& path, int32_t style)
+{
+    picture_command cmd;
+    cmd.op = op;
+    cmd.state = add_state(state);
+    cmd.path = m_paths.size();
+    cmd.style = style;
+    graphic_path* p = new graphic_path(path);
+    if (p && (op == picture_op_stroke || op == picture_op_paint)) {
+        p->attach_cache(); // stroked outline reused in every playback.
+    }
+    m_paths.add(p);
+    m_commands.add(cmd);
+}
+
+static void _render_command(ps_context* ctx, const picture_command& cmd, context_state* state, const graphic_path* path)
+{
+    if (ctx->record) { // playback into another picture.
+        if (path) {
+            ctx->record->pic.record(cmd.op, state, *path, cmd.style);
+        } else {
+            ctx->record->pic.record(cmd.op, state);
+        }
+        return;
+    }
+
+    painter* p = ctx->canvas->p;
+    switch (cmd.op) {
+        case picture_op_fill:
+            p->render_shadow(state, *path, true, false);
+            p->render_fill(state, ctx->raster, *path);
+            p->render_blur(state);
+            ctx->raster.reset();
+            break;
+        case picture_op_stroke:
+            p->render_shadow(state, *path, false, true);
+            p->render_stroke(state, ctx->raster, *path);
+            p->render_blur(state);
+            ctx->raster.reset();
+            break;
+        case picture_op_paint:
+            p->render_shadow(state, *path, true, true);
+            p->render_paint(state, ctx->raster, *path);
+            p->render_blur(state);
+            ctx->raster.reset();
+            break;
+        case picture_op_clear:
+            p->render_clear(state);
+            break;
+        case picture_op_text:
+            p->render_text(state, ctx->raster, *path, cmd.style);
+            break;
+        case picture_op_clip:
+            p->render_clip(state, true);
+            break;
+        case picture_op_reset_clip:
+            p->render_clip(state, false);
+            break;
+        default:
+            //make compiler happy only.
+            break;
+    }
+}
+
+void picture::playback(ps_context* ctx, const trans_affine& mtx) const
+{
+    trans_affine base(ctx->state->world_matrix);
+    base *= mtx;
+    bool transform = !base.is_identity();
+
+    context_state scratch;
+    context_state* state = 0;
+    uint32_t current = no_index;
+    bool clip = false;
+
+    for (uint32_t i = 0; i < m_commands.size(); i++) {
+        const picture_command& cmd = m_commands[i];
+
+        if (cmd.state != current) {
+            // states are only copied when the picture is transformed.
+            current = cmd.state;
+            if (transform) {
+                scratch = *m_states[current];
+                scratch.world_matrix = base * m_states[current]->world_matrix;
+                scratch.clip.clip_matrix = base * m_states[current]->clip.clip_matrix;
+                state = &scratch;
+            } else {
+                state = m_states[current];
+            }
+
+            if (!ctx->record) {
+                ctx->canvas->p->render_gamma(state, ctx->raster);
+            }
+        }
+
+        if ((cmd.op == picture_op_clip) || (cmd.op == picture_op_reset_clip)) {
+            clip = true;
+        }
+
+        _render_command(ctx, cmd, state, (cmd.path != no_index) ? m_paths[cmd.path] : 0);
+    }
+
+    // back to the state of context.
+    if (ctx->record) {
+        if (clip) {
+            ctx->record->pic.record(picture_op_reset_clip, ctx->state);
+            ctx->record->pic.record(picture_op_clip, ctx->state);
+        }
+    } else {
+        if (clip) {
+            ctx->canvas->p->render_clip(ctx->state, false);
+            ctx->canvas->p->render_clip(ctx->state, true);
+        }
+        ctx->canvas->p->render_gamma(ctx->state, ctx->raster);
+    }
+}
+
+}
@@ -0,0 +1,68 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#ifndef _PICASSO_PICTURE_H_
+#define _PICASSO_PICTURE_H_
+
+#include "common.h"
+#include "non_copy.h"
+#include "data_vector.h"
+
+#include "picasso.h"
+
+namespace picasso {
+
+class context_state;
+class graphic_path;
+class trans_affine;
+
+// picture commands
+enum {
+    picture_op_fill = 0,
+    picture_op_stroke = 1,
+    picture_op_paint = 2,
+    picture_op_clear = 3,
+    picture_op_text = 4,
+    picture_op_clip = 5,
+    picture_op_reset_clip = 6,
+};
+
+struct picture_command {
+    uint32_t op;
+    uint32_t state; // index of state
+    uint32_t path; // index of path, or no_index
+    int32_t style; // text render type
+};
+
+// display list of painter calls. each command keeps the context state it was
+// issued with, a state is shared by commands until it is changed.
+class picture : public non_copyable
+{
+public:
+    enum {
+        no_index = 0xFFFFFFFF,
+    };
+
+    picture();
+    ~picture();
+
+    void record(uint32_t op, const context_state* state);
+    void record(uint32_t op, const context_state* state, const graphic_path& path, int32_t style = 0);
+
+    // replay commands on context, as they are issued after the context is transformed by mtx.
+    void playback(ps_context* ctx, const trans_affine& mtx) const;
+
+    uint32_t size(void) const { return m_commands.size(); }
+private:
+    uint32_t add_state(const context_state* state);
+    pod_bvector<picture_command> m_commands;
+    pod_bvector<context_state*> m_states;
+    pod_bvector<graphic_path*> m_paths;
+};
+
+}
+
+#endif /*_PICASSO_PICTURE_H_*/
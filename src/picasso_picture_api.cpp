@@ -0,0 +1,143 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#include "common.h"
+#include "device.h"
+
+#include "picasso.h"
+#include "picasso_objects.h"
+#include "picasso_picture.h"
+#include "picasso_private.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+ps_picture* PICAPI ps_picture_create(void)
+{
+    if (!picasso::is_valid_system_device()) {
+        global_status = STATUS_DEVICE_ERROR;
+        return NULL;
+    }
+
+    ps_picture* p = (ps_picture*)mem_malloc(sizeof(ps_picture));
+    if (p) {
+        p->refcount = 1;
+        new ((void*) & (p->pic)) picasso::picture;
+        global_status = STATUS_SUCCEED;
+        return p;
+    } else {
+        global_status = STATUS_OUT_OF_MEMORY;
+        return NULL;
+    }
+}
+
+ps_picture* PICAPI ps_picture_ref(ps_picture* picture)
+{
+    if (!picasso::is_valid_system_device()) {
+        global_status = STATUS_DEVICE_ERROR;
+        return NULL;
+    }
+
+    if (!picture) {
+        global_status = STATUS_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    picasso::atomic_inc(&picture->refcount);
+    global_status = STATUS_SUCCEED;
+    return picture;
+}
+
+void PICAPI ps_picture_unref(ps_picture* picture)
+{
+    if (!picasso::is_valid_system_device()) {
+        global_status = STATUS_DEVICE_ERROR;
+        return;
+    }
+
+    if (!picture) {
+        global_status = STATUS_INVALID_ARGUMENT;
+        return;
+    }
+
+    if (picasso::atomic_dec(&picture->refcount) <= 0) {
+        (&picture->pic)->picasso::picture::~picture();
+        mem_free(picture);
+    }
+    global_status = STATUS_SUCCEED;
+}
+
+ps_context* PICAPI ps_context_create_recording(ps_picture* picture, ps_context* ctx)
+{
+    if (!picasso::is_valid_system_device()) {
+        global_status = STATUS_DEVICE_ERROR;
+        return NULL;
+    }
+
+    if (!picture) {
+        global_status = STATUS_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    picasso::context_state* state = new picasso::context_state;
+    if (!state) {
+        global_status = STATUS_OUT_OF_MEMORY;
+        return NULL;
+    }
+
+    ps_context* c = (ps_context*)mem_malloc(sizeof(ps_context));
+    if (c) {
+        c->refcount = 1;
+        c->canvas = NULL;
+        c->state = state;
+        c->font_antialias = True;
+        c->font_kerning = True;
+        c->font_render_type = TEXT_TYPE_STROKE;
+        if (ctx) {
+            c->parent = ps_context_ref(ctx);
+            c->fonts = ctx->fonts;
+        } else {
+            c->parent = NULL;
+            c->fonts = new picasso::font_engine;
+        }
+        new ((void*) & (c->text_matrix)) picasso::trans_affine;
+        new ((void*) & (c->path)) picasso::graphic_path;
+        new ((void*) & (c->raster)) picasso::raster_adapter;
+        c->record = ps_picture_ref(picture);
+        global_status = STATUS_SUCCEED;
+        return c;
+    } else {
+        delete state; // free state on error
+        global_status = STATUS_OUT_OF_MEMORY;
+        return NULL;
+    }
+}
+
+ps_bool PICAPI ps_picture_playback(ps_context* ctx, const ps_picture* picture, const ps_matrix* matrix)
+{
+    if (!picasso::is_valid_system_device()) {
+        global_status = STATUS_DEVICE_ERROR;
+        return False;
+    }
+
+    if (!ctx || !picture || (ctx->record == picture)) {
+        global_status = STATUS_INVALID_ARGUMENT;
+        return False;
+    }
+
+    if (matrix) {
+        picture->pic.playback(ctx, matrix->matrix);
+    } else {
+        picture->pic.playback(ctx, picasso::trans_affine());
+    }
+    global_status = STATUS_SUCCEED;
+    return True;
+}
+
+#ifdef __cplusplus
+}
+#endif
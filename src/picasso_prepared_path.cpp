@@ -0,0 +1,118 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#include "common.h"
+#include "device.h"
+#include "interfaces.h"
+
+#include "picasso.h"
+#include "picasso_raster_adapter.h"
+#include "picasso_prepared_path.h"
+
+namespace picasso {
+
+prepared_path::prepared_path()
+    : m_rule(fill_non_zero)
+    , m_antialias(true)
+    , m_gamma(FLT_TO_SCALAR(1.0f))
+{
+    for (uint32_t i = 0; i < prepared_phases; i++) {
+        m_coverages[i].data = 0;
+        m_coverages[i].size = 0;
+        m_coverages[i].ready = false;
+    }
+}
+
+prepared_path::~prepared_path()
+{
+    for (uint32_t i = 0; i < prepared_phases; i++) {
+        if (m_coverages[i].data) {
+            mem_free(m_coverages[i].data);
+        }
+    }
+}
+
+bool prepared_path::init(const graphic_path& path, const trans_affine& mtx, filling_rule rule, bool antialias, scalar gamma)
+{
+    m_path = path;
+    m_matrix = mtx;
+    m_rule = rule;
+    m_antialias = antialias;
+    m_gamma = gamma;
+    return coverage(0) != 0;
+}
+
+const prepared_coverage* prepared_path::coverage(uint32_t phase)
+{
+    scoped_lock lock(m_lock);
+    prepared_coverage* c = &m_coverages[phase];
+    if (!c->ready && !rasterize(c, phase)) {
+        return 0;
+    }
+    return c;
+}
+
+bool prepared_path::rasterize(prepared_coverage* c, uint32_t phase)
+{
+    raster_adapter raster;
+    raster.set_antialias(m_antialias);
+    raster.set_gamma_power(m_gamma);
+    raster.set_raster_method(raster_fill);
+    raster.set_fill_attr(FIA_FILL_RULE, m_rule);
+    raster.set_fill_attr(FIA_CONVEX, m_path.get_class() != graphic_path::path_complex);
+
+    trans_affine mtx = m_matrix;
+    mtx.translate(phase_x(phase), phase_y(phase));
+    raster.set_transform(mtx);
+    raster.add_shape(m_path, 0);
+    raster.commit();
+
+    uint32_t size = raster.coverage_size();
+    if (size) {
+        c->data = (byte*)mem_malloc(size);
+        if (!c->data) {
+            return false;
+        }
+        raster.serialize_coverage(c->data);
+    }
+    c->size = size;
+    c->ready = true;
+    return true;
+}
+
+uint32_t prepared_path::phase_of(scalar x, scalar y, int32_t* px, int32_t* py)
+{
+    scalar fx = Floor(x);
+    scalar fy = Floor(y);
+    int32_t qx = iround((x - fx) * prepared_phase_scale);
+    int32_t qy = iround((y - fy) * prepared_phase_scale);
+
+    *px = iround(fx);
+    *py = iround(fy);
+
+    if (qx == prepared_phase_scale) {
+        qx = 0;
+        (*px)++;
+    }
+
+    if (qy == prepared_phase_scale) {
+        qy = 0;
+        (*py)++;
+    }
+    return (uint32_t)(qx | (qy << prepared_phase_shift));
+}
+
+scalar prepared_path::phase_x(uint32_t phase)
+{
+    return INT_TO_SCALAR(phase & (prepared_phase_scale - 1)) / prepared_phase_scale;
+}
+
+scalar prepared_path::phase_y(uint32_t phase)
+{
+    return INT_TO_SCALAR(phase >> prepared_phase_shift) / prepared_phase_scale;
+}
+
+}
@@ -0,0 +1,68 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#ifndef _PICASSO_PREPARED_PATH_H_
+#define _PICASSO_PREPARED_PATH_H_
+
+#include "common.h"
+#include "non_copy.h"
+#include "matrix.h"
+#include "graphic_base.h"
+#include "graphic_path.h"
+#include "thread_sync.h"
+
+namespace picasso {
+
+// subpixel phases of the offset, a quarter pixel in each direction.
+enum {
+    prepared_phase_shift = 2,
+    prepared_phase_scale = 1 << prepared_phase_shift,
+    prepared_phases = prepared_phase_scale * prepared_phase_scale,
+};
+
+struct prepared_coverage {
+    byte* data;
+    uint32_t size;
+    bool ready;
+};
+
+// path rasterized into serialized scanlines, which are filled at any
+// pixel offset without rasterizing again.
+class prepared_path : public non_copyable
+{
+public:
+    prepared_path();
+    ~prepared_path();
+
+    bool init(const graphic_path& path, const trans_affine& mtx, filling_rule rule, bool antialias, scalar gamma);
+
+    // coverage of the subpixel phase, it is rasterized at first use.
+    const prepared_coverage* coverage(uint32_t phase);
+
+    // split offset into pixel offset and subpixel phase.
+    static uint32_t phase_of(scalar x, scalar y, int32_t* px, int32_t* py);
+    static scalar phase_x(uint32_t phase);
+    static scalar phase_y(uint32_t phase);
+
+    const graphic_path& path(void) const { return m_path; }
+    const trans_affine& matrix(void) const { return m_matrix; }
+    filling_rule rule(void) const { return m_rule; }
+    bool antialias(void) const { return m_antialias; }
+    scalar gamma(void) const { return m_gamma; }
+private:
+    bool rasterize(prepared_coverage* c, uint32_t phase);
+
+    graphic_path m_path;
+    trans_affine m_matrix;
+    filling_rule m_rule;
+    bool m_antialias;
+    scalar m_gamma;
+    thread_mutex m_lock;
+    prepared_coverage m_coverages[prepared_phases];
+};
+
+}
+#endif /*_PICASSO_PREPARED_PATH_H_*/
@@ -0,0 +1,117 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#include "common.h"
+#include "device.h"
+
+#include "picasso.h"
+#include "picasso_objects.h"
+#include "picasso_prepared_path.h"
+#include "picasso_private.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+ps_prepared_path* PICAPI ps_prepared_path_create(const ps_context* ctx, const ps_path* path)
+{
+    if (!picasso::is_valid_system_device()) {
+        global_status = STATUS_DEVICE_ERROR;
+        return NULL;
+    }
+
+    if (!ctx || !path) {
+        global_status = STATUS_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    ps_prepared_path* p = (ps_prepared_path*)mem_malloc(sizeof(ps_prepared_path));
+    if (p) {
+        p->refcount = 1;
+        new ((void*) & (p->prepared)) picasso::prepared_path;
+        const picasso::context_state* state = ctx->state;
+        if (!p->prepared.init(path->path, state->world_matrix, state->brush.rule, state->antialias, state->gamma)) {
+            (&p->prepared)->picasso::prepared_path::~prepared_path();
+            mem_free(p);
+            global_status = STATUS_OUT_OF_MEMORY;
+            return NULL;
+        }
+        global_status = STATUS_SUCCEED;
+        return p;
+    } else {
+        global_status = STATUS_OUT_OF_MEMORY;
+        return NULL;
+    }
+}
+
+ps_prepared_path* PICAPI ps_prepared_path_ref(ps_prepared_path* path)
+{
+    if (!picasso::is_valid_system_device()) {
+        global_status = STATUS_DEVICE_ERROR;
+        return NULL;
+    }
+
+    if (!path) {
+        global_status = STATUS_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    picasso::atomic_inc(&path->refcount);
+    global_status = STATUS_SUCCEED;
+    return path;
+}
+
+void PICAPI ps_prepared_path_unref(ps_prepared_path* path)
+{
+    if (!picasso::is_valid_system_device()) {
+        global_status = STATUS_DEVICE_ERROR;
+        return;
+    }
+
+    if (!path) {
+        global_status = STATUS_INVALID_ARGUMENT;
+        return;
+    }
+
+    if (picasso::atomic_dec(&path->refcount) <= 0) {
+        (&path->prepared)->picasso::prepared_path::~prepared_path();
+        mem_free(path);
+    }
+    global_status = STATUS_SUCCEED;
+}
+
+void PICAPI ps_fill_prepared_path(ps_context* ctx, ps_prepared_path* path, const ps_point* offset)
+{
+    if (!picasso::is_valid_system_device()) {
+        global_status = STATUS_DEVICE_ERROR;
+        return;
+    }
+
+    if (!ctx || !path || !offset) {
+        global_status = STATUS_INVALID_ARGUMENT;
+        return;
+    }
+
+    if (ctx->record) {
+        // recorded as filling the path translated in device space.
+        picasso::context_state state(*ctx->state);
+        state.world_matrix = path->prepared.matrix();
+        state.world_matrix.translate(FLT_TO_SCALAR(offset->x), FLT_TO_SCALAR(offset->y));
+        state.brush.rule = path->prepared.rule();
+        state.antialias = path->prepared.antialias();
+        state.gamma = path->prepared.gamma();
+        ctx->record->pic.record(picasso::picture_op_fill, &state, path->prepared.path());
+    } else {
+        ctx->canvas->p->render_prepared_fill(ctx->state, &path->prepared,
+                                             FLT_TO_SCALAR(offset->x), FLT_TO_SCALAR(offset->y));
+        ctx->canvas->p->render_blur(ctx->state);
+    }
+    global_status = STATUS_SUCCEED;
+}
+
+#ifdef __cplusplus
+}
+#endif
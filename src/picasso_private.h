@@ -33,6 +33,7 @@
 #include "data_vector.h"
 #include "fixedopt.h"
 #include "global.h"
+#include "thread_sync.h"
 
 #include "picasso.h"
 
@@ -53,8 +54,8 @@ int32_t _bytes_per_color(ps_color_format fmt);
 
 } // namespace picasso
 
-// global error code
-extern "C" ps_status global_status;
+// error code of the last call, each thread has its own.
+extern "C" THREAD_LOCAL ps_status global_status;
 
 // Font Load
 bool platform_font_init(void);
@@ -51,6 +51,11 @@ void raster_adapter::add_shape(const vertex_source& vs, uint32_t id)
     m_impl->add_shape(vs, id);
 }
 
+void raster_adapter::set_shape_cache(path_cache* cache)
+{
+    m_impl->set_shape_cache(cache);
+}
+
 void raster_adapter::set_stroke_dashes(scalar start, const scalar* dashes, uint32_t num)
 {
     m_impl->set_stroke_dashes(start, dashes, num);
@@ -86,6 +91,31 @@ void raster_adapter::commit(void)
     m_impl->commit();
 }
 
+uint32_t raster_adapter::coverage_size(void)
+{
+    return m_impl->coverage_size();
+}
+
+void raster_adapter::serialize_coverage(byte* data)
+{
+    m_impl->serialize_coverage(data);
+}
+
+uint32_t raster_adapter::cells_size(void)
+{
+    return m_impl->cells_size();
+}
+
+void raster_adapter::serialize_cells(byte* data)
+{
+    m_impl->serialize_cells(data);
+}
+
+void raster_adapter::add_cells(const byte* data, uint32_t size, int32_t x, int32_t y)
+{
+    m_impl->add_cells(data, size, x, y);
+}
+
 //static methods
 bool raster_adapter::fill_contents_point(const vertex_source& vs, scalar x, scalar y, filling_rule rule)
 {
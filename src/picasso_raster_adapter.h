@@ -19,11 +19,13 @@ enum {
 
 enum {
     FIA_FILL_RULE,
+    FIA_CONVEX, // the shape is a single convex contour.
 };
 
 namespace picasso {
 
 class trans_affine;
+class path_cache;
 
 class raster_adapter
 {
@@ -42,10 +44,18 @@ public:
     void set_fill_attr(int32_t idx, int32_t val);
 
     void add_shape(const vertex_source& vs, uint32_t id = 0);
+    void set_shape_cache(path_cache* cache);
     void reset(void);
     void commit(void);
 
     bool is_empty(void) const;
+
+    uint32_t coverage_size(void);
+    void serialize_coverage(byte* data);
+
+    uint32_t cells_size(void);
+    void serialize_cells(byte* data);
+    void add_cells(const byte* data, uint32_t size, int32_t x, int32_t y);
 public:
     static bool fill_contents_point(const vertex_source& vs, scalar x, scalar y, filling_rule rule);
     static bool stroke_contents_point(const vertex_source& vs, scalar x, scalar y, scalar w);
@@ -0,0 +1,100 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#ifndef _COMPOSITE_AVX2_H_
+#define _COMPOSITE_AVX2_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+// avx2 vector for span composite, 16 x 16bit lanes hold 4 pixels,
+// each step loads 8 pixels into a low and a high vector.
+// unpack and pack work inside 128bit halves, so the low vector holds
+// pixels 0, 1, 4, 5 and the high vector holds pixels 2, 3, 6, 7.
+struct composite_vector_avx2 {
+    typedef __m256i vector_type;
+
+    enum {
+        step = 8
+    };
+
+    static _FORCE_INLINE_ vector_type splat(uint32_t v)
+    {
+        return _mm256_set1_epi16((int16_t)v);
+    }
+
+    static _FORCE_INLINE_ vector_type splat_pixel(uint32_t p)
+    {
+        return _mm256_unpacklo_epi8(_mm256_set1_epi32((int32_t)p), _mm256_setzero_si256());
+    }
+
+    static _FORCE_INLINE_ void load(const uint8_t* p, vector_type& lo, vector_type& hi)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        lo = _mm256_unpacklo_epi8(v, _mm256_setzero_si256());
+        hi = _mm256_unpackhi_epi8(v, _mm256_setzero_si256());
+    }
+
+    static _FORCE_INLINE_ void load_covers(const uint8_t* covers, vector_type& lo, vector_type& hi)
+    {
+        __m128i c = _mm_loadl_epi64((const __m128i*)covers);
+        c = _mm_unpacklo_epi8(c, c);
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(c, c)),
+                                            _mm_unpackhi_epi16(c, c), 1);
+        lo = _mm256_unpacklo_epi8(v, _mm256_setzero_si256());
+        hi = _mm256_unpackhi_epi8(v, _mm256_setzero_si256());
+    }
+
+    // store the low 8 bits of each lane.
+    static _FORCE_INLINE_ void store(uint8_t* p, vector_type lo, vector_type hi)
+    {
+        __m256i mask = _mm256_set1_epi16(0xFF);
+        _mm256_storeu_si256((__m256i*)p, _mm256_packus_epi16(_mm256_and_si256(lo, mask),
+                                                             _mm256_and_si256(hi, mask)));
+    }
+
+    static _FORCE_INLINE_ vector_type add(vector_type a, vector_type b) { return _mm256_add_epi16(a, b); }
+    static _FORCE_INLINE_ vector_type sub(vector_type a, vector_type b) { return _mm256_sub_epi16(a, b); }
+    static _FORCE_INLINE_ vector_type min(vector_type a, vector_type b) { return _mm256_min_epi16(a, b); }
+
+    static _FORCE_INLINE_ vector_type select(vector_type mask, vector_type a, vector_type b)
+    {
+        return _mm256_blendv_epi8(b, a, mask);
+    }
+
+    // (a * b + 255) >> 8
+    static _FORCE_INLINE_ vector_type mul_div(vector_type a, vector_type b)
+    {
+        return _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(a, b), _mm256_set1_epi16(0xFF)), 8);
+    }
+
+    // (a * b + c * d + 255) >> 8, products summed in 32 bits.
+    static _FORCE_INLINE_ vector_type mul_add_div(vector_type a, vector_type b, vector_type c, vector_type d)
+    {
+        __m256i r = _mm256_set1_epi32(0xFF);
+        __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(a, c), _mm256_unpacklo_epi16(b, d));
+        __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(a, c), _mm256_unpackhi_epi16(b, d));
+        lo = _mm256_srai_epi32(_mm256_add_epi32(lo, r), 8);
+        hi = _mm256_srai_epi32(_mm256_add_epi32(hi, r), 8);
+        return _mm256_packs_epi32(lo, hi);
+    }
+
+    // lane i of each pixel takes lane (I >> (i * 2)) & 3.
+    template <int I>
+    static _FORCE_INLINE_ vector_type shuffle(vector_type v)
+    {
+        return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(v, I), I);
+    }
+
+    template <int L>
+    static _FORCE_INLINE_ vector_type lane_mask(void)
+    {
+        return _mm256_slli_epi64(_mm256_set1_epi64x(0xFFFF), L * 16);
+    }
+};
+
+#endif /*_COMPOSITE_AVX2_H_*/
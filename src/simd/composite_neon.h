@@ -0,0 +1,105 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#ifndef _COMPOSITE_NEON_H_
+#define _COMPOSITE_NEON_H_
+
+#include <stdint.h>
+#include <arm_neon.h>
+
+// neon vector for span composite, 8 x 16bit lanes hold 2 pixels,
+// each step loads 4 pixels into a low and a high vector.
+struct composite_vector_neon {
+    typedef uint16x8_t vector_type;
+
+    enum {
+        step = 4
+    };
+
+    static _FORCE_INLINE_ vector_type splat(uint32_t v)
+    {
+        return vdupq_n_u16((uint16_t)v);
+    }
+
+    static _FORCE_INLINE_ vector_type splat_pixel(uint32_t p)
+    {
+        return vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(p)));
+    }
+
+    static _FORCE_INLINE_ void load(const uint8_t* p, vector_type& lo, vector_type& hi)
+    {
+        uint8x16_t v = vld1q_u8(p);
+        lo = vmovl_u8(vget_low_u8(v));
+        hi = vmovl_u8(vget_high_u8(v));
+    }
+
+    static _FORCE_INLINE_ void load_covers(const uint8_t* covers, vector_type& lo, vector_type& hi)
+    {
+        lo = vcombine_u16(vdup_n_u16(covers[0]), vdup_n_u16(covers[1]));
+        hi = vcombine_u16(vdup_n_u16(covers[2]), vdup_n_u16(covers[3]));
+    }
+
+    // store the low 8 bits of each lane.
+    static _FORCE_INLINE_ void store(uint8_t* p, vector_type lo, vector_type hi)
+    {
+        vst1q_u8(p, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+    }
+
+    static _FORCE_INLINE_ vector_type add(vector_type a, vector_type b) { return vaddq_u16(a, b); }
+    static _FORCE_INLINE_ vector_type sub(vector_type a, vector_type b) { return vsubq_u16(a, b); }
+    static _FORCE_INLINE_ vector_type min(vector_type a, vector_type b) { return vminq_u16(a, b); }
+
+    static _FORCE_INLINE_ vector_type select(vector_type mask, vector_type a, vector_type b)
+    {
+        return vbslq_u16(mask, a, b);
+    }
+
+    // (a * b + 255) >> 8
+    static _FORCE_INLINE_ vector_type mul_div(vector_type a, vector_type b)
+    {
+        return vshrq_n_u16(vmlaq_u16(vdupq_n_u16(0xFF), a, b), 8);
+    }
+
+    // (a * b + c * d + 255) >> 8, products summed in 32 bits.
+    static _FORCE_INLINE_ vector_type mul_add_div(vector_type a, vector_type b, vector_type c, vector_type d)
+    {
+        uint32x4_t r = vdupq_n_u32(0xFF);
+        uint32x4_t lo = vmlal_u16(vmlal_u16(r, vget_low_u16(a), vget_low_u16(b)), vget_low_u16(c), vget_low_u16(d));
+        uint32x4_t hi = vmlal_u16(vmlal_u16(r, vget_high_u16(a), vget_high_u16(b)), vget_high_u16(c), vget_high_u16(d));
+        return vcombine_u16(vshrn_n_u32(lo, 8), vshrn_n_u32(hi, 8));
+    }
+
+    // lane i of each pixel takes lane (I >> (i * 2)) & 3.
+    template <int I>
+    static _FORCE_INLINE_ vector_type shuffle(vector_type v)
+    {
+        static const uint8_t index[16] = {
+            ((I >> 0) & 3) * 2, ((I >> 0) & 3) * 2 + 1, ((I >> 2) & 3) * 2, ((I >> 2) & 3) * 2 + 1,
+            ((I >> 4) & 3) * 2, ((I >> 4) & 3) * 2 + 1, ((I >> 6) & 3) * 2, ((I >> 6) & 3) * 2 + 1,
+            ((I >> 0) & 3) * 2 + 8, ((I >> 0) & 3) * 2 + 9, ((I >> 2) & 3) * 2 + 8, ((I >> 2) & 3) * 2 + 9,
+            ((I >> 4) & 3) * 2 + 8, ((I >> 4) & 3) * 2 + 9, ((I >> 6) & 3) * 2 + 8, ((I >> 6) & 3) * 2 + 9,
+        };
+#if defined(__aarch64__)
+        return vreinterpretq_u16_u8(vqtbl1q_u8(vreinterpretq_u8_u16(v), vld1q_u8(index)));
+#else
+        uint8x16_t b = vreinterpretq_u8_u16(v);
+        uint8x8x2_t t = {{ vget_low_u8(b), vget_high_u8(b) }};
+        return vreinterpretq_u16_u8(vcombine_u8(vtbl2_u8(t, vld1_u8(index)), vtbl2_u8(t, vld1_u8(index + 8))));
+#endif
+    }
+
+    template <int L>
+    static _FORCE_INLINE_ vector_type lane_mask(void)
+    {
+        static const uint16_t mask[8] = {
+            L == 0 ? 0xFFFF : 0, L == 1 ? 0xFFFF : 0, L == 2 ? 0xFFFF : 0, L == 3 ? 0xFFFF : 0,
+            L == 0 ? 0xFFFF : 0, L == 1 ? 0xFFFF : 0, L == 2 ? 0xFFFF : 0, L == 3 ? 0xFFFF : 0,
+        };
+        return vld1q_u16(mask);
+    }
+};
+
+#endif /*_COMPOSITE_NEON_H_*/
@@ -0,0 +1,98 @@
+/* Picasso - a vector graphics library
+ *
+ * Copyright (C) 2026 Zhang Ji Peng
+ * Contact: onecoolx@gmail.com
+ */
+
+#ifndef _COMPOSITE_SSE2_H_
+#define _COMPOSITE_SSE2_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <emmintrin.h>
+
+// sse2 vector for span composite, 8 x 16bit lanes hold 2 pixels,
+// each step loads 4 pixels into a low and a high vector.
+struct composite_vector_sse2 {
+    typedef __m128i vector_type;
+
+    enum {
+        step = 4
+    };
+
+    static _FORCE_INLINE_ vector_type splat(uint32_t v)
+    {
+        return _mm_set1_epi16((int16_t)v);
+    }
+
+    static _FORCE_INLINE_ vector_type splat_pixel(uint32_t p)
+    {
+        return _mm_unpacklo_epi8(_mm_set1_epi32((int32_t)p), _mm_setzero_si128());
+    }
+
+    static _FORCE_INLINE_ void load(const uint8_t* p, vector_type& lo, vector_type& hi)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        lo = _mm_unpacklo_epi8(v, _mm_setzero_si128());
+        hi = _mm_unpackhi_epi8(v, _mm_setzero_si128());
+    }
+
+    static _FORCE_INLINE_ void load_covers(const uint8_t* covers, vector_type& lo, vector_type& hi)
+    {
+        int32_t c;
+        memcpy(&c, covers, sizeof(int32_t));
+        __m128i v = _mm_cvtsi32_si128(c);
+        v = _mm_unpacklo_epi8(v, v);
+        v = _mm_unpacklo_epi16(v, v);
+        lo = _mm_unpacklo_epi8(v, _mm_setzero_si128());
+        hi = _mm_unpackhi_epi8(v, _mm_setzero_si128());
+    }
+
+    // store the low 8 bits of each lane.
+    static _FORCE_INLINE_ void store(uint8_t* p, vector_type lo, vector_type hi)
+    {
+        __m128i mask = _mm_set1_epi16(0xFF);
+        _mm_storeu_si128((__m128i*)p, _mm_packus_epi16(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask)));
+    }
+
+    static _FORCE_INLINE_ vector_type add(vector_type a, vector_type b) { return _mm_add_epi16(a, b); }
+    static _FORCE_INLINE_ vector_type sub(vector_type a, vector_type b) { return _mm_sub_epi16(a, b); }
+    static _FORCE_INLINE_ vector_type min(vector_type a, vector_type b) { return _mm_min_epi16(a, b); }
+
+    static _FORCE_INLINE_ vector_type select(vector_type mask, vector_type a, vector_type b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    // (a * b + 255) >> 8
+    static _FORCE_INLINE_ vector_type mul_div(vector_type a, vector_type b)
+    {
+        return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(0xFF)), 8);
+    }
+
+    // (a * b + c * d + 255) >> 8, products summed in 32 bits.
+    static _FORCE_INLINE_ vector_type mul_add_div(vector_type a, vector_type b, vector_type c, vector_type d)
+    {
+        __m128i r = _mm_set1_epi32(0xFF);
+        __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(a, c), _mm_unpacklo_epi16(b, d));
+        __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(a, c), _mm_unpackhi_epi16(b, d));
+        lo = _mm_srai_epi32(_mm_add_epi32(lo, r), 8);
+        hi = _mm_srai_epi32(_mm_add_epi32(hi, r), 8);
+        return _mm_packs_epi32(lo, hi);
+    }
+
+    // lane i of each pixel takes lane (I >> (i * 2)) & 3.
+    template <int I>
+    static _FORCE_INLINE_ vector_type shuffle(vector_type v)
+    {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, I), I);
+    }
+
+    template <int L>
+    static _FORCE_INLINE_ vector_type lane_mask(void)
+    {
+        return _mm_slli_epi64(_mm_set_epi32(0, 0xFFFF, 0, 0xFFFF), L * 16);
+    }
+};
+
+#endif /*_COMPOSITE_SSE2_H_*/
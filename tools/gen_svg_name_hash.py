@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+"""
+SVG Name Hash Generator
+
+Searches a perfect hash for the tag and attribute name maps of the svg parser
+and prints the seeds and slot tables used by _get_svg_tag_type and
+_get_svg_attr_type. Run it again whenever _svg_tag_map or _svg_attr_map
+changes and paste the output over the tables in psx_svg_parser.cpp.
+
+Hash (must match _svg_name_hash):
+    key  = len | name[0] << 8 | name[len * 3 / 4] << 16 | name[len - 1] << 24
+    slot = (key * seed) mod 2^32 >> (32 - bits)
+
+A slot holds the map index plus one, zero marks an empty slot.
+
+Usage:
+    python3 tools/gen_svg_name_hash.py [ext/svg/psx_svg_parser.cpp]
+"""
+
+import re
+import sys
+import random
+
+TAG_BITS = 6
+ATTR_BITS = 8
+
+
+def read_map(src, name):
+    start = src.index(name + '[] = {')
+    end = src.index('};', start)
+    return [n for n, l in re.findall(r'\{"([^"]*)", (\d+),', src[start:end])]
+
+
+def name_key(s):
+    b = s.encode()
+    n = len(b)
+    return n | (b[0] << 8) | (b[(n * 3) >> 2] << 16) | (b[n - 1] << 24)
+
+
+def slot_of(key, seed, bits):
+    return ((key * seed) & 0xffffffff) >> (32 - bits)
+
+
+def search(names, bits):
+    keys = [name_key(s) for s in names if s]
+    if len(set(keys)) != len(keys):
+        sys.exit('error: two names share a hash key, change name_key')
+
+    rnd = random.Random(7)
+    for _ in range(10000000):
+        seed = rnd.getrandbits(32) | 1
+        used = set()
+        for k in keys:
+            h = slot_of(k, seed, bits)
+            if h in used:
+                break
+            used.add(h)
+        else:
+            return seed
+    sys.exit('error: no seed found, increase the table bits')
+
+
+def emit(label, names, bits):
+    seed = search(names, bits)
+    slots = [0] * (1 << bits)
+    for i, s in enumerate(names):
+        if s:  # empty name is the content token, handled by length
+            slots[slot_of(name_key(s), seed, bits)] = i + 1
+
+    print('#define %s_HASH_BITS %d' % (label, bits))
+    print('#define %s_HASH_SEED 0x%08xu' % (label, seed))
+    print('')
+    print('static const uint8_t _svg_%s_hash_slots[1 << %s_HASH_BITS] = {' % (label.lower(), label))
+    for i in range(0, len(slots), 16):
+        print('    ' + ', '.join(str(v) for v in slots[i:i + 16]) + ',')
+    print('};')
+    print('')
+
+
+def main():
+    path = sys.argv[1] if len(sys.argv) > 1 else 'ext/svg/psx_svg_parser.cpp'
+    with open(path) as f:
+        src = f.read()
+
+    emit('TAG', read_map(src, '_svg_tag_map'), TAG_BITS)
+    emit('ATTR', read_map(src, '_svg_attr_map'), ATTR_BITS)
+
+
+if __name__ == '__main__':
+    main()
@@ -215,3 +215,34 @@ TEST_F(PsxImageTest, PriorityLevels)
     psx_image_unregister_operator(&op2);
     psx_image_unregister_operator(&op3);
 }
+
+TEST_F(PsxImageTest, LoadFromFileMatchesMemory)
+{
+    FILE* fp = fopen("test.png", "rb");
+    ASSERT_NE(nullptr, fp);
+    std::vector<ps_byte> data;
+    ps_byte buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(fp);
+
+    psx_result err;
+    psx_image* from_file = psx_image_load("test.png", &err);
+    ASSERT_NE(nullptr, from_file);
+    EXPECT_EQ(S_OK, err);
+    psx_image* from_mem = psx_image_load_from_memory(data.data(), data.size(), NULL);
+    ASSERT_NE(nullptr, from_mem);
+
+    EXPECT_EQ(from_mem->width, from_file->width);
+    EXPECT_EQ(from_mem->height, from_file->height);
+    EXPECT_EQ(from_mem->pitch, from_file->pitch);
+    EXPECT_EQ(from_mem->num_frames, from_file->num_frames);
+    EXPECT_EQ(0, memcmp(IMG_DATA(from_mem), IMG_DATA(from_file), from_mem->pitch * from_mem->height));
+
+    psx_image_destroy(from_mem);
+    psx_image_destroy(from_file);
+
+    EXPECT_EQ(nullptr, psx_image_load("no_such_file.png", NULL));
+}
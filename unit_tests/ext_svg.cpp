@@ -202,6 +202,259 @@ TEST_F(SVGParserTest, SVGElementTest)
     release();
 }
 
+TEST_F(SVGParserTest, NameLookupTest)
+{
+    const char* svg_nl = "<svg><rect x1=1 y1=2 X=3 x=4 xx=5 width=6 widths=7 widt=8 stroke-linecap=round"
+                         " stroke-opacity=0.5 Stroke-opacity=\"1\"></rect><Rect></Rect><rects></rects>"
+                         "<rec></rec><polygon></polygon><stop></stop></svg>";
+    load(svg_nl);
+    ASSERT_NE(root, nullptr);
+    EXPECT_EQ(root->type(), SVG_TAG_SVG);
+    EXPECT_EQ(root->child_count(), 3);
+
+    psx_svg_node* svg_node = root->get_child(0);
+    EXPECT_EQ(svg_node->type(), SVG_TAG_RECT);
+    EXPECT_EQ(svg_node->attr_count(), 6);
+    EXPECT_EQ(svg_node->attr_at(0)->attr_id, SVG_ATTR_X1);
+    EXPECT_EQ(svg_node->attr_at(1)->attr_id, SVG_ATTR_Y1);
+    EXPECT_EQ(svg_node->attr_at(2)->attr_id, SVG_ATTR_X);
+    EXPECT_FLOAT_EQ(svg_node->attr_at(2)->value.fval, 4.0f);
+    EXPECT_EQ(svg_node->attr_at(3)->attr_id, SVG_ATTR_WIDTH);
+    EXPECT_FLOAT_EQ(svg_node->attr_at(3)->value.fval, 6.0f);
+    EXPECT_EQ(svg_node->attr_at(4)->attr_id, SVG_ATTR_STROKE_LINECAP);
+    EXPECT_EQ(svg_node->attr_at(5)->attr_id, SVG_ATTR_STROKE_OPACITY);
+    EXPECT_FLOAT_EQ(svg_node->attr_at(5)->value.fval, 0.5f);
+
+    EXPECT_EQ(root->get_child(1)->type(), SVG_TAG_POLYGON);
+    EXPECT_EQ(root->get_child(2)->type(), SVG_TAG_STOP);
+    release();
+}
+
+static bool _same_svg_tree(const psx_svg_node* a, const psx_svg_node* b)
+{
+    if (a->type() != b->type() || a->attr_count() != b->attr_count() || a->child_count() != b->child_count()) {
+        return false;
+    }
+
+    if ((a->content() == NULL) != (b->content() == NULL) || (a->content() && strcmp(a->content(), b->content()) != 0)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < a->attr_count(); i++) {
+        const psx_svg_attr* x = a->attr_at(i);
+        const psx_svg_attr* y = b->attr_at(i);
+        if (x->attr_id != y->attr_id || x->val_type != y->val_type || x->class_type != y->class_type) {
+            return false;
+        }
+        if (x->val_type == SVG_ATTR_VALUE_DATA && x->value.uval != y->value.uval) {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < a->child_count(); i++) {
+        if (!_same_svg_tree(a->get_child(i), b->get_child(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static psx_svg_node* _stream_load(const char* data, uint32_t len, uint32_t split, uint32_t chunk)
+{
+    psx_svg_stream* stream = psx_svg_stream_create();
+    bool ok = psx_svg_stream_push(stream, data, split);
+    for (uint32_t i = split; ok && i < len; i += chunk) {
+        ok = psx_svg_stream_push(stream, data + i, (len - i) < chunk ? (len - i) : chunk);
+    }
+    psx_svg_node* doc = ok ? psx_svg_stream_finish(stream) : NULL;
+    psx_svg_stream_destroy(stream);
+    return doc;
+}
+
+static bool _record_token(void* context, const psx_xml_token* token)
+{
+    std::string* out = (std::string*)context;
+    out->append(std::to_string(token->type)).append(":").append(token->start, TOKEN_LEN(token));
+    out->append(token->flags & PSX_XML_TOKEN_FLAT ? "/" : "");
+    for (uint32_t i = 0; i < psx_array_size(&token->attrs); i++) {
+        psx_xml_token_attr* attr = psx_array_get(&token->attrs, i, psx_xml_token_attr);
+        out->append(" ").append(attr->name_start, attr->name_end - attr->name_start);
+        if (attr->value_start) {
+            out->append("=").append(attr->value_start, attr->value_end - attr->value_start);
+        }
+    }
+    out->append("|");
+    return true;
+}
+
+TEST_F(SVGParserTest, XmlStreamTokenTest)
+{
+    const char* xml = "<?xml version=\"1.0\"?><!DOCTYPE svg><svg a=\"1\" b='two words' c=3 d>"
+                      "<!-- skip -- this --><g/>text &amp; &#x41; &#65; more\r\n<e f=\"&lt;\"/></svg>";
+    uint32_t len = (uint32_t)strlen(xml);
+
+    std::string expect;
+    EXPECT_TRUE(psx_xml_tokenizer(xml, len, _record_token, &expect));
+    EXPECT_NE(expect.find("|4:"), std::string::npos);
+
+    for (uint32_t split = 0; split <= len; split++) {
+        for (uint32_t chunk = 1; chunk <= 3; chunk++) {
+            std::string tokens;
+            psx_xml_stream* stream = psx_xml_stream_create(_record_token, &tokens);
+            EXPECT_TRUE(psx_xml_stream_push(stream, xml, split));
+            for (uint32_t i = split; i < len; i += chunk) {
+                EXPECT_TRUE(psx_xml_stream_push(stream, xml + i, (len - i) < chunk ? (len - i) : chunk));
+            }
+            psx_xml_stream_destroy(stream);
+            EXPECT_EQ(expect, tokens) << "split at " << split << " chunk size " << chunk;
+        }
+    }
+}
+
+TEST_F(SVGParserTest, StreamTest)
+{
+    const char* svg_st = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n"
+                         "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\">\n"
+                         "<svg width=\"200\" height='100' viewBox=\"0 0 200 100\">"
+                         "<!-- comment > with -- marks -->"
+                         "<defs><linearGradient id=\"lg\" x1=\"0\" x2=\"1\">"
+                         "<stop offset=\"0\" stop-color=\"#ff0000\"/><stop offset=1 stop-color=blue /></linearGradient></defs>"
+                         "<g id=\"layer\" transform=\"translate(10, 20) scale(2)\" fill=\"url(#lg)\">"
+                         "<rect x=\"1.5\" y=\"2.5e1\" width=\"30\" height=\"40\" rx=3 />"
+                         "<path d=\"M10,10 L20,20 C30,30 40,40 50,50 Z\" stroke=\"black\" stroke-width=\"2\"/>"
+                         "<polygon points=\"1,2 3,4 5,6\"/>"
+                         "<animate attributeName=\"opacity\" values=\"0;1;0\" dur=\"2s\" begin=\"0s;click\"/>"
+                         "</g>"
+                         "<unknown a=\"1\"><rect x=\"1\"/></unknown>"
+                         "<text x=\"5\" y=\"90\" font-size=\"12\">Hello world<tspan>more text</tspan></text>"
+                         "</svg>";
+
+    uint32_t len = (uint32_t)strlen(svg_st);
+    load(svg_st);
+    ASSERT_NE(root, nullptr);
+
+    // every split position, and one byte chunks
+    for (uint32_t split = 0; split <= len; split++) {
+        psx_svg_node* doc = _stream_load(svg_st, len, split, len);
+        ASSERT_NE(doc, nullptr) << "split at " << split;
+        EXPECT_TRUE(_same_svg_tree(root, doc)) << "split at " << split;
+        psx_svg_node_destroy(doc);
+    }
+
+    for (uint32_t chunk = 1; chunk < 8; chunk++) {
+        psx_svg_node* doc = _stream_load(svg_st, len, 0, chunk);
+        ASSERT_NE(doc, nullptr) << "chunk size " << chunk;
+        EXPECT_TRUE(_same_svg_tree(root, doc)) << "chunk size " << chunk;
+        psx_svg_node_destroy(doc);
+    }
+    release();
+
+    // errors are kept by the stream
+    psx_svg_stream* stream = psx_svg_stream_create();
+    EXPECT_TRUE(psx_svg_stream_push(stream, "<svg><g>", 8));
+    EXPECT_FALSE(psx_svg_stream_push(stream, "</rect>", 7));
+    EXPECT_FALSE(psx_svg_stream_push(stream, "</g></svg>", 10));
+    EXPECT_EQ(psx_svg_stream_finish(stream), nullptr);
+    psx_svg_stream_destroy(stream);
+
+    // incomplete document
+    stream = psx_svg_stream_create();
+    EXPECT_TRUE(psx_svg_stream_push(stream, "<svg><g>", 8));
+    EXPECT_EQ(psx_svg_stream_finish(stream), nullptr);
+    psx_svg_stream_destroy(stream);
+}
+
+static bool _write_binary(void* param, const uint8_t* data, uint32_t len)
+{
+    ((std::string*)param)->append((const char*)data, len);
+    return true;
+}
+
+static std::string _save_binary(const psx_svg_node* doc)
+{
+    std::string out;
+    EXPECT_TRUE(psx_svg_save_binary(doc, _write_binary, &out));
+    return out;
+}
+
+TEST_F(SVGParserTest, BinaryTest)
+{
+    const char* svg_bin = "<svg version=\"1.2\" width=\"200\" height=\"100\" viewBox=\"0 0 200 100\">"
+                          "<defs><linearGradient id=\"lg\" x1=\"0\" x2=\"1\">"
+                          "<stop offset=\"0\" stop-color=\"#ff0000\"/><stop offset=\"1\" stop-color=\"blue\"/>"
+                          "</linearGradient></defs>"
+                          "<g id=\"layer\" transform=\"translate(10, 20) scale(2)\" fill=\"url(#lg)\" opacity=\"inherit\">"
+                          "<path id=\"p\" d=\"M10,10 L20,20 C30,30 40,40 50,50 Q60,60 70,50 Z m5,5 h10\" stroke-dasharray=\"1 2 3\"/>"
+                          "<polygon points=\"1,2 3,4 5,6\"></polygon>"
+                          "<use xlink:href=\"#p\" x=\"5\"></use>"
+                          "<animate attributeName=\"opacity\" values=\"0;1;0\" keyTimes=\"0;0.5;1\" "
+                          "keySplines=\"0 0 1 1;0 0 1 1\" dur=\"2s\" begin=\"0s;btn.click+1s\" end=\"a1.end-1s\"></animate>"
+                          "<animateTransform attributeName=\"transform\" type=\"rotate\" from=\"0 5 5\" to=\"90\" "
+                          "values=\"0;45 1 1;90\" begin=\"indefinite\"></animateTransform>"
+                          "<animateMotion path=\"M0,0 L10,10\" values=\"0,0;5,5\" begin=\"accessKey(a)\"></animateMotion>"
+                          "<animateColor attributeName=\"fill\" values=\"red;#00ff00\" to=\"blue\"></animateColor>"
+                          "</g>"
+                          "<text x=\"5\" y=\"90\" font-family=\"serif\" font-size=\"12\">Hello world<tspan>more</tspan></text>"
+                          "</svg>";
+
+    load(svg_bin);
+    ASSERT_NE(root, nullptr);
+
+    std::string bin = _save_binary(root);
+    uint32_t len = (uint32_t)bin.size();
+    EXPECT_EQ(psx_svg_data_type((const uint8_t*)bin.data(), len), SVG_DATA_BINARY);
+    EXPECT_EQ(psx_svg_data_type((const uint8_t*)bin.data(), 3), SVG_DATA_UNKNOWN);
+    EXPECT_EQ(psx_svg_data_type((const uint8_t*)svg_bin, 3), SVG_DATA_XML);
+
+    psx_svg_node* doc = psx_svg_load_binary((const uint8_t*)bin.data(), len);
+    ASSERT_NE(doc, nullptr);
+    EXPECT_TRUE(_same_svg_tree(root, doc));
+    // values behind pointers are written back the same.
+    EXPECT_EQ(_save_binary(doc), bin);
+
+    // path vertices are kept
+    const psx_svg_attr* d = doc->get_child(1)->get_child(0)->attr_at(0);
+    ASSERT_EQ(d->val_type, SVG_ATTR_VALUE_PATH_PTR);
+    const ps_path* src = (const ps_path*)root->get_child(1)->get_child(0)->attr_at(0)->value.val;
+    const ps_path* dst = (const ps_path*)d->value.val;
+    ASSERT_EQ(ps_path_get_vertex_count(src), ps_path_get_vertex_count(dst));
+    for (uint32_t i = 0; i < ps_path_get_vertex_count(src); i++) {
+        ps_point p1, p2;
+        EXPECT_EQ(ps_path_get_vertex(src, i, &p1), ps_path_get_vertex(dst, i, &p2));
+        EXPECT_EQ(p1.x, p2.x);
+        EXPECT_EQ(p1.y, p2.y);
+    }
+    psx_svg_node_destroy(doc);
+
+    // loaded by the text entries too
+    doc = psx_svg_load_data(bin.data(), len);
+    ASSERT_NE(doc, nullptr);
+    EXPECT_TRUE(_same_svg_tree(root, doc));
+    psx_svg_node_destroy(doc);
+
+    for (uint32_t chunk = 1; chunk < 12; chunk++) {
+        doc = _stream_load(bin.data(), len, 0, chunk);
+        ASSERT_NE(doc, nullptr) << "chunk size " << chunk;
+        EXPECT_TRUE(_same_svg_tree(root, doc)) << "chunk size " << chunk;
+        psx_svg_node_destroy(doc);
+    }
+
+    // truncated or damaged data is rejected without reading out of the data.
+    for (uint32_t i = 0; i < len; i++) {
+        EXPECT_EQ(psx_svg_load_binary((const uint8_t*)bin.data(), i), nullptr);
+    }
+
+    for (uint32_t i = 0; i < len; i++) {
+        std::string bad = bin;
+        bad[i] = (char)(bad[i] ^ 0x5A);
+        psx_svg_node_destroy(psx_svg_load_binary((const uint8_t*)bad.data(), len));
+    }
+
+    std::string bad = bin;
+    bad[12] = (char)(bad[12] + 1); // version
+    EXPECT_EQ(psx_svg_load_binary((const uint8_t*)bad.data(), len), nullptr);
+}
+
 TEST_F(SVGParserTest, PolylineElementTest)
 {
     const char* svg_poly1 = "<svg><polyline points=\"100.0,50 200,150.0 180,110 200,200 210,340\"/></svg>";
@@ -289,6 +542,44 @@ TEST_F(SVGParserTest, PathElementTest)
     release();
 }
 
+TEST_F(SVGParserTest, NumberTest)
+{
+    const char* svg_num1 = "<svg><rect x=\"0.1\" y=\"1e-2\" width=\"+1.5E2\" height=\"12345678.9\" rx=\"123456789012345678901234567890\""
+                           " ry=\"-.5e-40\"></rect></svg>";
+    load(svg_num1);
+    psx_svg_node* svg_node = root->get_child(0);
+    EXPECT_EQ(svg_node->attr_count(), 6);
+    EXPECT_EQ(svg_node->attr_at(0)->value.fval, 0.1f);
+    EXPECT_EQ(svg_node->attr_at(1)->value.fval, 0.01f);
+    EXPECT_EQ(svg_node->attr_at(2)->value.fval, 150.0f);
+    EXPECT_EQ(svg_node->attr_at(3)->value.fval, 12345678.9f);
+    EXPECT_EQ(svg_node->attr_at(4)->value.fval, 123456789012345678901234567890.0f);
+    EXPECT_EQ(svg_node->attr_at(5)->value.fval, -.5e-40f);
+    release();
+
+    const char* svg_num2 = "<svg><path d=\"M1e1-2.5E-1L.5.5l1e+1 1e1\"></path></svg>";
+    load(svg_num2);
+    svg_node = root->get_child(0);
+    ps_path* path = (ps_path*)(svg_node->attr_at(0)->value.val);
+
+    ps_point p;
+    ps_path_cmd cmd = ps_path_get_vertex(path, 0, &p);
+    EXPECT_EQ(cmd, PATH_CMD_MOVE_TO);
+    EXPECT_EQ(p.x, 10.0f);
+    EXPECT_EQ(p.y, -0.25f);
+
+    cmd = ps_path_get_vertex(path, 1, &p);
+    EXPECT_EQ(cmd, PATH_CMD_LINE_TO);
+    EXPECT_EQ(p.x, 0.5f);
+    EXPECT_EQ(p.y, 0.5f);
+
+    cmd = ps_path_get_vertex(path, 2, &p);
+    EXPECT_EQ(cmd, PATH_CMD_LINE_TO);
+    EXPECT_EQ(p.x, 10.5f);
+    EXPECT_EQ(p.y, 10.5f);
+    release();
+}
+
 static inline bool _matrix_is_identity(const psx_svg_matrix* matrix)
 {
     return (matrix->m[0][0] == 1.0f &&
@@ -116,6 +116,186 @@ TEST_F(SvgAPITest, LoadFromMemoryBadCase)
     EXPECT_EQ(err, S_FAILURE);
 }
 
+struct svg_file_reader {
+    FILE* fp;
+    size_t max_read;
+};
+
+static size_t _read_svg_file(void* param, ps_byte* buffer, size_t length)
+{
+    svg_file_reader* reader = (svg_file_reader*)param;
+    return fread(buffer, 1, length < reader->max_read ? length : reader->max_read, reader->fp);
+}
+
+TEST_F(SvgAPITest, LoadFromStream)
+{
+    psx_result ret;
+    svg_file_reader reader = {fopen("tiger.svg", "rb"), 997};
+    ASSERT_NE(reader.fp, nullptr);
+
+    psx_svg* svg = psx_svg_load_from_stream(_read_svg_file, &reader, &ret);
+    fclose(reader.fp);
+    EXPECT_EQ(S_OK, ret);
+    ASSERT_NE(svg, nullptr);
+
+    psx_svg_render* render = psx_svg_render_create(svg, &ret);
+    EXPECT_EQ(S_OK, ret);
+    ASSERT_NE(render, nullptr);
+
+    ps_context* ctx = ps_context_create(get_test_canvas(), NULL);
+    ASSERT_NE(ctx, nullptr);
+
+    ps_identity(ctx);
+    ps_scale(ctx, 0.3f, 0.3f);
+
+    ret = psx_svg_render_draw(ctx, render);
+    EXPECT_EQ(S_OK, ret);
+
+    ps_translate(ctx, 600, 100);
+    ps_scale(ctx, 0.5f, 0.5f);
+
+    ret = psx_svg_render_draw(ctx, render);
+    EXPECT_EQ(S_OK, ret);
+
+    ps_translate(ctx, 600, 100);
+    ps_scale(ctx, 0.5f, 0.5f);
+
+    ret = psx_svg_render_draw(ctx, render);
+    EXPECT_EQ(S_OK, ret);
+
+    EXPECT_SNAPSHOT_EQ(svg_draw_tiger);
+
+    ps_context_unref(ctx);
+    psx_svg_render_destroy(render);
+    psx_svg_destroy(svg);
+}
+
+TEST_F(SvgAPITest, LoaderPushChunks)
+{
+    const char* svg_data = "<svg width=\"100\" height=\"100\"><rect x=\"10\" y=\"10\" width=\"80\" height=\"80\" fill=\"red\"/></svg>";
+    size_t len = strlen(svg_data);
+
+    psx_result err;
+    psx_svg_loader* loader = psx_svg_loader_create(&err);
+    EXPECT_EQ(err, S_OK);
+    ASSERT_NE(loader, nullptr);
+
+    for (size_t i = 0; i < len; i += 5) {
+        EXPECT_EQ(S_OK, psx_svg_loader_push(loader, (const ps_byte*)svg_data + i, (len - i) < 5 ? (len - i) : 5));
+    }
+
+    psx_svg* svg = psx_svg_loader_finish(loader, &err);
+    EXPECT_EQ(err, S_OK);
+    EXPECT_NE(svg, nullptr);
+    psx_svg_loader_destroy(loader);
+    psx_svg_destroy(svg);
+}
+
+TEST_F(SvgAPITest, LoaderBadCase)
+{
+    psx_result err;
+    EXPECT_EQ(psx_svg_load_from_stream(nullptr, nullptr, &err), nullptr);
+    EXPECT_EQ(err, S_BAD_PARAMS);
+
+    EXPECT_EQ(psx_svg_loader_push(nullptr, (const ps_byte*)"<svg>", 5), S_BAD_PARAMS);
+    EXPECT_EQ(psx_svg_loader_finish(nullptr, &err), nullptr);
+    EXPECT_EQ(err, S_BAD_PARAMS);
+
+    psx_svg_loader* loader = psx_svg_loader_create(&err);
+    ASSERT_NE(loader, nullptr);
+    EXPECT_EQ(S_OK, psx_svg_loader_push(loader, (const ps_byte*)"<svg><g>", 8));
+    EXPECT_EQ(psx_svg_loader_finish(loader, &err), nullptr);
+    EXPECT_EQ(err, S_FAILURE);
+    psx_svg_loader_destroy(loader);
+
+    loader = psx_svg_loader_create(&err);
+    ASSERT_NE(loader, nullptr);
+    EXPECT_EQ(S_FAILURE, psx_svg_loader_push(loader, (const ps_byte*)"<1svg>", 6));
+    EXPECT_EQ(psx_svg_loader_finish(loader, &err), nullptr);
+    EXPECT_EQ(err, S_FAILURE);
+    psx_svg_loader_destroy(loader);
+}
+
+static int32_t _write_svg_data(void* param, const ps_byte* data, size_t length)
+{
+    std::vector<ps_byte>* out = (std::vector<ps_byte>*)param;
+    out->insert(out->end(), data, data + length);
+    return S_OK;
+}
+
+TEST_F(SvgAPITest, CompileAndLoad)
+{
+    psx_result ret;
+    psx_svg* svg = psx_svg_load("tiger.svg", &ret);
+    ASSERT_NE(svg, nullptr);
+
+    std::vector<ps_byte> compiled;
+    EXPECT_EQ(S_OK, psx_svg_compile(svg, _write_svg_data, &compiled));
+    EXPECT_EQ(S_OK, psx_svg_compile_to_file(svg, "tiger.svgb"));
+    psx_svg_destroy(svg);
+
+    svg = psx_svg_load_from_memory(compiled.data(), compiled.size(), &ret);
+    EXPECT_EQ(S_OK, ret);
+    EXPECT_NE(svg, nullptr);
+    psx_svg_destroy(svg);
+
+    svg = psx_svg_load("tiger.svgb", &ret);
+    EXPECT_EQ(S_OK, ret);
+    ASSERT_NE(svg, nullptr);
+
+    psx_svg_render* render = psx_svg_render_create(svg, &ret);
+    EXPECT_EQ(S_OK, ret);
+    ASSERT_NE(render, nullptr);
+
+    ps_context* ctx = ps_context_create(get_test_canvas(), NULL);
+    ASSERT_NE(ctx, nullptr);
+
+    ps_identity(ctx);
+    ps_scale(ctx, 0.3f, 0.3f);
+
+    ret = psx_svg_render_draw(ctx, render);
+    EXPECT_EQ(S_OK, ret);
+
+    ps_translate(ctx, 600, 100);
+    ps_scale(ctx, 0.5f, 0.5f);
+
+    ret = psx_svg_render_draw(ctx, render);
+    EXPECT_EQ(S_OK, ret);
+
+    ps_translate(ctx, 600, 100);
+    ps_scale(ctx, 0.5f, 0.5f);
+
+    ret = psx_svg_render_draw(ctx, render);
+    EXPECT_EQ(S_OK, ret);
+
+    EXPECT_SNAPSHOT_EQ(svg_draw_tiger);
+
+    ps_context_unref(ctx);
+    psx_svg_render_destroy(render);
+    psx_svg_destroy(svg);
+}
+
+TEST_F(SvgAPITest, CompileBadCase)
+{
+    psx_result err;
+    std::vector<ps_byte> compiled;
+    EXPECT_EQ(S_BAD_PARAMS, psx_svg_compile(nullptr, _write_svg_data, &compiled));
+    EXPECT_EQ(S_BAD_PARAMS, psx_svg_compile_to_file(nullptr, "bad.svgb"));
+
+    const char* svg_data = "<svg width=\"100\" height=\"100\"><rect width=\"80\" height=\"80\"/></svg>";
+    psx_svg* svg = psx_svg_load_from_memory((const ps_byte*)svg_data, strlen(svg_data), &err);
+    ASSERT_NE(svg, nullptr);
+    EXPECT_EQ(S_BAD_PARAMS, psx_svg_compile(svg, nullptr, nullptr));
+    EXPECT_EQ(S_OK, psx_svg_compile(svg, _write_svg_data, &compiled));
+    psx_svg_destroy(svg);
+
+    // truncated compiled data.
+    EXPECT_EQ(psx_svg_load_from_memory(compiled.data(), compiled.size() - 1, &err), nullptr);
+    EXPECT_EQ(err, S_FAILURE);
+    EXPECT_EQ(psx_svg_load_from_memory(compiled.data(), 12, &err), nullptr);
+    EXPECT_EQ(err, S_FAILURE);
+}
+
 TEST_F(SvgAPITest, RenderBadCase)
 {
     psx_result err;
@@ -396,3 +396,54 @@ TEST_F(CompositePixelTest, LuminosityMode)
 
     EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
 }
+
+TEST_F(CompositePixelTest, SpanBlendPixelValues)
+{
+    uint8_t buf[16 * 4 * 4];
+    for (size_t i = 0; i < sizeof(buf); i += 4) {
+        buf[i] = buf[i + 1] = buf[i + 2] = 0x80;
+        buf[i + 3] = 0xFF;
+    }
+
+    ps_canvas* canvas = ps_canvas_create_with_data(buf, COLOR_FORMAT_RGBA, 16, 4, 16 * 4);
+    ps_context* sctx = ps_context_create(canvas, NULL);
+
+    ps_set_composite_operator(sctx, COMPOSITE_SRC_OVER);
+    ps_color fg = {1.0f, 0.0f, 0.0f, 0.5f};
+    ps_set_source_color(sctx, &fg);
+    ps_rect rc = {1, 0, 13, 4};
+    ps_rectangle(sctx, &rc);
+    ps_fill(sctx);
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+
+    // pixels out of the span keep the background.
+    EXPECT_EQ(0x80, buf[0]);
+    EXPECT_EQ(0x80, buf[14 * 4]);
+
+    // Dca' = Sca + Dca.(1 - Sa)
+    for (int32_t y = 0; y < 4; y++) {
+        for (int32_t x = 1; x < 14; x++) {
+            uint8_t* p = buf + (y * 16 + x) * 4;
+            EXPECT_EQ(192, p[0]) << "at " << x << "," << y;
+            EXPECT_EQ(64, p[1]) << "at " << x << "," << y;
+            EXPECT_EQ(64, p[2]) << "at " << x << "," << y;
+            EXPECT_EQ(255, p[3]) << "at " << x << "," << y;
+        }
+    }
+
+    ps_set_composite_operator(sctx, COMPOSITE_PLUS);
+    ps_rectangle(sctx, &rc);
+    ps_fill(sctx);
+
+    // Dca' = Sca + Dca
+    for (int32_t x = 1; x < 14; x++) {
+        uint8_t* p = buf + (16 + x) * 4;
+        EXPECT_EQ(255, p[0]) << "at " << x;
+        EXPECT_EQ(64, p[1]) << "at " << x;
+        EXPECT_EQ(64, p[2]) << "at " << x;
+        EXPECT_EQ(255, p[3]) << "at " << x;
+    }
+
+    ps_context_unref(sctx);
+    ps_canvas_unref(canvas);
+}
@@ -241,6 +241,46 @@ TEST_F(FilterBlurTest, FilterBicubic)
     EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
 }
 
+TEST_F(FilterBlurTest, FilterScaledImage)
+{
+    ps_canvas* img_canvas = ps_canvas_create(COLOR_FORMAT_RGBA, 40, 30);
+    ASSERT_TRUE(img_canvas);
+
+    ps_context* img_ctx = ps_context_create(img_canvas, NULL);
+    ps_color white = {1.0f, 1.0f, 1.0f, 1.0f};
+    ps_set_source_color(img_ctx, &white);
+    ps_clear(img_ctx);
+
+    ps_color red = {1.0f, 0.0f, 0.0f, 1.0f};
+    ps_set_source_color(img_ctx, &red);
+    for (int y = 0; y < 30; y += 10) {
+        for (int x = (y / 10) % 2 * 10; x < 40; x += 20) {
+            ps_rect cell = {(float)x, (float)y, 10, 10};
+            ps_rectangle(img_ctx, &cell);
+        }
+    }
+    ps_fill(img_ctx);
+
+    ps_image* img = ps_image_create_from_canvas(img_canvas, NULL);
+    ASSERT_TRUE(img);
+
+    // axis aligned scaling of each filter.
+    ps_filter filters[] = {FILTER_BILINEAR, FILTER_GAUSSIAN, FILTER_BICUBIC, FILTER_QUADRIC};
+    for (int i = 0; i < 4; i++) {
+        ps_set_filter(ctx, filters[i]);
+        ps_set_source_image(ctx, img);
+
+        ps_rect rc = {(float)(i % 2) * 300 + 10, (float)(i / 2) * 220 + 10, 290, 210};
+        ps_rectangle(ctx, &rc);
+        ps_fill(ctx);
+    }
+
+    ps_image_unref(img);
+    ps_context_unref(img_ctx);
+    ps_canvas_unref(img_canvas);
+    EXPECT_SNAPSHOT_EQ(filter_scaled_image);
+}
+
 TEST_F(FilterBlurTest, GammaCorrection)
 {
     ps_color bg = {0.5f, 0.5f, 0.5f, 1.0f};
@@ -2055,3 +2055,353 @@ TEST_F(FontTest, CompleteAPIValidation)
 
     EXPECT_SYS_SNAPSHOT_EQ(font_complete_validation);
 }
+
+// Glyph coverage cache tests
+TEST_F(FontTest, GlyphCoverageCacheEvictsLeastRecentlyUsed)
+{
+    uint32_t entry = sizeof(picasso::glyph_coverage) + 100;
+    picasso::glyph_coverage_cache cache(entry * 2);
+
+    ASSERT_TRUE(cache.cache_coverage('a', 0, 0, 100) != NULL);
+    ASSERT_TRUE(cache.cache_coverage('b', 0, 0, 100) != NULL);
+    EXPECT_EQ(entry * 2, cache.used_bytes());
+
+    // 'a' is used, 'b' will be evicted.
+    ASSERT_TRUE(cache.find_coverage('a', 0, 0) != NULL);
+    ASSERT_TRUE(cache.cache_coverage('c', 0, 0, 100) != NULL);
+
+    EXPECT_TRUE(cache.find_coverage('a', 0, 0) != NULL);
+    EXPECT_TRUE(cache.find_coverage('b', 0, 0) == NULL);
+    EXPECT_TRUE(cache.find_coverage('c', 0, 0) != NULL);
+    EXPECT_EQ(entry * 2, cache.used_bytes());
+
+    // keys are different at offset in pixel.
+    EXPECT_TRUE(cache.find_coverage('a', 0.25f, 0) == NULL);
+    EXPECT_TRUE(cache.find_coverage('a', 0, 0.5f) == NULL);
+
+    // larger than budget is not cached.
+    EXPECT_TRUE(cache.cache_coverage('d', 0, 0, entry * 2) == NULL);
+
+    cache.clear();
+    EXPECT_EQ(0U, cache.used_bytes());
+    EXPECT_TRUE(cache.find_coverage('a', 0, 0) == NULL);
+}
+
+// Font cache tests
+TEST_F(FontTest, FontCacheEvictsLeastRecentlyUsedFonts)
+{
+    picasso::font_engine engine;
+    picasso::font_desc desc("Arial");
+    desc.set_charset(CHARSET_ANSI);
+    desc.set_weight(400);
+
+    desc.set_height(12);
+    ASSERT_TRUE(engine.create_font(desc));
+    picasso::font* f12 = engine.current_font();
+    uint32_t bytes = engine.used_bytes();
+    EXPECT_GT(bytes, 0U);
+
+    desc.set_height(14);
+    ASSERT_TRUE(engine.create_font(desc));
+    desc.set_height(16);
+    ASSERT_TRUE(engine.create_font(desc));
+    picasso::font* f16 = engine.current_font();
+    EXPECT_EQ(3U, engine.num_fonts());
+    EXPECT_EQ(bytes * 3, engine.used_bytes());
+
+    // cached font is found by signature.
+    desc.set_height(12);
+    ASSERT_TRUE(engine.create_font(desc));
+    EXPECT_EQ(f12, engine.current_font());
+    EXPECT_EQ(3U, engine.num_fonts());
+
+    // least recently used font 14 is freed.
+    engine.set_cache_budget(bytes * 3 - 1);
+    EXPECT_EQ(2U, engine.num_fonts());
+    EXPECT_EQ(bytes * 2, engine.used_bytes());
+
+    desc.set_height(16);
+    ASSERT_TRUE(engine.create_font(desc));
+    EXPECT_EQ(f16, engine.current_font());
+
+    // font 14 is created again, font 12 is freed.
+    desc.set_height(14);
+    ASSERT_TRUE(engine.create_font(desc));
+    EXPECT_EQ(2U, engine.num_fonts());
+    desc.set_height(16);
+    ASSERT_TRUE(engine.create_font(desc));
+    EXPECT_EQ(f16, engine.current_font());
+
+    // font in use is always kept.
+    engine.set_cache_budget(0);
+    EXPECT_EQ(1U, engine.num_fonts());
+    EXPECT_EQ(f16, engine.current_font());
+}
+
+TEST_F(FontTest, SetFontCacheSize)
+{
+    ps_context* shared = ps_context_create(canvas, ctx);
+    ASSERT_TRUE(shared != NULL);
+
+    ps_set_font_cache_size(ctx, 0);
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+    EXPECT_EQ(0U, shared->fonts->cache_budget());
+
+    ps_font* f1 = ps_font_create("Arial", CHARSET_ANSI, 12.0f, FONT_WEIGHT_REGULAR, False);
+    ps_font* f2 = ps_font_create("Arial", CHARSET_ANSI, 18.0f, FONT_WEIGHT_BOLD, False);
+    ps_set_font(ctx, f1);
+    ps_set_font(shared, f2);
+
+    ps_size s1, s2;
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(ps_get_text_extent(ctx, "Picasso", 7, &s1));
+        EXPECT_TRUE(ps_get_text_extent(shared, "Picasso", 7, &s2));
+        EXPECT_LT(s1.h, s2.h);
+        EXPECT_EQ(1U, ctx->fonts->num_fonts());
+    }
+
+    ps_set_font_cache_size(NULL, 0);
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+
+    ps_font_unref(f2);
+    ps_font_unref(f1);
+    ps_context_unref(shared);
+}
+
+TEST_F(FontTest, GlyphCacheFullUnicodeCodes)
+{
+    picasso::glyph_cache_manager cache(65536);
+    picasso::rect bounds(0, 0, 10, 10);
+
+    picasso::glyph* g1 = cache.cache_glyph(0xF600, 1, 16, picasso::glyph_type_outline, bounds, 10, 10, 0);
+    ASSERT_TRUE(g1 != NULL);
+    EXPECT_TRUE(cache.find_glyph(0x1F600) == NULL);
+
+    picasso::glyph* g2 = cache.cache_glyph(0x1F600, 2, 16, picasso::glyph_type_outline, bounds, 10, 10, 0);
+    ASSERT_TRUE(g2 != NULL);
+    EXPECT_EQ(g1, cache.find_glyph(0xF600));
+    EXPECT_EQ(g2, cache.find_glyph(0x1F600));
+    EXPECT_EQ(0x1F600U, cache.find_glyph(0x1F600)->code);
+
+    // codes of same glyph index share the glyph.
+    EXPECT_TRUE(cache.find_glyph(0x10FFFF) == NULL);
+    EXPECT_EQ(g2, cache.find_glyph_index(0x10FFFF, 2));
+    EXPECT_EQ(g2, cache.find_glyph(0x10FFFF));
+    EXPECT_TRUE(cache.find_glyph_index(0x10FFFE, 3) == NULL);
+
+    EXPECT_EQ(4U, cache.stats().hits);
+    EXPECT_EQ(2U, cache.stats().misses);
+    EXPECT_EQ(0U, cache.stats().evictions);
+}
+
+TEST_F(FontTest, GlyphCacheEvictsLeastRecentlyUsedPages)
+{
+    picasso::glyph_cache_manager cache(65536);
+    picasso::rect bounds(0, 0, 10, 10);
+
+    // about a page per glyph.
+    for (uint32_t i = 0; i < 16; i++) {
+        ASSERT_TRUE(cache.cache_glyph(i, i, 12000, picasso::glyph_type_gray, bounds, 10, 10, 0) != NULL);
+        cache.find_glyph(0); // glyph 0 is hot.
+        EXPECT_LE(cache.memory_used(), 65536U + 16384U);
+    }
+
+    EXPECT_TRUE(cache.find_glyph(0) != NULL);
+    EXPECT_TRUE(cache.find_glyph(15) != NULL);
+    EXPECT_TRUE(cache.find_glyph(1) == NULL);
+    EXPECT_GT(cache.stats().evictions, 0U);
+
+    // evicted glyph is cached again.
+    ASSERT_TRUE(cache.cache_glyph(1, 1, 12000, picasso::glyph_type_gray, bounds, 10, 10, 0) != NULL);
+    EXPECT_TRUE(cache.find_glyph(1) != NULL);
+
+    // larger than a page.
+    picasso::glyph* g = cache.cache_glyph(100, 100, 40000, picasso::glyph_type_gray, bounds, 10, 10, 0);
+    ASSERT_TRUE(g != NULL);
+    EXPECT_EQ(40000U, g->data_size);
+    EXPECT_TRUE(cache.find_glyph(100) != NULL);
+}
+
+TEST_F(FontTest, GlyphCacheKeepsPinnedPages)
+{
+    picasso::glyph_cache_manager cache(65536);
+    picasso::rect bounds(0, 0, 10, 10);
+
+    picasso::glyph* g = cache.cache_glyph(0, 0, 12000, picasso::glyph_type_gray, bounds, 10, 10, 0);
+    ASSERT_TRUE(g != NULL);
+    cache.pin_glyph(g);
+
+    for (uint32_t i = 1; i < 16; i++) {
+        ASSERT_TRUE(cache.cache_glyph(i, i, 12000, picasso::glyph_type_gray, bounds, 10, 10, 0) != NULL);
+        EXPECT_LE(cache.memory_used(), 65536U + 16384U * 2);
+    }
+
+    EXPECT_GT(cache.stats().evictions, 0U);
+    EXPECT_EQ(g, cache.find_glyph(0));
+    EXPECT_TRUE(cache.find_glyph(1) == NULL);
+}
+
+TEST_F(FontTest, GetFontCacheInfo)
+{
+    ps_font_cache_info info;
+    ps_set_font_cache_size(ctx, 1048576);
+
+    ps_font* font = ps_font_create("Arial", CHARSET_UNICODE, 16.0f, FONT_WEIGHT_REGULAR, False);
+    ps_font* old = ps_set_font(ctx, font);
+
+    ps_glyph g;
+    EXPECT_TRUE(ps_get_glyph(ctx, 'a', &g));
+    EXPECT_TRUE(ps_get_font_cache_info(ctx, &info));
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+    uint32_t misses = info.glyph_misses;
+    uint32_t hits = info.glyph_hits;
+
+    EXPECT_TRUE(ps_get_glyph(ctx, 'a', &g));
+    EXPECT_TRUE(ps_get_glyph(ctx, 0x1F600, &g));
+    EXPECT_TRUE(ps_get_font_cache_info(ctx, &info));
+    EXPECT_EQ(hits + 1, info.glyph_hits);
+    EXPECT_EQ(misses + 1, info.glyph_misses);
+    EXPECT_GE(info.fonts, 1U);
+    EXPECT_GT(info.used_size, 0U);
+    EXPECT_EQ(1048576U, info.cache_size);
+
+    EXPECT_FALSE(ps_get_font_cache_info(NULL, &info));
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+    EXPECT_FALSE(ps_get_font_cache_info(ctx, NULL));
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+
+    ps_set_font(ctx, old);
+    ps_font_unref(font);
+}
+
+TEST_F(FontTest, FontSizesShareFace)
+{
+    ps_font* small = ps_font_create("Arial", CHARSET_ANSI, 12.0f, FONT_WEIGHT_REGULAR, False);
+    ps_font* large = ps_font_create("Arial", CHARSET_ANSI, 36.0f, FONT_WEIGHT_REGULAR, False);
+
+    // the fonts are created in different order, sizes of face are switched between them.
+    ps_context* other = ps_context_create(canvas, NULL);
+    ps_set_font(other, large);
+    ps_size l1, s1, l2, s2;
+    EXPECT_TRUE(ps_get_text_extent(other, "Picasso", 7, &l1));
+
+    ps_set_font(ctx, small);
+    EXPECT_TRUE(ps_get_text_extent(ctx, "Picasso", 7, &s1));
+    ps_set_font(ctx, large);
+    EXPECT_TRUE(ps_get_text_extent(ctx, "Picasso", 7, &l2));
+    ps_set_font(ctx, small);
+    EXPECT_TRUE(ps_get_text_extent(ctx, "Picasso W", 9, &s2));
+
+    EXPECT_FLOAT_EQ(l1.w, l2.w);
+    EXPECT_FLOAT_EQ(l1.h, l2.h);
+    EXPECT_FLOAT_EQ(s1.h, s2.h);
+    EXPECT_LT(s1.w, s2.w);
+    EXPECT_LT(s2.h, l2.h);
+
+    ps_context_unref(other);
+    ps_font_unref(large);
+    ps_font_unref(small);
+}
+
+static void _draw_kerned_text(ps_context* c, ps_font* font, float alpha)
+{
+    ps_set_font(c, font);
+    ps_set_text_render_type(c, TEXT_TYPE_SMOOTH);
+    ps_set_text_kerning(c, True);
+
+    ps_color color = {0.1f, 0.2f, 0.8f, alpha};
+    ps_set_text_color(c, &color);
+
+    // kerned and overlapped glyphs, drawn again at integer offset with cached coverage.
+    ps_text_out_length(c, 10.3f, 5.6f, "AVAWffij Type", 13);
+    ps_translate(c, 7.0f, 40.0f);
+    ps_text_out_length(c, 10.3f, 5.6f, "AVAWffij Type", 13);
+    ps_translate(c, -7.0f, -40.0f);
+}
+
+TEST_F(FontTest, DrawCachedTextSameAsOutline)
+{
+    const int32_t w = 256, h = 100;
+    uint8_t* cached = (uint8_t*)calloc(w * 4, h);
+    uint8_t* outline = (uint8_t*)calloc(w * 4, h);
+    ps_canvas* cv1 = ps_canvas_create_with_data(cached, COLOR_FORMAT_RGBA, w, h, w * 4);
+    ps_canvas* cv2 = ps_canvas_create_with_data(outline, COLOR_FORMAT_RGBA, w, h, w * 4);
+    ps_context* c1 = ps_context_create(cv1, NULL);
+    ps_context* c2 = ps_context_create(cv2, NULL);
+
+    ps_font* font = ps_font_create("Arial", CHARSET_ANSI, 28.0f, FONT_WEIGHT_REGULAR, False);
+
+    float alphas[] = {1.0f, 0.5f};
+    for (int i = 0; i < 2; i++) {
+        memset(cached, 0, w * 4 * h);
+        memset(outline, 0, w * 4 * h);
+
+        _draw_kerned_text(c1, font, alphas[i]);
+
+        // recorded text is the outline of glyphs, it is rasterized at playback.
+        ps_picture* picture = ps_picture_create();
+        ps_context* rc = ps_context_create_recording(picture, NULL);
+        _draw_kerned_text(rc, font, alphas[i]);
+        ps_context_unref(rc);
+        ps_picture_playback(c2, picture, NULL);
+        ps_picture_unref(picture);
+
+        EXPECT_EQ(0, memcmp(cached, outline, w * 4 * h));
+    }
+
+    ps_font_unref(font);
+    ps_context_unref(c2);
+    ps_context_unref(c1);
+    ps_canvas_unref(cv2);
+    ps_canvas_unref(cv1);
+    free(outline);
+    free(cached);
+}
+
+TEST_F(FontTest, ShowGlyphsOverGlyphCacheBudget)
+{
+    const int32_t w = 400, h = 400;
+    uint8_t* shown = (uint8_t*)calloc(w * 4, h);
+    uint8_t* drawn = (uint8_t*)calloc(w * 4, h);
+    ps_canvas* cv = ps_canvas_create_with_data(shown, COLOR_FORMAT_RGBA, w, h, w * 4);
+    ps_canvas* cv2 = ps_canvas_create_with_data(drawn, COLOR_FORMAT_RGBA, w, h, w * 4);
+    ps_context* c = ps_context_create(cv, NULL);
+
+    // large mono glyphs, so a few hundred glyphs are over the glyph cache budget of the font.
+    ps_font* font = ps_font_create("Arial", CHARSET_UNICODE, 300.0f, FONT_WEIGHT_REGULAR, False);
+    ps_set_font(c, font);
+    ps_set_text_antialias(c, False);
+
+    const uint32_t max_glyphs = 0xFFFF;
+    ps_glyph* glyphs = (ps_glyph*)calloc(max_glyphs, sizeof(ps_glyph));
+    ps_font_cache_info info;
+    uint32_t n = 0;
+    do {
+        ASSERT_TRUE(ps_get_glyph(c, 'A' + n, &glyphs[n]));
+        n++;
+        ps_get_font_cache_info(c, &info);
+    } while (info.used_size < 2097152 && n < max_glyphs - 'A');
+    ASSERT_GE(info.used_size, 2097152U);
+
+    // glyphs got before are kept.
+    ps_glyph again;
+    ASSERT_TRUE(ps_get_glyph(c, 'A', &again));
+    EXPECT_EQ(glyphs[0].glyph, again.glyph);
+
+    ps_show_glyphs(c, 20, 20, glyphs, 1);
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+
+    ps_uchar16 ch = 'A';
+    ps_canvas* old = ps_context_set_canvas(c, cv2);
+    ps_wide_text_out_length(c, 20, 20, &ch, 1);
+    EXPECT_EQ(0, memcmp(shown, drawn, w * 4 * h));
+
+    ps_context_set_canvas(c, old);
+    free(glyphs);
+    ps_font_unref(font);
+    ps_context_unref(c);
+    ps_canvas_unref(cv2);
+    ps_canvas_unref(cv);
+    free(drawn);
+    free(shown);
+}
@@ -29,6 +29,9 @@
 #include "test.h"
 #include "pat565.h"
 
+#include "picasso_objects.h"
+#include "path_cache.h"
+
 class PaintTest : public ::testing::Test
 {
 protected:
@@ -297,6 +300,49 @@ TEST_F(PaintTest, StrokeResetDash)
     EXPECT_SNAPSHOT_EQ(stroke_reset_dash);
 }
 
+TEST_F(PaintTest, StrokeOutlineCache)
+{
+    createComplexPath();
+    ps_set_line_width(ctx, 15.0f);
+
+    for (int i = 0; i < 2; i++) {
+        clear_test_canvas();
+        ps_identity(ctx);
+
+        ps_color color = {1.0f, 0.0f, 0.0f, 1.0f};
+        ps_set_stroke_color(ctx, &color);
+        ps_set_line_join(ctx, LINE_JOIN_MITER);
+        ps_set_path(ctx, path);
+        ps_stroke(ctx);
+
+        ps_translate(ctx, 0, 80.0f);
+
+        ps_color color2 = {0.0f, 1.0f, 0.0f, 1.0f};
+        ps_set_stroke_color(ctx, &color2);
+        ps_set_line_join(ctx, LINE_JOIN_ROUND);
+        ps_set_path(ctx, path);
+        ps_stroke(ctx);
+
+        ps_translate(ctx, 0, 80.0f);
+
+        ps_color color3 = {0.0f, 0.0f, 1.0f, 1.0f};
+        ps_set_stroke_color(ctx, &color3);
+        ps_set_line_join(ctx, LINE_JOIN_BEVEL);
+        ps_set_path(ctx, path);
+        ps_stroke(ctx);
+
+        // one outline for each join, reused by the second pass.
+        ASSERT_NE(nullptr, path->path.cache());
+        EXPECT_EQ(3U, path->path.cache()->num_outlines());
+    }
+
+    EXPECT_SNAPSHOT_EQ(stroke_line_join);
+
+    ps_point p = {250, 150};
+    ps_path_line_to(path, &p);
+    EXPECT_EQ(nullptr, path->path.cache());
+}
+
 // Fill Tests
 TEST_F(PaintTest, FillRule)
 {
@@ -563,6 +609,207 @@ TEST_F(PaintTest, BadCaseFillEmptyPath)
     EXPECT_EQ(ps_last_status(), STATUS_SUCCEED);
 }
 
+// Culling Tests
+static bool _is_blank(const uint8_t* buf, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        if (buf[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_F(PaintTest, CullOutsideClip)
+{
+    uint8_t buf[64 * 64 * 4] = {0};
+    ps_canvas* cv = ps_canvas_create_with_data(buf, COLOR_FORMAT_RGBA, 64, 64, 64 * 4);
+    ps_context* c = ps_context_create(cv, nullptr);
+    ps_color color = {1.0f, 0.0f, 0.0f, 1.0f};
+    ps_set_source_color(c, &color);
+    ps_set_stroke_color(c, &color);
+
+    ps_rect r = {-60, 10, 40, 40};
+    ps_path_add_rect(path, &r);
+    ps_set_path(c, path);
+    ps_fill(c);
+    EXPECT_TRUE(_is_blank(buf, sizeof(buf)));
+
+    // clipped out by device clip.
+    ps_rect clip = {0, 0, 10, 10};
+    ps_save(c);
+    ps_scissor_rect(c, &clip);
+    ps_rect r2 = {30, 30, 20, 20};
+    ps_rectangle(c, &r2);
+    ps_fill(c);
+    ps_restore(c);
+    EXPECT_TRUE(_is_blank(buf, sizeof(buf)));
+
+    // shadow of a path out of canvas is still drawn.
+    ps_set_shadow(c, 70.0f, 0.0f, 0.0f);
+    ps_set_path(c, path);
+    ps_fill(c);
+    EXPECT_FALSE(_is_blank(buf, sizeof(buf)));
+    ps_reset_shadow(c);
+
+    // miter join reaches into canvas from a path out of it.
+    memset(buf, 0, sizeof(buf));
+    ps_point p1 = {-40, 20};
+    ps_point p2 = {-6, 24};
+    ps_point p3 = {-40, 28};
+    ps_move_to(c, &p1);
+    ps_line_to(c, &p2);
+    ps_line_to(c, &p3);
+    ps_set_line_join(c, LINE_JOIN_MITER);
+    ps_set_miter_limit(c, 20.0f);
+    ps_set_line_width(c, 4.0f);
+    ps_stroke(c);
+    EXPECT_FALSE(_is_blank(buf, sizeof(buf)));
+
+    ps_context_unref(c);
+    ps_canvas_unref(cv);
+}
+
+TEST_F(PaintTest, CullInsideClipSameAsClipped)
+{
+    createStarPath();
+
+    // inside of canvas, spans are not clipped.
+    ps_color color = {0.0f, 0.4f, 0.8f, 0.7f};
+    ps_set_source_color(ctx, &color);
+    ps_set_path(ctx, path);
+    ps_fill(ctx);
+    EXPECT_SNAPSHOT_EQ(fill_cull_inside);
+
+    // same drawing with spans clipped by the clip path.
+    clear_test_canvas();
+    ps_rect clip = {0, 0, TEST_WIDTH, TEST_HEIGHT};
+    ps_save(ctx);
+    ps_rectangle(ctx, &clip);
+    ps_clip(ctx);
+    ps_set_path(ctx, path);
+    ps_fill(ctx);
+    ps_restore(ctx);
+    EXPECT_SNAPSHOT_EQ(fill_cull_inside);
+}
+
+// Convex Tests
+static void _fill_convex_shapes(ps_context* c, bool complex)
+{
+    ps_color color = {0.2f, 0.5f, 0.9f, 0.8f};
+    ps_set_source_color(c, &color);
+
+    for (int i = 0; i < 4; i++) {
+        ps_path* p = ps_path_create();
+        ps_rect r = {10.3f + i * 28, 12.6f, 24.5f, 40.25f};
+        if (i == 0) {
+            ps_path_add_ellipse(p, &r);
+        } else if (i == 1) {
+            ps_path_add_rounded_rect(p, &r, 6, 4, 2, 8, 5, 5, 3, 9);
+        } else if (i == 2) {
+            ps_path_add_rect(p, &r);
+        } else {
+            ps_point pts[] = {{100.5f, 70.2f}, {126.7f, 118.4f}, {91.1f, 100.9f}};
+            ps_path_move_to(p, &pts[0]);
+            ps_path_line_to(p, &pts[1]);
+            ps_path_line_to(p, &pts[2]);
+        }
+
+        // another contour makes the path not convex.
+        if (complex) {
+            ps_point pt = {500, 500};
+            ps_path_move_to(p, &pt);
+        }
+
+        ps_save(c);
+        ps_rotate(c, 0.1f * i);
+        ps_set_path(c, p);
+        ps_fill(c);
+        ps_restore(c);
+        ps_path_unref(p);
+    }
+}
+
+TEST_F(PaintTest, FillConvexSameAsComplex)
+{
+    uint8_t convex[128 * 128 * 4] = {0};
+    uint8_t complex[128 * 128 * 4] = {0};
+    ps_canvas* cv1 = ps_canvas_create_with_data(convex, COLOR_FORMAT_RGBA, 128, 128, 128 * 4);
+    ps_canvas* cv2 = ps_canvas_create_with_data(complex, COLOR_FORMAT_RGBA, 128, 128, 128 * 4);
+    ps_context* c1 = ps_context_create(cv1, nullptr);
+    ps_context* c2 = ps_context_create(cv2, nullptr);
+
+    _fill_convex_shapes(c1, false);
+    _fill_convex_shapes(c2, true);
+    EXPECT_EQ(0, memcmp(convex, complex, sizeof(convex)));
+
+    ps_set_fill_rule(c1, FILL_RULE_EVEN_ODD);
+    ps_set_fill_rule(c2, FILL_RULE_EVEN_ODD);
+    ps_set_antialias(c1, False);
+    ps_set_antialias(c2, False);
+    ps_translate(c1, 0.5f, 60.25f);
+    ps_translate(c2, 0.5f, 60.25f);
+    _fill_convex_shapes(c1, false);
+    _fill_convex_shapes(c2, true);
+    EXPECT_EQ(0, memcmp(convex, complex, sizeof(convex)));
+
+    ps_context_unref(c2);
+    ps_context_unref(c1);
+    ps_canvas_unref(cv2);
+    ps_canvas_unref(cv1);
+}
+
+static void _fill_rects(ps_context* c, bool complex)
+{
+    // pixel aligned and fractional, opaque and translucent.
+    ps_rect rects[] = {{4, 6, 50, 30}, {30.25f, 20.5f, 40.5f, 33.75f}, {-10, 60, 40, 90}, {70.6f, 70.2f, 0.3f, 20}};
+    float alphas[] = {1.0f, 0.6f, 0.8f, 1.0f};
+
+    for (int i = 0; i < 4; i++) {
+        ps_color color = {0.9f, 0.3f * i, 0.2f, alphas[i]};
+        ps_set_source_color(c, &color);
+        ps_rectangle(c, &rects[i]);
+        if (complex) {
+            ps_point pt = {500, 500};
+            ps_move_to(c, &pt);
+        }
+        ps_fill(c);
+    }
+}
+
+TEST_F(PaintTest, FillRectSameAsComplex)
+{
+    uint8_t rect[128 * 128 * 4] = {0};
+    uint8_t complex[128 * 128 * 4] = {0};
+    ps_canvas* cv1 = ps_canvas_create_with_data(rect, COLOR_FORMAT_RGBA, 128, 128, 128 * 4);
+    ps_canvas* cv2 = ps_canvas_create_with_data(complex, COLOR_FORMAT_RGBA, 128, 128, 128 * 4);
+    ps_context* c1 = ps_context_create(cv1, nullptr);
+    ps_context* c2 = ps_context_create(cv2, nullptr);
+
+    _fill_rects(c1, false);
+    _fill_rects(c2, true);
+    EXPECT_EQ(0, memcmp(rect, complex, sizeof(rect)));
+
+    // clipped, scaled and without antialias.
+    ps_rect clip = {10.5f, 12, 90, 100};
+    ps_scissor_rect(c1, &clip);
+    ps_scissor_rect(c2, &clip);
+    ps_set_antialias(c1, False);
+    ps_set_antialias(c2, False);
+    ps_translate(c1, 12, 8);
+    ps_translate(c2, 12, 8);
+    ps_scale(c1, 1.5f, 0.75f);
+    ps_scale(c2, 1.5f, 0.75f);
+    _fill_rects(c1, false);
+    _fill_rects(c2, true);
+    EXPECT_EQ(0, memcmp(rect, complex, sizeof(rect)));
+
+    ps_context_unref(c2);
+    ps_context_unref(c1);
+    ps_canvas_unref(cv2);
+    ps_canvas_unref(cv1);
+}
+
 // Shadow Tests
 TEST_F(PaintTest, ShadowBasic)
 {
@@ -588,6 +835,34 @@ TEST_F(PaintTest, ShadowBasic)
     EXPECT_SNAPSHOT_EQ(shadow_draw_basic);
 }
 
+TEST_F(PaintTest, ShadowLayerReuse)
+{
+    ps_color shadow_color = {0.0f, 0.0f, 0.0f, 0.8f};
+    ps_set_shadow_color(ctx, &shadow_color);
+    ps_color color = {0.0f, 0.6f, 0.2f, 1.0f};
+    ps_set_source_color(ctx, &color);
+
+    // large layer first, then smaller layers reuse it.
+    ps_set_shadow(ctx, 6.0f, 6.0f, 0.3f);
+    ps_rect r1 = {20, 20, 300, 200};
+    ps_rectangle(ctx, &r1);
+    ps_fill(ctx);
+
+    ps_color shadow_color2 = {0.0f, 0.0f, 1.0f, 0.6f};
+    ps_set_shadow_color(ctx, &shadow_color2);
+    ps_set_shadow(ctx, 4.0f, 4.0f, 0.1f);
+    ps_rect r2 = {350, 40, 80, 60};
+    ps_ellipse(ctx, &r2);
+    ps_fill(ctx);
+
+    ps_set_shadow(ctx, 3.0f, 3.0f, 0.0f);
+    ps_rect r3 = {350, 150, 100, 50};
+    ps_rectangle(ctx, &r3);
+    ps_fill(ctx);
+
+    EXPECT_SNAPSHOT_EQ(shadow_layer_reuse);
+}
+
 TEST_F(PaintTest, BadCaseShadowNullContext)
 {
     ps_set_shadow(nullptr, 5.0f, 5.0f, 2.0f);
@@ -26,6 +26,8 @@
 
 #include "test.h"
 
+#include "picasso_objects.h"
+
 class PathTest : public ::testing::Test
 {
 protected:
@@ -379,6 +381,103 @@ TEST_F(PathTest, BoundingRect)
     ASSERT_FLOAT_EQ(rect.h, 60.0f);
 }
 
+TEST_F(PathTest, BoundingRectFollowsChanges)
+{
+    ps_rect rect;
+    ps_path_bounding_rect(path, &rect);
+    EXPECT_FLOAT_EQ(0.0f, rect.w); // empty path.
+    EXPECT_FLOAT_EQ(0.0f, rect.h);
+
+    ps_point p1 = {10.0f, 20.0f};
+    ps_point p2 = {-30.0f, 90.0f};
+    ps_point p3 = {50.0f, 80.0f};
+    ps_path_move_to(path, &p1);
+    ps_path_line_to(path, &p2);
+    ps_path_line_to(path, &p3);
+
+    ps_path_bounding_rect(path, &rect);
+    EXPECT_FLOAT_EQ(-30.0f, rect.x);
+    EXPECT_FLOAT_EQ(90.0f, rect.y + rect.h);
+
+    ps_matrix* m = ps_matrix_create();
+    ps_matrix_translate(m, 100.0f, 10.0f);
+    ps_matrix_transform_path(m, path);
+    ps_matrix_unref(m);
+
+    ps_path_bounding_rect(path, &rect);
+    EXPECT_FLOAT_EQ(70.0f, rect.x);
+    EXPECT_FLOAT_EQ(30.0f, rect.y);
+    EXPECT_FLOAT_EQ(80.0f, rect.w);
+    EXPECT_FLOAT_EQ(70.0f, rect.h);
+
+    ps_path_clear(path);
+    ps_path_bounding_rect(path, &rect);
+    EXPECT_FLOAT_EQ(0.0f, rect.w);
+    EXPECT_FLOAT_EQ(0.0f, rect.h);
+}
+
+TEST_F(PathTest, ShapeClass)
+{
+    typedef picasso::graphic_path gp;
+    EXPECT_EQ(0U, path->path.sub_paths());
+    EXPECT_EQ(gp::path_complex, path->path.get_class());
+
+    ps_rect rect = {10.0f, 10.0f, 100.0f, 50.0f};
+    ps_path_add_rect(path, &rect);
+    EXPECT_EQ(1U, path->path.sub_paths());
+    EXPECT_EQ(gp::path_rect, path->path.get_class());
+
+    // rotated rectangle is still convex.
+    ps_matrix* m = ps_matrix_create();
+    ps_matrix_rotate(m, 0.5f);
+    ps_matrix_transform_path(m, path);
+    ps_matrix_unref(m);
+    EXPECT_EQ(gp::path_convex, path->path.get_class());
+
+    ps_path_clear(path);
+    ps_path_add_ellipse(path, &rect);
+    EXPECT_EQ(gp::path_convex, path->path.get_class());
+
+    ps_path_clear(path);
+    ps_path_add_rounded_rect(path, &rect, 5.0f, 5.0f, 5.0f, 5.0f, 5.0f, 5.0f, 5.0f, 5.0f);
+    EXPECT_EQ(gp::path_convex, path->path.get_class());
+
+    // open triangle is closed implicitly.
+    ps_path_clear(path);
+    ps_point t[3] = {{0, 0}, {40, 0}, {20, 30}};
+    ps_path_move_to(path, &t[0]);
+    ps_path_line_to(path, &t[1]);
+    ps_path_line_to(path, &t[2]);
+    EXPECT_EQ(gp::path_convex, path->path.get_class());
+
+    // concave once a vertex turns back.
+    ps_point c = {20, 10};
+    ps_path_line_to(path, &c);
+    EXPECT_EQ(gp::path_complex, path->path.get_class());
+
+    // star turns one way but winds twice.
+    ps_path_clear(path);
+    for (int i = 0; i < 5; i++) {
+        float a = i * 3.14159265f * 4 / 5;
+        ps_point p = {100 + 50 * cosf(a), 100 + 50 * sinf(a)};
+        if (i == 0) {
+            ps_path_move_to(path, &p);
+        } else {
+            ps_path_line_to(path, &p);
+        }
+    }
+    ps_path_sub_close(path);
+    EXPECT_EQ(gp::path_complex, path->path.get_class());
+
+    // two contours.
+    ps_path_clear(path);
+    ps_path_add_rect(path, &rect);
+    ps_rect rect2 = {200.0f, 10.0f, 10.0f, 10.0f};
+    ps_path_add_rect(path, &rect2);
+    EXPECT_EQ(2U, path->path.sub_paths());
+    EXPECT_EQ(gp::path_complex, path->path.get_class());
+}
+
 TEST_F(PathTest, Contains)
 {
     // Create a simple rectangle
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2026, Zhang Ji Peng
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test.h"
+
+#define PICTURE_WIDTH 400
+#define PICTURE_HEIGHT 300
+
+class PsPictureTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        PS_Init();
+        direct = (uint8_t*)calloc(PICTURE_WIDTH * 4, PICTURE_HEIGHT);
+        replay = (uint8_t*)calloc(PICTURE_WIDTH * 4, PICTURE_HEIGHT);
+        direct_canvas = ps_canvas_create_with_data(direct, COLOR_FORMAT_RGBA,
+                                                   PICTURE_WIDTH, PICTURE_HEIGHT, PICTURE_WIDTH * 4);
+        replay_canvas = ps_canvas_create_with_data(replay, COLOR_FORMAT_RGBA,
+                                                   PICTURE_WIDTH, PICTURE_HEIGHT, PICTURE_WIDTH * 4);
+        direct_ctx = ps_context_create(direct_canvas, NULL);
+        replay_ctx = ps_context_create(replay_canvas, NULL);
+    }
+
+    void TearDown() override
+    {
+        ps_context_unref(replay_ctx);
+        ps_context_unref(direct_ctx);
+        ps_canvas_unref(replay_canvas);
+        ps_canvas_unref(direct_canvas);
+        free(replay);
+        free(direct);
+        PS_Shutdown();
+    }
+
+    static void DrawScene(ps_context* ctx)
+    {
+        ps_color bg = {1.0f, 1.0f, 1.0f, 1.0f};
+        ps_set_source_color(ctx, &bg);
+        ps_clear(ctx);
+
+        ps_color red = {0.9f, 0.1f, 0.1f, 0.8f};
+        ps_rect er = {20, 10, 300, 200};
+        ps_set_source_color(ctx, &red);
+        ps_ellipse(ctx, &er);
+        ps_fill(ctx);
+
+        ps_color blue = {0.1f, 0.2f, 0.9f, 0.6f};
+        ps_point p0 = {10, 290};
+        ps_point c1 = {100, -100};
+        ps_point c2 = {300, 400};
+        ps_point p1 = {390, 20};
+        float dashes[] = {20.0f, 8.0f};
+        ps_set_stroke_color(ctx, &blue);
+        ps_set_line_width(ctx, 5.0f);
+        ps_set_line_dash(ctx, 0, dashes, 2);
+        ps_move_to(ctx, &p0);
+        ps_bezier_to(ctx, &c1, &c2, &p1);
+        ps_stroke(ctx);
+        ps_reset_line_dash(ctx);
+
+        ps_point s = {50, 50};
+        ps_point e = {350, 250};
+        ps_color c0 = {0.0f, 0.8f, 0.2f, 1.0f};
+        ps_color c3 = {0.9f, 0.9f, 0.0f, 0.5f};
+        ps_gradient* gradient = ps_gradient_create_linear(GRADIENT_SPREAD_REFLECT, &s, &e);
+        ps_gradient_add_color_stop(gradient, 0.0f, &c0);
+        ps_gradient_add_color_stop(gradient, 1.0f, &c3);
+        ps_rect gr = {100, 80, 200, 150};
+        ps_save(ctx);
+        ps_translate(ctx, 200, 150);
+        ps_rotate(ctx, 0.5f);
+        ps_translate(ctx, -200, -150);
+        ps_set_source_gradient(ctx, gradient);
+        ps_set_composite_operator(ctx, COMPOSITE_MULTIPLY);
+        ps_rectangle(ctx, &gr);
+        ps_paint(ctx);
+        ps_restore(ctx);
+        ps_gradient_unref(gradient);
+
+        ps_color green = {0.2f, 0.7f, 0.4f, 0.7f};
+        ps_rect cr = {0, 100, 400, 120};
+        ps_rect fr = {30, 30, 340, 240};
+        ps_save(ctx);
+        ps_clip_rect(ctx, &cr);
+        ps_set_source_color(ctx, &green);
+        ps_set_shadow(ctx, 3.0f, 3.0f, 0.2f);
+        ps_ellipse(ctx, &fr);
+        ps_fill(ctx);
+        ps_restore(ctx);
+
+        ps_save(ctx);
+        ps_ellipse(ctx, &er);
+        ps_clip(ctx);
+        ps_set_antialias(ctx, False);
+        ps_set_source_color(ctx, &blue);
+        ps_rectangle(ctx, &fr);
+        ps_fill(ctx);
+        ps_restore(ctx);
+
+        ps_rect tr = {150, 10, 200, 40};
+        ps_set_text_color(ctx, &red);
+        ps_draw_text(ctx, &tr, "Picture", 7, DRAW_TEXT_FILL, TEXT_ALIGN_CENTER);
+    }
+
+    uint8_t* direct = nullptr;
+    uint8_t* replay = nullptr;
+    ps_canvas* direct_canvas = nullptr;
+    ps_canvas* replay_canvas = nullptr;
+    ps_context* direct_ctx = nullptr;
+    ps_context* replay_ctx = nullptr;
+};
+
+TEST_F(PsPictureTest, CreateAndRef)
+{
+    ps_picture* picture = ps_picture_create();
+    ASSERT_NE(nullptr, picture);
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+
+    EXPECT_EQ(picture, ps_picture_ref(picture));
+    ps_picture_unref(picture);
+    ps_picture_unref(picture);
+
+    EXPECT_EQ(nullptr, ps_picture_ref(NULL));
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+    ps_picture_unref(NULL);
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+}
+
+TEST_F(PsPictureTest, RecordingContext)
+{
+    ps_picture* picture = ps_picture_create();
+    ps_context* ctx = ps_context_create_recording(picture, NULL);
+    ASSERT_NE(nullptr, ctx);
+    EXPECT_EQ(nullptr, ps_context_get_canvas(ctx));
+
+    EXPECT_EQ(nullptr, ps_context_create_recording(NULL, NULL));
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+
+    EXPECT_EQ(False, ps_picture_playback(ctx, picture, NULL));
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+    EXPECT_EQ(False, ps_picture_playback(NULL, picture, NULL));
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+    EXPECT_EQ(False, ps_picture_playback(replay_ctx, NULL, NULL));
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+
+    ps_context_unref(ctx);
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+    ps_picture_unref(picture);
+}
+
+TEST_F(PsPictureTest, RecordingContextSetCanvas)
+{
+    ps_picture* picture = ps_picture_create();
+    ps_context* ctx = ps_context_create_recording(picture, NULL);
+    ASSERT_NE(nullptr, ctx);
+
+    EXPECT_EQ(nullptr, ps_context_set_canvas(ctx, replay_canvas));
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+    EXPECT_EQ(replay_canvas, ps_context_get_canvas(ctx));
+
+    ps_context_unref(ctx);
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+    ps_picture_unref(picture);
+}
+
+TEST_F(PsPictureTest, PlaybackSameAsDrawing)
+{
+    ps_picture* picture = ps_picture_create();
+    ps_context* ctx = ps_context_create_recording(picture, direct_ctx);
+    DrawScene(ctx);
+    ps_context_unref(ctx);
+
+    DrawScene(direct_ctx);
+
+    EXPECT_NE(False, ps_picture_playback(replay_ctx, picture, NULL));
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+    EXPECT_EQ(0, memcmp(direct, replay, PICTURE_WIDTH * 4 * PICTURE_HEIGHT));
+
+    // replay many times.
+    memset(replay, 0, PICTURE_WIDTH * 4 * PICTURE_HEIGHT);
+    ps_picture_playback(replay_ctx, picture, NULL);
+    ps_picture_playback(replay_ctx, picture, NULL);
+    EXPECT_EQ(0, memcmp(direct, replay, PICTURE_WIDTH * 4 * PICTURE_HEIGHT));
+
+    ps_picture_unref(picture);
+}
+
+TEST_F(PsPictureTest, PlaybackWithMatrix)
+{
+    ps_picture* picture = ps_picture_create();
+    ps_context* ctx = ps_context_create_recording(picture, NULL);
+    DrawScene(ctx);
+    ps_context_unref(ctx);
+
+    ps_translate(direct_ctx, 50, 20);
+    ps_scale(direct_ctx, 0.5f, 0.5f);
+    DrawScene(direct_ctx);
+
+    ps_matrix* matrix = ps_matrix_create();
+    ps_matrix_scale(matrix, 0.5f, 0.5f);
+    ps_translate(replay_ctx, 50, 20);
+    EXPECT_NE(False, ps_picture_playback(replay_ctx, picture, matrix));
+    EXPECT_EQ(0, memcmp(direct, replay, PICTURE_WIDTH * 4 * PICTURE_HEIGHT));
+
+    ps_matrix_unref(matrix);
+    ps_picture_unref(picture);
+}
+
+TEST_F(PsPictureTest, PlaybackIntoPicture)
+{
+    ps_picture* picture = ps_picture_create();
+    ps_context* ctx = ps_context_create_recording(picture, NULL);
+    DrawScene(ctx);
+    ps_context_unref(ctx);
+
+    ps_picture* outer = ps_picture_create();
+    ctx = ps_context_create_recording(outer, NULL);
+    ps_color c = {0.5f, 0.5f, 0.5f, 1.0f};
+    ps_rect r = {0, 0, 100, 100};
+    ps_set_source_color(ctx, &c);
+    ps_rectangle(ctx, &r);
+    ps_fill(ctx);
+    ps_translate(ctx, 10, 10);
+    EXPECT_NE(False, ps_picture_playback(ctx, picture, NULL));
+    ps_context_unref(ctx);
+
+    ps_set_source_color(direct_ctx, &c);
+    ps_rectangle(direct_ctx, &r);
+    ps_fill(direct_ctx);
+    ps_translate(direct_ctx, 10, 10);
+    ps_picture_playback(direct_ctx, picture, NULL);
+
+    ps_picture_playback(replay_ctx, outer, NULL);
+    EXPECT_EQ(0, memcmp(direct, replay, PICTURE_WIDTH * 4 * PICTURE_HEIGHT));
+
+    ps_picture_unref(outer);
+    ps_picture_unref(picture);
+}
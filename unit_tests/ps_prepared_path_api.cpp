@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026, Zhang Ji Peng
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test.h"
+
+#define PREPARED_WIDTH 320
+#define PREPARED_HEIGHT 240
+
+class PsPreparedPathTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        PS_Init();
+        direct = (uint8_t*)calloc(PREPARED_WIDTH * 4, PREPARED_HEIGHT);
+        prepared = (uint8_t*)calloc(PREPARED_WIDTH * 4, PREPARED_HEIGHT);
+        direct_canvas = ps_canvas_create_with_data(direct, COLOR_FORMAT_RGBA,
+                                                   PREPARED_WIDTH, PREPARED_HEIGHT, PREPARED_WIDTH * 4);
+        prepared_canvas = ps_canvas_create_with_data(prepared, COLOR_FORMAT_RGBA,
+                                                     PREPARED_WIDTH, PREPARED_HEIGHT, PREPARED_WIDTH * 4);
+        direct_ctx = ps_context_create(direct_canvas, NULL);
+        prepared_ctx = ps_context_create(prepared_canvas, NULL);
+
+        // marker shape with integer vertices.
+        path = ps_path_create();
+        ps_point pts[] = {{0, -20}, {6, -6}, {20, -6}, {9, 3}, {13, 18}, {0, 9}, {-13, 18}, {-9, 3}, {-20, -6}, {-6, -6}};
+        ps_path_move_to(path, &pts[0]);
+        for (int i = 1; i < 10; i++) {
+            ps_path_line_to(path, &pts[i]);
+        }
+        ps_path_sub_close(path);
+    }
+
+    void TearDown() override
+    {
+        ps_path_unref(path);
+        ps_context_unref(prepared_ctx);
+        ps_context_unref(direct_ctx);
+        ps_canvas_unref(prepared_canvas);
+        ps_canvas_unref(direct_canvas);
+        free(prepared);
+        free(direct);
+        PS_Shutdown();
+    }
+
+    ps_prepared_path* Prepare(void)
+    {
+        ps_save(prepared_ctx);
+        ps_scale(prepared_ctx, 1.5f, 1.5f);
+        ps_prepared_path* p = ps_prepared_path_create(prepared_ctx, path);
+        ps_restore(prepared_ctx);
+        return p;
+    }
+
+    void DirectFill(float x, float y)
+    {
+        ps_save(direct_ctx);
+        ps_scale(direct_ctx, 1.5f, 1.5f);
+        ps_translate(direct_ctx, x, y);
+        ps_set_path(direct_ctx, path);
+        ps_fill(direct_ctx);
+        ps_restore(direct_ctx);
+    }
+
+    bool SameImage(void) const
+    {
+        return memcmp(direct, prepared, PREPARED_WIDTH * 4 * PREPARED_HEIGHT) == 0;
+    }
+
+    uint8_t* direct;
+    uint8_t* prepared;
+    ps_canvas* direct_canvas;
+    ps_canvas* prepared_canvas;
+    ps_context* direct_ctx;
+    ps_context* prepared_ctx;
+    ps_path* path;
+};
+
+TEST_F(PsPreparedPathTest, CreateAndRef)
+{
+    ps_prepared_path* p = Prepare();
+    ASSERT_NE(nullptr, p);
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+
+    EXPECT_EQ(p, ps_prepared_path_ref(p));
+    ps_prepared_path_unref(p);
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+    ps_prepared_path_unref(p);
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+}
+
+TEST_F(PsPreparedPathTest, BadArguments)
+{
+    EXPECT_EQ(nullptr, ps_prepared_path_create(NULL, path));
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+    EXPECT_EQ(nullptr, ps_prepared_path_create(prepared_ctx, NULL));
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+    EXPECT_EQ(nullptr, ps_prepared_path_ref(NULL));
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+    ps_prepared_path_unref(NULL);
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+
+    ps_prepared_path* p = Prepare();
+    ps_point pt = {10, 10};
+    ps_fill_prepared_path(NULL, p, &pt);
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+    ps_fill_prepared_path(prepared_ctx, NULL, &pt);
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+    ps_fill_prepared_path(prepared_ctx, p, NULL);
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, ps_last_status());
+    ps_prepared_path_unref(p);
+}
+
+TEST_F(PsPreparedPathTest, FillSameAsPathFill)
+{
+    ps_prepared_path* p = Prepare();
+    ASSERT_NE(nullptr, p);
+
+    ps_color c = {0.8f, 0.3f, 0.1f, 0.7f};
+    ps_set_source_color(direct_ctx, &c);
+    ps_set_source_color(prepared_ctx, &c);
+
+    // integer and quarter pixel offsets, overlapped shapes are blended.
+    ps_point offsets[] = {{40, 40}, {60, 50}, {120.25f, 80.5f}, {200.75f, 120.25f}, {-5, 100}, {300, 230}};
+    for (unsigned i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+        DirectFill(offsets[i].x, offsets[i].y);
+        ps_fill_prepared_path(prepared_ctx, p, &offsets[i]);
+        EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+    }
+    EXPECT_TRUE(SameImage());
+
+    ps_prepared_path_unref(p);
+}
+
+TEST_F(PsPreparedPathTest, FillWithGradientSource)
+{
+    ps_prepared_path* p = Prepare();
+    ASSERT_NE(nullptr, p);
+
+    ps_point s = {0, 0};
+    ps_point e = {PREPARED_WIDTH, PREPARED_HEIGHT};
+    ps_color c0 = {0.0f, 0.2f, 0.9f, 1.0f};
+    ps_color c1 = {0.9f, 0.9f, 0.0f, 0.6f};
+    ps_gradient* gradient = ps_gradient_create_linear(GRADIENT_SPREAD_PAD, &s, &e);
+    ps_gradient_add_color_stop(gradient, 0.0f, &c0);
+    ps_gradient_add_color_stop(gradient, 1.0f, &c1);
+    ps_set_source_gradient(direct_ctx, gradient);
+    ps_set_source_gradient(prepared_ctx, gradient);
+
+    ps_point offsets[] = {{50, 60}, {150.5f, 100.25f}, {250, 180}};
+    for (unsigned i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+        DirectFill(offsets[i].x, offsets[i].y);
+        ps_fill_prepared_path(prepared_ctx, p, &offsets[i]);
+    }
+    EXPECT_TRUE(SameImage());
+
+    ps_gradient_unref(gradient);
+    ps_prepared_path_unref(p);
+}
+
+TEST_F(PsPreparedPathTest, OffsetRoundedToQuarterPixel)
+{
+    ps_prepared_path* p = Prepare();
+    ASSERT_NE(nullptr, p);
+
+    ps_color c = {0.1f, 0.6f, 0.3f, 1.0f};
+    ps_set_source_color(direct_ctx, &c);
+    ps_set_source_color(prepared_ctx, &c);
+
+    DirectFill(100.25f, 99.0f);
+    ps_point pt = {100.3f, 98.9f};
+    ps_fill_prepared_path(prepared_ctx, p, &pt);
+    EXPECT_TRUE(SameImage());
+
+    ps_prepared_path_unref(p);
+}
+
+TEST_F(PsPreparedPathTest, PathChangedAfterPrepare)
+{
+    ps_prepared_path* p = Prepare();
+    ASSERT_NE(nullptr, p);
+
+    ps_point pt = {50, 50};
+    ps_path_line_to(path, &pt); // prepared path keeps the old geometry.
+    ps_path_unref(path);
+    path = ps_path_create();
+    ps_point pts[] = {{0, -20}, {6, -6}, {20, -6}, {9, 3}, {13, 18}, {0, 9}, {-13, 18}, {-9, 3}, {-20, -6}, {-6, -6}};
+    ps_path_move_to(path, &pts[0]);
+    for (int i = 1; i < 10; i++) {
+        ps_path_line_to(path, &pts[i]);
+    }
+    ps_path_sub_close(path);
+
+    ps_color c = {0.5f, 0.5f, 0.9f, 1.0f};
+    ps_set_source_color(direct_ctx, &c);
+    ps_set_source_color(prepared_ctx, &c);
+
+    DirectFill(160, 120);
+    ps_point o = {160, 120};
+    ps_fill_prepared_path(prepared_ctx, p, &o);
+    EXPECT_TRUE(SameImage());
+
+    ps_prepared_path_unref(p);
+}
+
+TEST_F(PsPreparedPathTest, RecordingContext)
+{
+    ps_prepared_path* p = Prepare();
+    ASSERT_NE(nullptr, p);
+
+    ps_picture* picture = ps_picture_create();
+    ps_context* ctx = ps_context_create_recording(picture, NULL);
+    ps_color c = {0.9f, 0.1f, 0.4f, 1.0f};
+    ps_set_source_color(ctx, &c);
+    ps_point pt = {80, 90};
+    ps_fill_prepared_path(ctx, p, &pt);
+    EXPECT_EQ(STATUS_SUCCEED, ps_last_status());
+    ps_context_unref(ctx);
+
+    ps_set_source_color(direct_ctx, &c);
+    DirectFill(80, 90);
+
+    EXPECT_NE(False, ps_picture_playback(prepared_ctx, picture, NULL));
+    EXPECT_TRUE(SameImage());
+
+    ps_picture_unref(picture);
+    ps_prepared_path_unref(p);
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2025, Zhang Ji Peng
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "test.h"
+#include "picasso_backport.h"
+
+#define THREADS_WIDTH 800
+#define THREADS_HEIGHT 600
+
+class RenderThreadsTest : public ::testing::Test
+{
+protected:
+    static void DrawScene(uint8_t* buffer)
+    {
+        ps_canvas* canvas = ps_canvas_create_with_data(buffer, COLOR_FORMAT_RGBA,
+                                                       THREADS_WIDTH, THREADS_HEIGHT, THREADS_WIDTH * 4);
+        ps_context* ctx = ps_context_create(canvas, NULL);
+
+        ps_color bg = {1.0f, 1.0f, 1.0f, 1.0f};
+        ps_set_source_color(ctx, &bg);
+        ps_clear(ctx);
+
+        // solid fill
+        ps_color red = {0.9f, 0.1f, 0.1f, 0.8f};
+        ps_rect er = {20, 10, 700, 560};
+        ps_set_source_color(ctx, &red);
+        ps_ellipse(ctx, &er);
+        ps_fill(ctx);
+
+        // stroke with dashes
+        ps_color blue = {0.1f, 0.2f, 0.9f, 0.6f};
+        ps_point p0 = {10, 590};
+        ps_point c1 = {200, -300};
+        ps_point c2 = {600, 900};
+        ps_point p1 = {790, 20};
+        float dashes[] = {30.0f, 10.0f};
+        ps_set_stroke_color(ctx, &blue);
+        ps_set_line_width(ctx, 9.0f);
+        ps_set_line_dash(ctx, 0, dashes, 2);
+        ps_move_to(ctx, &p0);
+        ps_bezier_to(ctx, &c1, &c2, &p1);
+        ps_stroke(ctx);
+        ps_reset_line_dash(ctx);
+
+        // gradient fill with rotate
+        ps_point s = {100, 100};
+        ps_point e = {700, 500};
+        ps_color c0 = {0.0f, 0.8f, 0.2f, 1.0f};
+        ps_color c3 = {0.9f, 0.9f, 0.0f, 0.5f};
+        ps_gradient* gradient = ps_gradient_create_linear(GRADIENT_SPREAD_REFLECT, &s, &e);
+        ps_gradient_add_color_stop(gradient, 0.0f, &c0);
+        ps_gradient_add_color_stop(gradient, 1.0f, &c3);
+        ps_rect gr = {150, 100, 500, 400};
+        ps_save(ctx);
+        ps_translate(ctx, 400, 300);
+        ps_rotate(ctx, 0.5f);
+        ps_translate(ctx, -400, -300);
+        ps_set_source_gradient(ctx, gradient);
+        ps_set_composite_operator(ctx, COMPOSITE_MULTIPLY);
+        ps_rectangle(ctx, &gr);
+        ps_fill(ctx);
+        ps_restore(ctx);
+        ps_gradient_unref(gradient);
+
+        // clip rect and clip path
+        ps_color green = {0.2f, 0.7f, 0.4f, 0.7f};
+        ps_rect cr = {0, 200, 800, 250};
+        ps_rect fr = {50, 50, 700, 500};
+        ps_save(ctx);
+        ps_clip_rect(ctx, &cr);
+        ps_set_source_color(ctx, &green);
+        ps_ellipse(ctx, &fr);
+        ps_fill(ctx);
+        ps_restore(ctx);
+
+        ps_save(ctx);
+        ps_ellipse(ctx, &er);
+        ps_clip(ctx);
+        ps_set_source_color(ctx, &blue);
+        ps_rectangle(ctx, &fr);
+        ps_fill(ctx);
+        ps_restore(ctx);
+
+        ps_context_unref(ctx);
+        ps_canvas_unref(canvas);
+    }
+
+    static void DrawSharedObjects(uint8_t* buffer, ps_path* path, ps_font* font)
+    {
+        DrawScene(buffer);
+
+        ps_canvas* canvas = ps_canvas_create_with_data(buffer, COLOR_FORMAT_RGBA,
+                                                       THREADS_WIDTH, THREADS_HEIGHT, THREADS_WIDTH * 4);
+        ps_context* ctx = ps_context_create(canvas, NULL);
+
+        for (int i = 0; i < 200; i++) {
+            ps_path* p = ps_path_ref(path);
+            ps_font* f = ps_font_ref(font);
+            ps_path_unref(p);
+            ps_font_unref(f);
+        }
+
+        ps_color black = {0.0f, 0.0f, 0.0f, 1.0f};
+        ps_set_source_color(ctx, &black);
+        ps_set_path(ctx, path);
+        ps_fill(ctx);
+
+        ps_set_font(ctx, font);
+        ps_text_out_length(ctx, 100, 300, "Picasso Threads", 15);
+
+        ps_context_unref(ctx);
+        ps_canvas_unref(canvas);
+    }
+};
+
+TEST_F(RenderThreadsTest, SameAsSingleThread)
+{
+    uint8_t* single = (uint8_t*)calloc(THREADS_WIDTH * 4, THREADS_HEIGHT);
+    uint8_t* tiles = (uint8_t*)calloc(THREADS_WIDTH * 4, THREADS_HEIGHT);
+
+    ASSERT_NE(False, ps_initialize());
+    DrawScene(single);
+    ps_shutdown();
+
+    ASSERT_NE(False, ps_set_render_threads(4));
+    ASSERT_NE(False, ps_initialize());
+    EXPECT_EQ(False, ps_set_render_threads(2));
+    EXPECT_EQ(STATUS_NOT_SUPPORT, ps_last_status());
+    DrawScene(tiles);
+    ps_shutdown();
+    ps_set_render_threads(0);
+
+    EXPECT_EQ(0, memcmp(single, tiles, THREADS_WIDTH * 4 * THREADS_HEIGHT));
+
+    free(tiles);
+    free(single);
+}
+
+TEST_F(RenderThreadsTest, ConcurrentContexts)
+{
+    const int threads = 4;
+    uint8_t* single = (uint8_t*)calloc(THREADS_WIDTH * 4, THREADS_HEIGHT);
+    uint8_t* buffers[threads];
+    for (int i = 0; i < threads; i++) {
+        buffers[i] = (uint8_t*)calloc(THREADS_WIDTH * 4, THREADS_HEIGHT);
+    }
+
+    ASSERT_NE(False, ps_initialize());
+
+    ps_path* path = ps_path_create();
+    ps_rect rc = {300, 250, 200, 100};
+    ps_path_add_rounded_rect(path, &rc, 20, 20, 20, 20, 20, 20, 20, 20);
+    ps_font* font = ps_font_create("Sans-Serif", CHARSET_ANSI, 36, FONT_WEIGHT_BOLD, False);
+
+    DrawSharedObjects(single, path, font);
+
+    std::vector<std::thread> workers;
+    ps_status status[threads];
+    for (int i = 0; i < threads; i++) {
+        workers.push_back(std::thread([&, i]() {
+            DrawSharedObjects(buffers[i], path, font);
+            // status of the last call is kept by each thread.
+            if (i == 0) {
+                ps_context_ref(NULL);
+            } else {
+                ps_path_ref(path);
+                ps_path_unref(path);
+            }
+            status[i] = ps_last_status();
+        }));
+    }
+
+    for (int i = 0; i < threads; i++) {
+        workers[i].join();
+    }
+
+    EXPECT_EQ(STATUS_INVALID_ARGUMENT, status[0]);
+    for (int i = 0; i < threads; i++) {
+        if (i) {
+            EXPECT_EQ(STATUS_SUCCEED, status[i]);
+        }
+        EXPECT_EQ(0, memcmp(single, buffers[i], THREADS_WIDTH * 4 * THREADS_HEIGHT));
+        free(buffers[i]);
+    }
+
+    ps_font_unref(font);
+    ps_path_unref(path);
+    ps_shutdown();
+    free(single);
+}
@@ -386,3 +386,32 @@ TEST_F(RenderingTest, TextWithGradient)
         ps_font_unref(font);
     }
 }
+
+TEST_F(RenderingTest, DensePathFill)
+{
+    // the clip of a previous test is kept by the shared canvas.
+    ps_reset_clip(ctx);
+
+    ps_color color = {0.2f, 0.4f, 0.8f, 1.0f};
+    ps_set_source_color(ctx, &color);
+    ps_set_fill_rule(ctx, FILL_RULE_EVEN_ODD);
+
+    // a self-intersecting path crossing the canvas many times.
+    unsigned int seed = 7;
+    for (int i = 0; i < 1000; i++) {
+        seed = seed * 1103515245 + 12345;
+        float x = (float)((seed >> 16) % (TEST_WIDTH * 4)) * 0.25f;
+        seed = seed * 1103515245 + 12345;
+        float y = (float)((seed >> 16) % (TEST_HEIGHT * 4)) * 0.25f;
+        ps_point pt = {x, y};
+        if (i == 0) {
+            ps_move_to(ctx, &pt);
+        } else {
+            ps_line_to(ctx, &pt);
+        }
+    }
+    ps_close_path(ctx);
+    ps_fill(ctx);
+
+    EXPECT_SNAPSHOT_EQ(dense_path_fill);
+}